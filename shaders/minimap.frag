@@ -0,0 +1,39 @@
+#version 330 core
+in vec2 MapUV;
+out vec4 FragColor;
+
+uniform usampler2D layoutCells;    // Bits por célula: 1 = parede leste, 2 = parede sul, 4 = bloqueada
+uniform sampler2D fog;             // 0 = célula nunca vista
+uniform vec2 viewCenter;           // Centro da vista, em células
+uniform float viewSpan;            // Células de uma borda à outra do quadro
+uniform float wallWidth;           // Espessura das paredes, em frações de célula
+uniform float frameWidth;          // Moldura, em frações do quadro
+
+uint cellBits(ivec2 c)
+{
+    return texelFetch(layoutCells, c, 0).r;
+}
+
+void main()
+{
+    if (any(lessThan(MapUV, vec2(frameWidth))) || any(greaterThan(MapUV, vec2(1.0 - frameWidth)))) {
+        FragColor = vec4(0.8, 0.8, 0.85, 0.9);
+        return;
+    }
+    // Norte (-z) para cima
+    vec2 p = viewCenter + vec2(MapUV.x - 0.5, 0.5 - MapUV.y) * viewSpan;
+    ivec2 c = ivec2(floor(p));
+    if (any(lessThan(c, ivec2(0))) || any(greaterThanEqual(c, textureSize(layoutCells, 0))) || texelFetch(fog, c, 0).r == 0.0) {
+        FragColor = vec4(0.02, 0.02, 0.05, 0.75);
+        return;
+    }
+    // As bordas oeste e norte do mapa são sempre fechadas, como no MazeLayout
+    vec2 f = p - vec2(c);
+    uint bits = cellBits(c);
+    bool wall = (bits & 4u) != 0u
+             || ((bits & 1u) != 0u && f.x > 1.0 - wallWidth)
+             || ((bits & 2u) != 0u && f.y > 1.0 - wallWidth)
+             || (f.x < wallWidth && (c.x == 0 || (cellBits(c - ivec2(1, 0)) & 1u) != 0u))
+             || (f.y < wallWidth && (c.y == 0 || (cellBits(c - ivec2(0, 1)) & 2u) != 0u));
+    FragColor = wall ? vec4(0.85, 0.85, 0.9, 0.95) : vec4(0.2, 0.22, 0.28, 0.85);
+}
@@ -0,0 +1,13 @@
+#version 330 core
+// Quadro do minimapa gerado pelo gl_VertexID (sem VBO): 4 vértices em triangle strip
+out vec2 MapUV;
+
+uniform mat4 projection;
+uniform vec4 rect;                 // x, y, largura e altura em pixels (origem embaixo, à esquerda)
+
+void main()
+{
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    MapUV = corner;
+    gl_Position = projection * vec4(rect.xy + corner * rect.zw, 0.0, 1.0);
+}
@@ -0,0 +1,8 @@
+#version 330 core
+in vec3 MarkerColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(MarkerColor, 1.0);
+}
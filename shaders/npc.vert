@@ -0,0 +1,22 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aOffset; // Posição do NPC (um valor por instância)
+
+out vec3 Normal;
+out vec3 FragPos;
+out vec2 TexCoords;
+out vec2 LightmapUV; // Sem luz assada (BAKED_LIGHTING 0)
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    // Só translação por instância: a normal não muda
+    FragPos = aPos + aOffset;
+    Normal = aNormal;
+    TexCoords = aPos.xy;
+    LightmapUV = vec2(0.0);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
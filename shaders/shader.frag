@@ -1,17 +1,52 @@
 #version 330 core
+// Variante escolhida pelo ShaderCache (ShaderFeatures), com #defines logo
+// abaixo desta linha: TEXTURED, PBR, NORMAL_MAP, BAKED_LIGHTING e LIGHT_COUNT.
+// O que a variante não usa nem é compilado
+#ifndef BAKED_LIGHTING
+#define BAKED_LIGHTING 0
+#endif
+#ifndef LIGHT_COUNT
+#define LIGHT_COUNT 0
+#endif
+
 out vec4 FragColor;
 
 in vec3 Normal;
 in vec3 FragPos;
 in vec2 TexCoords;
+in vec2 LightmapUV;
 
 // Propriedades do Material (do objeto)
 uniform vec3 objectColor;
 uniform vec3 viewPos; // Posição da câmera
 
 // Texturas
-uniform sampler2D diffuseTexture;
-uniform int useTexture;
+#ifdef TEXTURED
+uniform sampler2D diffuseTexture;   // Substitui objectColor
+#endif
+#ifdef NORMAL_MAP
+uniform sampler2D normalTexture;    // Normal no espaço tangente
+#endif
+#ifdef PBR
+uniform float roughness;
+uniform float metallic;
+#endif
+
+// Luz assada na CPU para a geometria estática, no atlas de LightmapUV:
+// 1 = lightmap RGBM (sol com sombra e luz indireta), 2 = oclusão ambiente (R)
+#if BAKED_LIGHTING != 0
+uniform sampler2D bakedTexture;
+#endif
+const float RGBM_RANGE = 4.0; // Lightmap::RGBM_RANGE
+
+// Sombras da luz direcional: cascatas em volta da câmera (ShadowCascades).
+// O lightmap já traz a sombra do sol
+#if BAKED_LIGHTING != 1
+#define SHADOW_CASCADES 3
+uniform sampler2DArrayShadow shadowMap;
+uniform mat4 lightSpace[SHADOW_CASCADES];
+uniform float shadowTexel[SHADOW_CASCADES];    // Lado de um texel em metros
+#endif
 
 // Luz Direcional (Sol/Luz do Teto)
 struct DirLight {
@@ -20,72 +55,121 @@ struct DirLight {
 };
 uniform DirLight dirLight;
 
-// Luz do Baú (Luz Pontual)
+// Luzes dos baús (Luzes Pontuais): todas as acesas da cena, e a lista curta
+// das que alcançam o objeto deste draw (LightAssignment). LIGHT_COUNT, o
+// tamanho da lista, faz parte da variante: o laço tem tamanho fixo
+#define MAX_SCENE_LIGHTS 16
+#define MAX_OBJECT_LIGHTS 4
 struct PointLight {
     vec3 position;
     vec3 color;
-    float intensity; // Usado para ligar/desligar
+    float intensity;
 
     // Atenuação
     float constant;
     float linear;
     float quadratic;
+    float radius;    // Corte: a luz se apaga suavemente até aqui
 };
-uniform PointLight chestLight;
+#if LIGHT_COUNT > 0
+uniform PointLight pointLights[MAX_SCENE_LIGHTS];
+uniform ivec4 pointLightIndices;  // Índices em pointLights (os LIGHT_COUNT primeiros)
+#endif
 
 // Funções para calcular cada tipo de luz
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic);
-vec3 CalcPointLightPBR(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo, float roughness, float metallic);
+float CalcShadow(vec3 normal);
+float CalcAttenuation(PointLight light, vec3 fragPos);
+#ifdef PBR
+vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float occlusion, float shadow);
+vec3 CalcPointLightPBR(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo);
 
 // Funções PBR
 vec3 fresnelSchlick(float cosTheta, vec3 F0);
 float DistributionGGX(vec3 N, vec3 H, float roughness);
 float GeometrySchlickGGX(float NdotV, float roughness);
 float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness);
+#else
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, float occlusion, float shadow);
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+#endif
 
-// Função para calcular normal do mapa normal
-vec3 getNormalFromMap()
+#ifdef NORMAL_MAP
+// Normal do mapa, com a base tangente tirada das derivadas da posição e das
+// coordenadas de textura (as malhas não trazem tangentes)
+vec3 getNormalFromMap(vec3 N)
 {
     vec3 tangentNormal = texture(normalTexture, TexCoords).xyz * 2.0 - 1.0;
-    
+
     vec3 Q1  = dFdx(FragPos);
     vec3 Q2  = dFdy(FragPos);
     vec2 st1 = dFdx(TexCoords);
     vec2 st2 = dFdy(TexCoords);
-    
-    vec3 N   = normalize(Normal);
-    vec3 T   = normalize(Tangent);
-    vec3 B   = normalize(Bitangent);
+
+    vec3 T   = normalize(Q1 * st2.t - Q2 * st1.t);
+    vec3 B   = -normalize(cross(N, T));
     mat3 TBN = mat3(T, B, N);
-    
+
     return normalize(TBN * tangentNormal);
 }
+#endif
 
 void main()
 {
     vec3 norm = normalize(Normal);
+#ifdef NORMAL_MAP
+    norm = getNormalFromMap(norm);
+#endif
     vec3 viewDir = normalize(viewPos - FragPos);
 
-    // Começa com a contribuição da luz direcional global
-    vec3 lighting = CalcDirLight(dirLight, norm, viewDir);
+#ifdef TEXTURED
+    vec3 albedo = texture(diffuseTexture, TexCoords).rgb;
+#else
+    vec3 albedo = objectColor;
+#endif
+
+    // Começa com a contribuição da luz direcional global (já assada no lightmap
+    // da geometria estática: uma amostra no lugar do modelo de iluminação)
+#if BAKED_LIGHTING == 1
+    vec4 rgbm = texture(bakedTexture, LightmapUV);
+    vec3 color = rgbm.rgb * rgbm.a * RGBM_RANGE * albedo;
+#else
+#if BAKED_LIGHTING == 2
+    float occlusion = texture(bakedTexture, LightmapUV).r;
+#else
+    float occlusion = 1.0;
+#endif
+#ifdef PBR
+    vec3 color = CalcDirLightPBR(dirLight, norm, viewDir, albedo, occlusion, CalcShadow(norm));
+#else
+    vec3 color = CalcDirLight(dirLight, norm, viewDir, occlusion, CalcShadow(norm)) * albedo;
+#endif
+#endif
+
+    // Adiciona só as luzes de baú que alcançam este objeto
+#if LIGHT_COUNT > 0
+    for (int i = 0; i < LIGHT_COUNT; ++i) {
+#ifdef PBR
+        color += CalcPointLightPBR(pointLights[pointLightIndices[i]], norm, FragPos, viewDir, albedo);
+#else
+        color += CalcPointLight(pointLights[pointLightIndices[i]], norm, FragPos, viewDir) * albedo;
+#endif
+    }
+#endif
 
-    // Adiciona a contribuição da luz do baú (se estiver acesa)
-    lighting += CalcPointLight(chestLight, norm, FragPos, viewDir);
+    FragColor = vec4(color, 1.0);
+}
 
-    // A cor final é a cor do objeto multiplicada pela iluminação total
-    vec3 finalColor = objectColor;
-    if (useTexture == 1) {
-        // Mostrar textura diretamente sem iluminação
-        vec4 texColor = texture(diffuseTexture, TexCoords);
-        finalColor = texColor.rgb;
-    } else {
-        finalColor = lighting * finalColor;
-    }
-    FragColor = vec4(finalColor, 1.0);
+// Atenuação da luz pontual, com uma janela até o raio de corte: zero exato
+// lá, quase 1 perto da luz
+float CalcAttenuation(PointLight light, vec3 fragPos)
+{
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    return attenuation * window * window;
 }
 
+#ifdef PBR
 // Funções PBR
 vec3 fresnelSchlick(float cosTheta, vec3 F0)
 {
@@ -128,7 +212,7 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
 }
 
 // Função que calcula a luz direcional PBR
-vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float roughness, float metallic)
+vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, float occlusion, float shadow)
 {
     vec3 lightDir = normalize(-light.direction);
     vec3 halfDir = normalize(lightDir + viewDir);
@@ -138,7 +222,7 @@ vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, flo
     F0 = mix(F0, albedo, metallic);
     
     // Ambiente
-    vec3 ambient = 0.03 * albedo * light.color;
+    vec3 ambient = 0.03 * occlusion * albedo * light.color;
     
     // Cook-Torrance BRDF
     float NDF = DistributionGGX(normal, halfDir, roughness);
@@ -154,16 +238,12 @@ vec3 CalcDirLightPBR(DirLight light, vec3 normal, vec3 viewDir, vec3 albedo, flo
     float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * NdotL + 0.0001;
     vec3 specular = numerator / denominator;
     
-    return ambient + (kD * albedo / 3.14159265359 + specular) * light.color * NdotL;
+    return ambient + (kD * albedo / 3.14159265359 + specular) * light.color * NdotL * shadow;
 }
 
 // Função que calcula a luz pontual PBR
-vec3 CalcPointLightPBR(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo, float roughness, float metallic)
+vec3 CalcPointLightPBR(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
 {
-    if (light.intensity <= 0.0) {
-        return vec3(0.0);
-    }
-
     vec3 lightDir = normalize(light.position - fragPos);
     vec3 halfDir = normalize(lightDir + viewDir);
     
@@ -185,23 +265,24 @@ vec3 CalcPointLightPBR(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir
     float denominator = 4.0 * max(dot(normal, viewDir), 0.0) * NdotL + 0.0001;
     vec3 specular = numerator / denominator;
     
-    // Atenuação
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
-    
-    vec3 radiance = light.color * attenuation;
+    vec3 radiance = light.color * CalcAttenuation(light, fragPos);
     
     return (kD * albedo / 3.14159265359 + specular) * radiance * NdotL * light.intensity;
 }
 
-// Função que calcula a luz direcional (versão antiga para compatibilidade)
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
+#else
+// Phong: a variante padrão
+
+// Função que calcula a luz direcional
+// `occlusion` (oclusão ambiente assada, 1 = aberto) só escurece o termo ambiente;
+// `shadow` (1 = iluminado) apaga a difusa e a especular
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, float occlusion, float shadow)
 {
     vec3 lightDir = normalize(-light.direction);
 
     // Ambiente (para a luz global)
     float ambientStrength = 0.3; // Luz ambiente um pouco mais forte
-    vec3 ambient = ambientStrength * light.color;
+    vec3 ambient = ambientStrength * occlusion * light.color;
 
     // Difusa
     float diff = max(dot(normal, lightDir), 0.0);
@@ -212,16 +293,12 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
     vec3 specular = vec3(0.5) * spec * light.color; // Brilho
 
-    return (ambient + diffuse + specular);
+    return ambient + (diffuse + specular) * shadow;
 }
 
-// Função que calcula a luz pontual (versão antiga para compatibilidade)
+// Função que calcula a luz pontual
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 {
-    if (light.intensity <= 0.0) {
-        return vec3(0.0);
-    }
-
     vec3 lightDir = normalize(light.position - fragPos);
 
     // Difusa
@@ -234,11 +311,33 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
     vec3 specular = vec3(0.5) * spec * light.color;
 
     // Atenuação
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+    float attenuation = CalcAttenuation(light, fragPos);
 
     diffuse  *= attenuation;
     specular *= attenuation;
 
     return (diffuse + specular) * light.intensity;
 }
+#endif
+
+#if BAKED_LIGHTING != 1
+// Fração iluminada pelo sol: a primeira cascata que contém o fragmento, com
+// quatro amostras de comparação (cada uma já filtrada 2x2 pelo hardware)
+float CalcShadow(vec3 normal)
+{
+    for (int i = 0; i < SHADOW_CASCADES; ++i) {
+        vec3 coords = (lightSpace[i] * vec4(FragPos, 1.0)).xyz * 0.5 + 0.5;
+        if (any(lessThan(coords.xy, vec2(0.01))) || any(greaterThan(coords.xy, vec2(0.99)))) continue;
+        // Deslocamento pela normal, do tamanho do texel da cascata: sem acne nas faces rasantes
+        coords = (lightSpace[i] * vec4(FragPos + normal * shadowTexel[i] * 1.5, 1.0)).xyz * 0.5 + 0.5;
+        vec2 texel = vec2(1.0) / vec2(textureSize(shadowMap, 0).xy);
+        float lit = 0.0;
+        lit += texture(shadowMap, vec4(coords.xy + vec2(-0.5, -0.5) * texel, float(i), coords.z));
+        lit += texture(shadowMap, vec4(coords.xy + vec2( 0.5, -0.5) * texel, float(i), coords.z));
+        lit += texture(shadowMap, vec4(coords.xy + vec2(-0.5,  0.5) * texel, float(i), coords.z));
+        lit += texture(shadowMap, vec4(coords.xy + vec2( 0.5,  0.5) * texel, float(i), coords.z));
+        return lit * 0.25;
+    }
+    return 1.0; // Além da última cascata
+}
+#endif
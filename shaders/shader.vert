@@ -1,10 +1,12 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aLightmapUV; // Só na geometria estática assada
 
 out vec3 Normal;
 out vec3 FragPos;
 out vec2 TexCoords;
+out vec2 LightmapUV;
 
 uniform mat4 model;
 uniform mat4 view;
@@ -17,6 +19,7 @@ void main()
     
     // Gerar coordenadas de textura baseadas na posição
     TexCoords = aPos.xy * 1.0; // Usar xy com escala 1.0 para melhor visibilidade
+    LightmapUV = aLightmapUV;
     
     gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
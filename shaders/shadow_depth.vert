@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 lightSpace; // Ortográfica da cascata * vista da luz
+uniform mat4 model;
+
+void main()
+{
+    gl_Position = lightSpace * model * vec4(aPos, 1.0);
+}
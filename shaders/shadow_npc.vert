@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec3 aOffset; // Posição do NPC (um valor por instância)
+
+uniform mat4 lightSpace;
+
+void main()
+{
+    gl_Position = lightSpace * vec4(aPos + aOffset, 1.0);
+}
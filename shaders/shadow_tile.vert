@@ -0,0 +1,23 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in uvec2 aCell;        // Célula da peça (um valor por instância)
+layout (location = 3) in uint aOrientation;  // Passos de 90° em torno do centro da célula
+
+uniform mat4 lightSpace;
+uniform float cellSize;
+
+// Mesma rotação de tile.vert
+vec2 rotate(vec2 v, uint steps)
+{
+    if (steps == 1u) return vec2(-v.y, v.x);
+    if (steps == 2u) return -v;
+    if (steps == 3u) return vec2(v.y, -v.x);
+    return v;
+}
+
+void main()
+{
+    vec2 center = vec2(cellSize * 0.5);
+    vec2 local = rotate(aPos.xz - center, aOrientation) + center;
+    gl_Position = lightSpace * vec4(vec3(vec2(aCell) * cellSize + local, aPos.y).xzy, 1.0);
+}
@@ -0,0 +1,34 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in uvec2 aCell;        // Célula da peça (um valor por instância)
+layout (location = 3) in uint aOrientation;  // Passos de 90° em torno do centro da célula
+
+out vec3 Normal;
+out vec3 FragPos;
+out vec2 TexCoords;
+out vec2 LightmapUV; // Sem luz assada (BAKED_LIGHTING 0)
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float cellSize;
+
+// Um passo de 90°: (x, z) -> (-z, x), leste -> sul -> oeste -> norte
+vec2 rotate(vec2 v, uint steps)
+{
+    if (steps == 1u) return vec2(-v.y, v.x);
+    if (steps == 2u) return -v;
+    if (steps == 3u) return vec2(v.y, -v.x);
+    return v;
+}
+
+void main()
+{
+    vec2 center = vec2(cellSize * 0.5);
+    vec2 local = rotate(aPos.xz - center, aOrientation) + center;
+    FragPos = vec3(vec2(aCell) * cellSize + local, aPos.y).xzy;
+    Normal = vec3(rotate(aNormal.xz, aOrientation), aNormal.y).xzy;
+    TexCoords = local;
+    LightmapUV = vec2(0.0);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
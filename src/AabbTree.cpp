@@ -0,0 +1,212 @@
+#include "AabbTree.h"
+#include <algorithm>
+
+namespace {
+    float surfaceArea(const glm::vec3& lo, const glm::vec3& hi)
+    {
+        glm::vec3 d = hi - lo;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+}
+
+float rayBoxDistance(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance)
+{
+    float tEnter = 0.0f, tExit = maxDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t0 = (boundsMin[axis] - origin[axis]) * invDir[axis];
+        float t1 = (boundsMax[axis] - origin[axis]) * invDir[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
+        if (tEnter > tExit) return -1.0f;
+    }
+    return tEnter;
+}
+
+// ============================================================================
+// ALOCAÇÃO DE NÓS
+// ============================================================================
+int AabbTree::allocateNode()
+{
+    if (freeList == NULL_NODE) {
+        nodes.emplace_back();
+        return static_cast<int>(nodes.size() - 1);
+    }
+    int index = freeList;
+    freeList = nodes[index].parent;
+    nodes[index] = Node();
+    return index;
+}
+
+void AabbTree::freeNode(int index)
+{
+    nodes[index].parent = freeList;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+// ============================================================================
+// INSERÇÃO E REMOÇÃO
+// ============================================================================
+int AabbTree::insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, int userData)
+{
+    int leaf = allocateNode();
+    nodes[leaf].boundsMin = boundsMin;
+    nodes[leaf].boundsMax = boundsMax;
+    nodes[leaf].userData = userData;
+    nodes[leaf].height = 0;
+    insertLeaf(leaf);
+    return leaf;
+}
+
+void AabbTree::remove(int proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+}
+
+void AabbTree::update(int proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    removeLeaf(proxy);
+    nodes[proxy].boundsMin = boundsMin;
+    nodes[proxy].boundsMax = boundsMax;
+    insertLeaf(proxy);
+}
+
+void AabbTree::clear()
+{
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+}
+
+void AabbTree::insertLeaf(int leaf)
+{
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Desce escolhendo o filho que menos aumenta a área total (heurística SAH)
+    const glm::vec3 leafMin = nodes[leaf].boundsMin, leafMax = nodes[leaf].boundsMax;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        float area = surfaceArea(node.boundsMin, node.boundsMax);
+        float combinedArea = surfaceArea(glm::min(node.boundsMin, leafMin), glm::max(node.boundsMax, leafMax));
+        float cost = 2.0f * combinedArea;
+        float inheritance = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](int child) {
+            const Node& c = nodes[child];
+            float enlarged = surfaceArea(glm::min(c.boundsMin, leafMin), glm::max(c.boundsMax, leafMax));
+            return c.isLeaf() ? enlarged + inheritance : (enlarged - surfaceArea(c.boundsMin, c.boundsMax)) + inheritance;
+        };
+        float costLeft = childCost(node.left);
+        float costRight = childCost(node.right);
+        if (cost < costLeft && cost < costRight) break;
+        index = costLeft < costRight ? node.left : node.right;
+    }
+
+    // Cria um novo pai para o irmão escolhido e a nova folha
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].boundsMin = glm::min(leafMin, nodes[sibling].boundsMin);
+    nodes[newParent].boundsMax = glm::max(leafMax, nodes[sibling].boundsMax);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+    if (oldParent == NULL_NODE) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+
+    refit(nodes[leaf].parent);
+}
+
+void AabbTree::removeLeaf(int leaf)
+{
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+    if (nodes[grandParent].left == parent) nodes[grandParent].left = sibling;
+    else nodes[grandParent].right = sibling;
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    refit(grandParent);
+}
+
+// Sobe até a raiz rebalanceando e recalculando caixas e alturas
+void AabbTree::refit(int index)
+{
+    while (index != NULL_NODE) {
+        index = balance(index);
+        Node& node = nodes[index];
+        const Node& left = nodes[node.left];
+        const Node& right = nodes[node.right];
+        node.height = 1 + std::max(left.height, right.height);
+        node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+        node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+        index = node.parent;
+    }
+}
+
+// Rotação quando um dos lados fica mais de um nível mais alto que o outro
+int AabbTree::balance(int a)
+{
+    Node& A = nodes[a];
+    if (A.isLeaf() || A.height < 2) return a;
+
+    int b = A.left, c = A.right;
+    int balanceFactor = nodes[c].height - nodes[b].height;
+    if (balanceFactor == 0 || std::abs(balanceFactor) == 1) return a;
+
+    // Sobe o filho mais alto (c se balanceFactor > 0, senão b)
+    int high = balanceFactor > 0 ? c : b;
+    int low = balanceFactor > 0 ? b : c;
+    int f = nodes[high].left, g = nodes[high].right;
+
+    nodes[high].left = a;
+    nodes[high].parent = A.parent;
+    A.parent = high;
+    if (nodes[high].parent != NULL_NODE) {
+        if (nodes[nodes[high].parent].left == a) nodes[nodes[high].parent].left = high;
+        else nodes[nodes[high].parent].right = high;
+    } else {
+        root = high;
+    }
+
+    // O neto mais alto fica com o nó que subiu; o outro desce para `a`
+    int keep = nodes[f].height > nodes[g].height ? f : g;
+    int give = keep == f ? g : f;
+    nodes[high].right = keep;
+    if (balanceFactor > 0) A.right = give; else A.left = give;
+    nodes[give].parent = a;
+
+    A.boundsMin = glm::min(nodes[low].boundsMin, nodes[give].boundsMin);
+    A.boundsMax = glm::max(nodes[low].boundsMax, nodes[give].boundsMax);
+    A.height = 1 + std::max(nodes[low].height, nodes[give].height);
+    nodes[high].boundsMin = glm::min(A.boundsMin, nodes[keep].boundsMin);
+    nodes[high].boundsMax = glm::max(A.boundsMax, nodes[keep].boundsMax);
+    nodes[high].height = 1 + std::max(A.height, nodes[keep].height);
+    return high;
+}
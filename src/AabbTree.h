@@ -0,0 +1,163 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "MeshBVH.h"
+
+// ============================================================================
+// ÁRVORE DINÂMICA DE AABBs
+// ============================================================================
+// BVH de objetos (não de triângulos) que aceita inserção e remoção sem
+// reconstruir tudo: cada folha guarda a caixa de um objeto e um identificador
+// do usuário. A árvore é mantida balanceada com rotações, como no Box2D.
+class AabbTree
+{
+public:
+    static constexpr int NULL_NODE = -1;
+
+    // Retorna o identificador da folha (proxy), estável até a remoção
+    int insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, int userData);
+    void remove(int proxy);
+    // Troca a caixa de uma folha reinserindo-a; o proxy continua o mesmo
+    void update(int proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void clear();
+
+    int userData(int proxy) const { return nodes[proxy].userData; }
+    glm::vec3 boundsMin(int proxy) const { return nodes[proxy].boundsMin; }
+    glm::vec3 boundsMax(int proxy) const { return nodes[proxy].boundsMax; }
+    bool empty() const { return root == NULL_NODE; }
+
+    // Raio origin + dir * t, t em [0, maxDistance] (dir normalizado). Para cada
+    // folha cuja caixa o raio cruza, chama narrow(userData, melhorAtual), que
+    // retorna a distância do acerto exato ou um valor negativo se errou.
+    // Retorna o userData do acerto mais próximo ou -1.
+    template <typename NarrowPhase>
+    int raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, NarrowPhase&& narrow, float* hitDistance = nullptr) const;
+
+    // Chama visit(proxy) para cada folha cuja caixa intersecta [boundsMin, boundsMax]
+    template <typename Visitor>
+    void query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, Visitor&& visit) const;
+
+    // Visita as folhas em ordem crescente de distância da caixa até `point`.
+    // visit(proxy, limite²) pode reduzir o limite; para quando nada mais cabe nele.
+    template <typename Visitor>
+    void nearest(const glm::vec3& point, float maxDistanceSq, Visitor&& visit) const;
+
+private:
+    // Folhas e nós internos ficam balanceados por altura (AVL): a altura não
+    // passa de ~1,44 log2(n), e a pilha de percurso guarda no máximo altura + 1
+    static constexpr int TRAVERSAL_STACK_SIZE = 64;
+
+    struct Node {
+        glm::vec3 boundsMin, boundsMax;
+        int parent = NULL_NODE;
+        int left = NULL_NODE, right = NULL_NODE;
+        int height = 0;                // Folha = 0; livre = -1
+        int userData = -1;
+        bool isLeaf() const { return left == NULL_NODE; }
+    };
+
+    int allocateNode();
+    void freeNode(int index);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int index);
+    void refit(int index);
+
+    std::vector<Node> nodes;
+    int root = NULL_NODE;
+    int freeList = NULL_NODE;
+};
+
+// Teste do raio contra uma caixa; retorna a distância de entrada ou um valor negativo
+float rayBoxDistance(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance);
+
+// Quadrado da distância de um ponto até a caixa (0 se estiver dentro)
+inline float pointBoxDistanceSq(const glm::vec3& point, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    glm::vec3 d = glm::max(glm::max(boundsMin - point, point - boundsMax), glm::vec3(0.0f));
+    return glm::dot(d, d);
+}
+
+template <typename NarrowPhase>
+int AabbTree::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, NarrowPhase&& narrow, float* hitDistance) const
+{
+    if (root == NULL_NODE) return -1;
+    const glm::vec3 invDir = inverseDirection(dir);
+    float best = maxDistance;
+    int bestData = -1;
+
+    int stack[TRAVERSAL_STACK_SIZE];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (rayBoxDistance(origin, invDir, node.boundsMin, node.boundsMax, best) < 0.0f) continue;
+        if (node.isLeaf()) {
+            float distance = narrow(node.userData, best);
+            if (distance >= 0.0f && distance <= best) {
+                best = distance;
+                bestData = node.userData;
+            }
+        } else {
+            assert(top + 2 <= TRAVERSAL_STACK_SIZE);
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    if (hitDistance && bestData >= 0) *hitDistance = best;
+    return bestData;
+}
+
+template <typename Visitor>
+void AabbTree::query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, Visitor&& visit) const
+{
+    if (root == NULL_NODE) return;
+    int stack[TRAVERSAL_STACK_SIZE];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        int index = stack[--top];
+        const Node& node = nodes[index];
+        if (glm::any(glm::lessThan(node.boundsMax, boundsMin)) || glm::any(glm::greaterThan(node.boundsMin, boundsMax))) continue;
+        if (node.isLeaf()) {
+            visit(index);
+        } else {
+            assert(top + 2 <= TRAVERSAL_STACK_SIZE);
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+}
+
+template <typename Visitor>
+void AabbTree::nearest(const glm::vec3& point, float maxDistanceSq, Visitor&& visit) const
+{
+    if (root == NULL_NODE) return;
+    // Busca best-first: heap mínima de (distância², nó), reaproveitada entre consultas
+    struct Entry { float distanceSq; int node; };
+    auto farther = [](const Entry& a, const Entry& b) { return a.distanceSq > b.distanceSq; };
+    thread_local std::vector<Entry> heap;
+    heap.clear();
+    heap.push_back({pointBoxDistanceSq(point, nodes[root].boundsMin, nodes[root].boundsMax), root});
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), farther);
+        Entry entry = heap.back();
+        heap.pop_back();
+        if (entry.distanceSq > maxDistanceSq) break;
+        const Node& node = nodes[entry.node];
+        if (node.isLeaf()) {
+            visit(entry.node, maxDistanceSq);
+            continue;
+        }
+        for (int child : {node.left, node.right}) {
+            float distanceSq = pointBoxDistanceSq(point, nodes[child].boundsMin, nodes[child].boundsMax);
+            if (distanceSq > maxDistanceSq) continue;
+            heap.push_back({distanceSq, child});
+            std::push_heap(heap.begin(), heap.end(), farther);
+        }
+    }
+}
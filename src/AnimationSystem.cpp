@@ -0,0 +1,84 @@
+#include "AnimationSystem.h"
+#include <algorithm>
+#include <cmath>
+
+int AnimationSystem::addChannel(float initial, int userData)
+{
+    channelValues.push_back(initial);
+    channelUserData.push_back(userData);
+    activeSlot.push_back(-1);
+    return static_cast<int>(channelValues.size() - 1);
+}
+
+void AnimationSystem::clear()
+{
+    channelValues.clear();
+    channelUserData.clear();
+    activeSlot.clear();
+    activeChannel.clear();
+    activeValue.clear();
+    activeTarget.clear();
+    activeSpeed.clear();
+    changed.clear();
+}
+
+void AnimationSystem::animateTo(int channel, float target, float speed)
+{
+    int slot = activeSlot[channel];
+    if (slot < 0) {
+        // Acorda: entra no fim do array ativo
+        slot = static_cast<int>(activeChannel.size());
+        activeSlot[channel] = slot;
+        activeChannel.push_back(channel);
+        activeValue.push_back(channelValues[channel]);
+        activeTarget.push_back(target);
+        activeSpeed.push_back(speed);
+        return;
+    }
+    activeTarget[slot] = target;
+    activeSpeed[slot] = speed;
+}
+
+void AnimationSystem::update(float dt)
+{
+    changed.clear();
+    const size_t count = activeChannel.size();
+    if (count == 0) return;
+
+    // Passo sem desvios sobre arrays contíguos (min/max): o compilador vetoriza o laço
+    float* value = activeValue.data();
+    const float* target = activeTarget.data();
+    const float* speed = activeSpeed.data();
+    for (size_t i = 0; i < count; ++i) {
+        float step = speed[i] * dt;
+        value[i] += std::min(std::max(target[i] - value[i], -step), step);
+    }
+
+    // Devolve os valores aos canais; quem chegou fica exatamente no alvo e
+    // adormece (de trás para frente, porque sleep() troca com o último)
+    changed.assign(activeChannel.begin(), activeChannel.end());
+    for (size_t i = 0; i < count; ++i) channelValues[activeChannel[i]] = value[i];
+    for (size_t i = count; i-- > 0;) {
+        if (std::fabs(target[i] - value[i]) <= ARRIVAL_EPSILON) {
+            channelValues[activeChannel[i]] = target[i];
+            sleep(i);
+        }
+    }
+}
+
+void AnimationSystem::sleep(size_t slot)
+{
+    const size_t last = activeChannel.size() - 1;
+    activeSlot[activeChannel[slot]] = -1;
+    if (slot != last) {
+        activeChannel[slot] = activeChannel[last];
+        activeValue[slot] = activeValue[last];
+        activeTarget[slot] = activeTarget[last];
+        activeSpeed[slot] = activeSpeed[last];
+        activeSlot[activeChannel[slot]] = static_cast<int>(slot);
+    }
+    activeChannel.pop_back();
+    activeValue.pop_back();
+    activeTarget.pop_back();
+    activeSpeed.pop_back();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// ============================================================================
+// SISTEMA DE ANIMAÇÃO (TWEENS)
+// ============================================================================
+// Cada valor animável é um canal (ex.: offset da tampa de um baú, intensidade
+// da sua luz). Só os canais em movimento ficam no array compacto de tweens
+// ativos, então o custo de update() acompanha o número de animações em
+// andamento, não o número de objetos da cena. Um canal acorda com animateTo()
+// e volta a dormir sozinho ao chegar no alvo.
+class AnimationSystem
+{
+public:
+    // Cria um canal parado em `initial`; `userData` identifica o dono para quem
+    // consulta os canais alterados
+    int addChannel(float initial, int userData = -1);
+    void clear();
+
+    // Move o canal até `target` com velocidade constante (unidades por segundo)
+    void animateTo(int channel, float target, float speed);
+
+    // Avança todos os tweens ativos e adormece os que chegaram ao alvo
+    void update(float dt);
+
+    float value(int channel) const { return channelValues[channel]; }
+    int userData(int channel) const { return channelUserData[channel]; }
+    bool isActive(int channel) const { return activeSlot[channel] >= 0; }
+    const std::vector<float>& values() const { return channelValues; }
+
+    // Canais cujo valor mudou no último update (inclusive os que terminaram nele)
+    const std::vector<int>& changedChannels() const { return changed; }
+
+    size_t channelCount() const { return channelValues.size(); }
+    size_t activeCount() const { return activeChannel.size(); }
+
+private:
+    static constexpr float ARRIVAL_EPSILON = 1e-5f;
+
+    void sleep(size_t slot);
+
+    // Por canal
+    std::vector<float> channelValues;
+    std::vector<int> channelUserData;
+    std::vector<int> activeSlot;          // Posição no array ativo ou -1
+
+    // Tweens ativos, compactos (SoA) para o laço de update
+    std::vector<int> activeChannel;
+    std::vector<float> activeValue, activeTarget, activeSpeed;
+
+    std::vector<int> changed;
+};
@@ -0,0 +1,73 @@
+#include "BakedScene.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    const char MAGIC[4] = {'L', 'B', 'K', '1'};
+}
+
+uint64_t BakedScene::sourceStamp(const std::string& sourcePath)
+{
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(sourcePath, error);
+    if (error) return 0;
+    auto modified = std::filesystem::last_write_time(sourcePath, error);
+    if (error) return 0;
+    uint64_t ticks = static_cast<uint64_t>(modified.time_since_epoch().count());
+    return size * 0x9E3779B97F4A7C15ull ^ ticks;
+}
+
+bool BakedScene::load(const std::string& cachePath, uint64_t stamp)
+{
+    chunks.clear();
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    uint64_t fileStamp = 0;
+    uint32_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&fileStamp), sizeof(fileStamp));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || fileStamp != stamp) return false;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t tagLength = 0;
+        uint64_t size = 0;
+        file.read(reinterpret_cast<char*>(&tagLength), sizeof(tagLength));
+        std::string tag(tagLength, '\0');
+        file.read(&tag[0], tagLength);
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        std::vector<char> data(size);
+        file.read(data.data(), size);
+        if (!file) { chunks.clear(); return false; }
+        chunks[tag] = std::move(data);
+    }
+    return true;
+}
+
+bool BakedScene::save(const std::string& cachePath, uint64_t stamp) const
+{
+    std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    uint32_t count = static_cast<uint32_t>(chunks.size());
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&stamp), sizeof(stamp));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (auto const& [tag, data] : chunks) {
+        uint32_t tagLength = static_cast<uint32_t>(tag.size());
+        uint64_t size = data.size();
+        file.write(reinterpret_cast<const char*>(&tagLength), sizeof(tagLength));
+        file.write(tag.data(), tagLength);
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(data.data(), size);
+    }
+    return static_cast<bool>(file);
+}
+
+const std::vector<char>* BakedScene::find(const std::string& tag) const
+{
+    auto it = chunks.find(tag);
+    return it == chunks.end() ? nullptr : &it->second;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// DADOS PRÉ-CALCULADOS DA CENA
+// ============================================================================
+// Arquivo binário guardado ao lado do OBJ (ex.: "models/lab.obj.bake") com os
+// resultados caros de calcular no carregamento. Cada sistema grava o seu bloco
+// sob uma etiqueta própria. O arquivo inteiro é descartado quando o OBJ de
+// origem muda (tamanho ou data de modificação).
+class BakedScene
+{
+public:
+    // Carimbo da fonte: muda sempre que o arquivo de origem é alterado
+    static uint64_t sourceStamp(const std::string& sourcePath);
+
+    bool load(const std::string& cachePath, uint64_t stamp);
+    bool save(const std::string& cachePath, uint64_t stamp) const;
+
+    const std::vector<char>* find(const std::string& tag) const;
+    void put(const std::string& tag, std::vector<char> data) { chunks[tag] = std::move(data); }
+
+private:
+    std::map<std::string, std::vector<char>> chunks;
+};
+
+// Serialização simples de tipos triviais para os blocos do arquivo
+class ByteWriter
+{
+public:
+    template <typename T> void write(const T& value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+    template <typename T> void writeArray(const std::vector<T>& values)
+    {
+        write<uint64_t>(values.size());
+        const char* bytes = reinterpret_cast<const char*>(values.data());
+        data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+    std::vector<char> data;
+};
+
+class ByteReader
+{
+public:
+    explicit ByteReader(const std::vector<char>& source) : data(source) {}
+
+    template <typename T> bool read(T& value)
+    {
+        if (offset + sizeof(T) > data.size()) return false;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+    template <typename T> bool readArray(std::vector<T>& values)
+    {
+        uint64_t count = 0;
+        if (!read(count) || offset + count * sizeof(T) > data.size()) return false;
+        values.resize(count);
+        std::memcpy(values.data(), data.data() + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+        return true;
+    }
+
+private:
+    const std::vector<char>& data;
+    size_t offset = 0;
+};
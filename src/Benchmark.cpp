@@ -0,0 +1,863 @@
+// ============================================================================
+// BENCHMARKS SEM JANELA (não cria contexto OpenGL)
+// ============================================================================
+#include "CollisionWorld.h"
+#include "DistanceField.h"
+#include "JobSystem.h"
+#include "SceneQuery.h"
+#include "AnimationSystem.h"
+#include "NavGrid.h"
+#include "GridPathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "IncrementalPathfinder.h"
+#include "FlowField.h"
+#include "CrowdSystem.h"
+#include "SpatialHash.h"
+#include "MazeGenerator.h"
+#include "WorldStreamer.h"
+#include "TileKit.h"
+#include "Lightmap.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    int failedChecks = 0;                // Limites verificados pelos benchmarks; main sai com erro se algum falhou
+
+    double secondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Labirinto sintético de size x size células: paredes aleatórias agrupadas em
+    // malhas de 8x8 células, como os objetos "Paredes*" de um OBJ
+    void buildSyntheticMaze(CollisionWorld& world, int size, float cellSize, unsigned int seed,
+                            std::vector<glm::vec3>* allTriangles = nullptr)
+    {
+        const int block = 8;
+        const float thickness = 0.2f, height = 3.0f;
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution wall(0.45);
+        int blocks = (size + block - 1) / block;
+        std::vector<std::vector<glm::vec3>> meshes(static_cast<size_t>(blocks) * blocks);
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                auto& mesh = meshes[static_cast<size_t>(z / block) * blocks + x / block];
+                glm::vec3 corner(x * cellSize, 0.0f, z * cellSize);
+                if (x == size - 1 || wall(rng))
+                    appendBox(mesh, corner + glm::vec3(cellSize - thickness, 0.0f, 0.0f), corner + glm::vec3(cellSize, height, cellSize));
+                if (z == size - 1 || wall(rng))
+                    appendBox(mesh, corner + glm::vec3(0.0f, 0.0f, cellSize - thickness), corner + glm::vec3(cellSize, height, cellSize));
+                if (x == 0) appendBox(mesh, corner, corner + glm::vec3(thickness, height, cellSize));
+                if (z == 0) appendBox(mesh, corner, corner + glm::vec3(cellSize, height, thickness));
+            }
+        }
+        for (const auto& mesh : meshes) {
+            if (mesh.empty()) continue;
+            world.addMesh(mesh);
+            if (allTriangles) allTriangles->insert(allTriangles->end(), mesh.begin(), mesh.end());
+        }
+        world.build();
+    }
+
+    // Labirinto perfeito do gerador (backtracker): um único caminho entre
+    // quaisquer duas células, o pior caso para buscas longas
+    void buildPerfectMaze(int size, float cellSize, unsigned int seed, std::vector<glm::vec3>& triangles)
+    {
+        MazeGeometry geometry;
+        buildMazeGeometry(generateMaze(size, size, MazeAlgorithm::Backtracker, seed), cellSize, geometry);
+        for (const auto& block : geometry.wallBlocks) triangles.insert(triangles.end(), block.begin(), block.end());
+    }
+
+    // Consultas de esfera varrida por segundo para labirintos de tamanhos crescentes
+    void benchCollision()
+    {
+        std::cout << "=== COLISÃO: ESFERA VARRIDA (BVH por malha + grade) ===" << std::endl;
+        std::cout << std::setw(10) << "células" << std::setw(12) << "triângulos" << std::setw(14) << "sweep/s"
+                  << std::setw(14) << "slide/s" << std::setw(12) << "p99 (us)" << std::setw(12) << "máx (us)"
+                  << std::setw(12) << "estouros" << std::endl;
+        const float cellSize = 2.0f, radius = 0.4f, step = 5.0f / 60.0f;
+        const int queries = 100000;
+        for (int size : {16, 64, 256, 512}) {
+            // Como no jogo: o campo de distância recebe as consultas que estouram o orçamento
+            CollisionWorld world;
+            std::vector<glm::vec3> allTriangles;
+            buildSyntheticMaze(world, size, cellSize, 42u, &allTriangles);
+            DistanceField field;
+            field.build(allTriangles, glm::vec2(-1.0f), glm::vec2(size * cellSize + 1.0f), 0.25f, 1.1f, 1.9f);
+            world.setFallbackField(&field);
+            size_t triangles = 0;
+            for (unsigned int i = 0; i < world.meshCount(); ++i) triangles += world.mesh(i).triangleCount();
+
+            std::mt19937 rng(7u);
+            std::uniform_real_distribution<float> coord(0.0f, size * cellSize);
+            std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            std::vector<glm::vec3> starts(queries), deltas(queries);
+            for (int i = 0; i < queries; ++i) {
+                starts[i] = glm::vec3(coord(rng), 1.5f, coord(rng));
+                float a = angle(rng);
+                deltas[i] = glm::vec3(std::cos(a), 0.0f, std::sin(a)) * step;
+            }
+
+            int hits = 0, truncated = 0;
+            auto start = Clock::now();
+            for (int i = 0; i < queries; ++i) {
+                SweepHit hit;
+                hits += world.sweep(starts[i], deltas[i], radius, hit) ? 1 : 0;
+                truncated += hit.truncated ? 1 : 0;
+            }
+            double sweepSeconds = secondsSince(start);
+
+            // Tempo individual de cada consulta, para verificar o orçamento por consulta
+            double moved = 0.0;
+            std::vector<double> latencies(queries);
+            start = Clock::now();
+            for (int i = 0; i < queries; ++i) {
+                auto queryStart = Clock::now();
+                moved += glm::length(world.slide(starts[i], deltas[i], radius) - starts[i]);
+                latencies[i] = secondsSince(queryStart);
+            }
+            double slideSeconds = secondsSince(start);
+            std::sort(latencies.begin(), latencies.end());
+            double p99 = latencies[static_cast<size_t>(queries * 0.99)];
+
+            std::cout << std::setw(10) << size * size << std::setw(12) << triangles
+                      << std::setw(14) << static_cast<long long>(queries / sweepSeconds)
+                      << std::setw(14) << static_cast<long long>(queries / slideSeconds)
+                      << std::setw(12) << std::fixed << std::setprecision(2) << p99 * 1e6
+                      << std::setw(12) << latencies.back() * 1e6
+                      << std::setw(12) << world.budgetOverruns()
+                      << "   (" << hits << " contatos, " << truncated << " sweeps truncados, deslocamento médio "
+                      << std::setprecision(3) << moved / queries << ")" << std::endl;
+        }
+    }
+
+    // Construção do campo de distância e corpos movidos por segundo só com amostras
+    void benchDistanceField()
+    {
+        std::cout << "=== CAMPO DE DISTÂNCIA 2D (EDT exata, " << JobSystem::shared().threadCount() << " threads) ===" << std::endl;
+        std::cout << std::setw(10) << "células" << std::setw(14) << "grade SDF" << std::setw(14) << "build (ms)"
+                  << std::setw(18) << "passos/s" << std::endl;
+        const float cellSize = 2.0f, radius = 0.4f, step = 5.0f / 60.0f;
+        const int bodies = 10000, ticks = 120;
+        for (int size : {64, 256, 512}) {
+            CollisionWorld world;
+            std::vector<glm::vec3> triangles;
+            buildSyntheticMaze(world, size, cellSize, 42u, &triangles);
+
+            DistanceField field;
+            auto start = Clock::now();
+            field.build(triangles, glm::vec2(-1.0f), glm::vec2(size * cellSize + 1.0f), 0.25f, 1.1f, 1.9f);
+            double buildSeconds = secondsSince(start);
+
+            std::mt19937 rng(11u);
+            std::uniform_real_distribution<float> coord(0.0f, size * cellSize);
+            std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            std::vector<glm::vec3> positions(bodies), velocities(bodies);
+            for (int i = 0; i < bodies; ++i) {
+                positions[i] = field.resolve(glm::vec3(coord(rng), 1.5f, coord(rng)), radius);
+                float a = angle(rng);
+                velocities[i] = glm::vec3(std::cos(a), 0.0f, std::sin(a)) * step;
+            }
+            start = Clock::now();
+            for (int t = 0; t < ticks; ++t) {
+                JobSystem::shared().parallelFor(bodies, 512, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) positions[i] = field.move(positions[i], velocities[i], radius);
+                });
+            }
+            double moveSeconds = secondsSince(start);
+
+            std::cout << std::setw(10) << size * size << std::setw(14)
+                      << (std::to_string(field.width()) + "x" + std::to_string(field.height()))
+                      << std::setw(14) << std::fixed << std::setprecision(1) << buildSeconds * 1e3
+                      << std::setw(18) << static_cast<long long>(double(bodies) * ticks / moveSeconds) << std::endl;
+        }
+    }
+
+    // Gatilhos de proximidade: objetos que se movem a cada tick e consultas de
+    // raio em lote, uma por agente
+    void benchSceneQuery()
+    {
+        std::cout << "=== CONSULTAS DE PROXIMIDADE (árvore dinâmica com margem) ===" << std::endl;
+        std::cout << std::setw(10) << "objetos" << std::setw(14) << "move/s" << std::setw(16) << "raio lote/s"
+                  << std::setw(14) << "k-nn/s" << std::setw(14) << "reinserções" << std::endl;
+        const float worldSize = 200.0f, radius = 3.5f, speed = 5.0f / 60.0f;
+        const int ticks = 60, agents = 512;
+        for (int count : {100, 1000, 10000, 100000}) {
+            std::mt19937 rng(3u);
+            std::uniform_real_distribution<float> coord(0.0f, worldSize);
+            std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            SceneQuery query;
+            std::vector<int> handles(count);
+            std::vector<glm::vec3> positions(count), velocities(count);
+            const glm::vec3 half(0.3f, 0.5f, 0.3f);
+            for (int i = 0; i < count; ++i) {
+                positions[i] = glm::vec3(coord(rng), 0.5f, coord(rng));
+                float a = angle(rng);
+                velocities[i] = glm::vec3(std::cos(a), 0.0f, std::sin(a)) * speed;
+                handles[i] = query.add(positions[i] - half, positions[i] + half, i % 10 == 0 ? QueryTag::Trigger : QueryTag::Agent, i);
+            }
+            std::vector<glm::vec3> centers(agents);
+            for (auto& c : centers) c = glm::vec3(coord(rng), 0.5f, coord(rng));
+
+            double moveSeconds = 0.0, batchSeconds = 0.0;
+            size_t found = 0;
+            QueryBatch batch;
+            for (int t = 0; t < ticks; ++t) {
+                auto start = Clock::now();
+                for (int i = 0; i < count; ++i) {
+                    positions[i] += velocities[i];
+                    query.move(handles[i], positions[i] - half, positions[i] + half);
+                }
+                moveSeconds += secondsSince(start);
+
+                start = Clock::now();
+                query.queryRadiusBatch(centers, radius, QueryTag::Trigger | QueryTag::Agent, batch, JobSystem::shared());
+                batchSeconds += secondsSince(start);
+                found += batch.userData.size();
+            }
+
+            std::vector<int> nearest;
+            auto start = Clock::now();
+            for (int i = 0; i < agents * 10; ++i) {
+                nearest.clear();
+                query.queryNearest(centers[i % agents], 8, QueryTag::All, 1e9f, nearest);
+            }
+            double knnSeconds = secondsSince(start);
+
+            std::cout << std::setw(10) << count
+                      << std::setw(14) << static_cast<long long>(double(count) * ticks / moveSeconds)
+                      << std::setw(16) << static_cast<long long>(double(agents) * ticks / batchSeconds)
+                      << std::setw(14) << static_cast<long long>(agents * 10 / knnSeconds)
+                      << std::setw(14) << query.reinsertions()
+                      << "   (" << found / ticks << " resultados por tick)" << std::endl;
+        }
+    }
+
+    // Caminhos por segundo em labirintos perfeitos: A* direto na grade contra
+    // HPA* (só o caminho abstrato e o caminho refinado até as células)
+    void benchPathfinding()
+    {
+        std::cout << "=== CAMINHOS: A* NA GRADE x HPA* (clusters 16x16) ===" << std::endl;
+        std::cout << std::setw(8) << "maze" << std::setw(12) << "grade" << std::setw(12) << "nav (ms)" << std::setw(12) << "HPA (ms)"
+                  << std::setw(10) << "nós" << std::setw(12) << "A*/s" << std::setw(14) << "HPA*/s" << std::setw(16) << "refinado/s"
+                  << std::setw(12) << "excesso" << std::setw(8) << "MB" << std::endl;
+        const float mazeCell = 2.0f, navCell = 0.5f, agentRadius = 0.35f;
+        for (int size : {16, 64, 128, 256}) {
+            std::vector<glm::vec3> walls;
+            buildPerfectMaze(size, mazeCell, 5u, walls);
+            const glm::vec2 lo(-1.0f), hi(size * mazeCell + 1.0f);
+            DistanceField field;
+            field.build(walls, lo, hi, 0.25f, 1.1f, 1.9f);
+
+            NavGrid grid;
+            auto start = Clock::now();
+            grid.build({}, field, lo, hi, navCell, agentRadius);  // Sem lista de piso: tudo é piso
+            double navSeconds = secondsSince(start);
+
+            HierarchicalPathfinder hpa;
+            start = Clock::now();
+            hpa.build(grid, 16, &JobSystem::shared());
+            double hpaSeconds = secondsSince(start);
+
+            // Pares de células livres sorteados no labirinto inteiro
+            std::mt19937 rng(9u);
+            std::uniform_real_distribution<float> coord(0.0f, size * mazeCell);
+            const int pairs = size >= 128 ? 50 : 200;
+            std::vector<glm::ivec2> starts, goals;
+            while (static_cast<int>(starts.size()) < pairs) {
+                glm::ivec2 a = grid.nearestWalkable(grid.cellAt(glm::vec3(coord(rng), 0.0f, coord(rng))));
+                glm::ivec2 b = grid.nearestWalkable(grid.cellAt(glm::vec3(coord(rng), 0.0f, coord(rng))));
+                if (a.x < 0 || b.x < 0) continue;
+                starts.push_back(a);
+                goals.push_back(b);
+            }
+
+            GridPathfinder astar;
+            std::vector<float> exact(pairs);
+            std::vector<glm::ivec2> path;
+            start = Clock::now();
+            for (int i = 0; i < pairs; ++i) exact[i] = astar.findPath(grid, starts[i], goals[i], &path);
+            double astarSeconds = secondsSince(start);
+
+            // HPA* repete os pares várias vezes para ter tempo mensurável
+            const int rounds = 20;
+            std::vector<float> approx(pairs);
+            std::vector<glm::ivec2> waypoints;
+            start = Clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                for (int i = 0; i < pairs; ++i) approx[i] = hpa.findPath(starts[i], goals[i], waypoints);
+            }
+            double hpaQuerySeconds = secondsSince(start);
+
+            int failures = 0;
+            std::vector<std::vector<glm::ivec2>> refined(pairs);
+            start = Clock::now();
+            for (int i = 0; i < pairs; ++i) {
+                if (hpa.findPath(starts[i], goals[i], waypoints) >= 0.0f && !hpa.refine(waypoints, refined[i])) ++failures;
+            }
+            double refineSeconds = secondsSince(start);
+
+            // O caminho refinado anda de vizinho em vizinho e custa o mesmo que o abstrato
+            for (int i = 0; i < pairs; ++i) {
+                if (approx[i] < 0.0f) continue;
+                const std::vector<glm::ivec2>& cells = refined[i];
+                float cost = 0.0f;
+                bool valid = !cells.empty() && cells.front() == starts[i] && cells.back() == goals[i];
+                for (size_t c = 1; valid && c < cells.size(); ++c) {
+                    const glm::ivec2 step = glm::abs(cells[c] - cells[c - 1]);
+                    valid = grid.walkable(cells[c]) && step.x <= 1 && step.y <= 1 && step.x + step.y > 0;
+                    cost += step.x + step.y == 2 ? 1.41421356f : 1.0f;
+                }
+                if (!valid || std::abs(cost - approx[i]) > 1e-2f * approx[i] + 1e-3f) ++failures;
+            }
+
+            // Excesso médio do custo HPA* sobre o ótimo (e caminhos perdidos)
+            double excess = 0.0;
+            int compared = 0;
+            for (int i = 0; i < pairs; ++i) {
+                if ((exact[i] < 0.0f) != (approx[i] < 0.0f)) ++failures;
+                if (exact[i] > 0.0f && approx[i] > 0.0f) { excess += approx[i] / exact[i] - 1.0; ++compared; }
+            }
+
+            std::cout << std::setw(8) << size << std::setw(12) << (std::to_string(grid.width()) + "x" + std::to_string(grid.height()))
+                      << std::setw(12) << std::fixed << std::setprecision(1) << navSeconds * 1e3
+                      << std::setw(12) << hpaSeconds * 1e3 << std::setw(10) << hpa.nodeCount()
+                      << std::setw(12) << static_cast<long long>(pairs / astarSeconds)
+                      << std::setw(14) << static_cast<long long>(double(pairs) * rounds / hpaQuerySeconds)
+                      << std::setw(16) << static_cast<long long>(pairs / refineSeconds)
+                      << std::setw(11) << std::setprecision(2) << (compared ? excess / compared * 100.0 : 0.0) << "%"
+                      << std::setw(8) << std::setprecision(1) << hpa.memoryBytes() / (1024.0 * 1024.0);
+            if (failures) std::cout << "   (" << failures << " divergências!)";
+            std::cout << std::endl;
+        }
+    }
+
+    // Orientação do jogador: reparo incremental (D* Lite) a cada tick enquanto ele
+    // anda pelo caminho, contra replanejar do zero com A* a cada troca de célula
+    void benchGuidance()
+    {
+        std::cout << "=== ORIENTAÇÃO: D* LITE INCREMENTAL x A* DO ZERO ===" << std::endl;
+        std::cout << std::setw(8) << "maze" << std::setw(12) << "grade" << std::setw(14) << "marcos (ms)" << std::setw(16) << "média (us)"
+                  << std::setw(12) << "p99 (us)" << std::setw(12) << "máx (us)" << std::setw(16) << "máx CPU (us)"
+                  << std::setw(16) << "A* zero (us)" << std::setw(18) << "ticks até pronto" << std::endl;
+        const auto guidanceBudget = std::chrono::microseconds(50);   // Mesmo orçamento de Game::updateGuidance
+        // O limite vale para o tempo de CPU do tick: com poucos núcleos, o sistema
+        // pode tirar a thread do meio de qualquer tick, e isso aparece só no máximo
+        const double tickLimit = 100e-6;
+        const int ticks = 3000, ticksPerCell = 6; // 5 unidades/s a 60 Hz em células de 0,5
+        for (int size : {32, 128, 256}) {
+            std::vector<glm::vec3> walls;
+            buildPerfectMaze(size, 2.0f, 5u, walls);
+            const glm::vec2 lo(-1.0f), hi(size * 2.0f + 1.0f);
+            DistanceField field;
+            field.build(walls, lo, hi, 0.25f, 1.1f, 1.9f);
+            NavGrid grid;
+            grid.build({}, field, lo, hi, 0.5f, 0.35f);
+
+            std::mt19937 rng(21u);
+            std::uniform_real_distribution<float> coord(0.0f, size * 2.0f);
+            auto randomCell = [&]() {
+                glm::ivec2 c(-1);
+                while (c.x < 0) c = grid.nearestWalkable(grid.cellAt(glm::vec3(coord(rng), 0.0f, coord(rng))));
+                return c;
+            };
+            std::vector<glm::ivec2> goals = {randomCell(), randomCell(), randomCell()};
+            glm::ivec2 player = randomCell();
+
+            IncrementalPathfinder guidance;
+            auto start = Clock::now();
+            guidance.buildLandmarks(grid, &JobSystem::shared());
+            const double landmarkSeconds = secondsSince(start);
+            guidance.reset(grid, goals);
+            GridPathfinder astar;
+            const std::vector<glm::ivec2>& path = guidance.path();
+            std::vector<glm::ivec2> scratch;
+            std::vector<double> latencies;
+            double astarSeconds = 0.0, maxCpuSeconds = 0.0;
+            int astarRuns = 0, firstReady = -1, slowTicks = 0, targetsReady = 0, readyTicks = 0, pendingSince = 0, wrongPaths = 0;
+            bool ready = false;
+            for (int t = 0; t < ticks; ++t) {
+                // Um alvo alcançado some (baú aberto) e a busca recomeça
+                if (ready && path.size() == 1) {
+                    goals.erase(std::find(goals.begin(), goals.end(), player));
+                    if (goals.empty()) goals = {randomCell(), randomCell(), randomCell()};
+                    guidance.reset(grid, goals);
+                    pendingSince = t;
+                }
+                const std::clock_t cpuStart = std::clock();
+                start = Clock::now();
+                ready = guidance.update(player, start + guidanceBudget);
+                latencies.push_back(secondsSince(start));
+                const double cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+                maxCpuSeconds = std::max(maxCpuSeconds, cpuSeconds);
+                if (cpuSeconds > tickLimit) ++slowTicks;
+                if (ready && firstReady < 0) firstReady = t;
+                if (ready && pendingSince >= 0) {
+                    readyTicks += t - pendingSince + 1;
+                    ++targetsReady;
+                    pendingSince = -1;
+                }
+
+                if (t % ticksPerCell == 0 && ready && path.size() > 1) {
+                    // Do zero: A* até cada alvo, como faria um replanejamento por célula
+                    start = Clock::now();
+                    float best = -1.0f;
+                    for (const glm::ivec2& goal : goals) {
+                        const float cost = astar.findPath(grid, player, goal, &scratch);
+                        if (cost >= 0.0f && (best < 0.0f || cost < best)) best = cost;
+                    }
+                    astarSeconds += secondsSince(start);
+                    ++astarRuns;
+
+                    // O caminho incremental começa no jogador, anda de vizinho em vizinho e é ótimo
+                    float cost = 0.0f;
+                    for (size_t c = 1; c < path.size(); ++c) {
+                        const glm::ivec2 step = glm::abs(path[c] - path[c - 1]);
+                        cost += step.x + step.y == 2 ? 1.41421356f : step.x + step.y == 1 ? 1.0f : 1e9f;
+                    }
+                    if (path.front() != player || std::abs(cost - best) > 1e-3f * best + 1e-3f) ++wrongPaths;
+                    player = path[1];
+                }
+            }
+            double total = 0.0;
+            for (double l : latencies) total += l;
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << std::setw(8) << size << std::setw(12) << (std::to_string(grid.width()) + "x" + std::to_string(grid.height()))
+                      << std::setw(14) << std::fixed << std::setprecision(1) << landmarkSeconds * 1e3
+                      << std::setw(16) << std::setprecision(2) << total / ticks * 1e6
+                      << std::setw(12) << latencies[static_cast<size_t>(ticks * 0.99)] * 1e6
+                      << std::setw(12) << latencies.back() * 1e6
+                      << std::setw(16) << maxCpuSeconds * 1e6
+                      << std::setw(16) << (astarRuns ? astarSeconds / astarRuns * 1e6 : 0.0)
+                      << std::setw(18) << (std::to_string(firstReady + 1) + " (" + std::to_string(targetsReady ? readyTicks / targetsReady : 0) + ")");
+            if (slowTicks) {
+                std::cout << "   (" << slowTicks << " ticks acima de 0,1 ms!)";
+                ++failedChecks;
+            }
+            if (wrongPaths) {
+                std::cout << "   (" << wrongPaths << " caminhos errados!)";
+                ++failedChecks;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    // Campos de fluxo (construção e cache) e ticks por segundo de uma multidão
+    // seguindo quatro alvos, no labirinto perfeito de 128x128
+    void benchCrowdFlow()
+    {
+        std::cout << "=== MULTIDÃO: CAMPOS DE FLUXO (" << JobSystem::shared().threadCount() << " threads) ===" << std::endl;
+        std::vector<glm::vec3> walls;
+        const int size = 128;
+        buildPerfectMaze(size, 2.0f, 5u, walls);
+        const glm::vec2 lo(-1.0f), hi(size * 2.0f + 1.0f);
+        DistanceField field;
+        field.build(walls, lo, hi, 0.25f, 1.1f, 1.9f);
+        NavGrid grid;
+        grid.build({}, field, lo, hi, 0.5f, 0.35f);
+
+        std::mt19937 rng(8u);
+        std::vector<int> freeCells;
+        for (int i = 0; i < grid.width() * grid.height(); ++i) {
+            if (grid.data()[i]) freeCells.push_back(i);
+        }
+        FlowFieldCache cache(8);
+        std::vector<glm::ivec2> targets;
+        for (int i = 0; i < 4; ++i) targets.push_back(grid.coords(freeCells[rng() % freeCells.size()]));
+        auto start = Clock::now();
+        for (const glm::ivec2& target : targets) cache.acquire(grid, target, &JobSystem::shared());
+        double buildSeconds = secondsSince(start) / targets.size();
+        start = Clock::now();
+        for (int i = 0; i < 100000; ++i) cache.acquire(grid, targets[i % targets.size()]);
+        double hitSeconds = secondsSince(start) / 100000;
+        std::cout << "grade " << grid.width() << "x" << grid.height() << ": campo em " << std::fixed << std::setprecision(2)
+                  << buildSeconds * 1e3 << " ms, consulta ao cache em " << hitSeconds * 1e9 << " ns" << std::endl;
+
+        std::cout << std::setw(10) << "agentes" << std::setw(16) << "ticks/s (1)" << std::setw(16) << "ticks/s (N)"
+                  << std::setw(18) << "agentes*tick/s" << std::endl;
+        const int ticks = 120;
+        const float dt = 1.0f / 60.0f;
+        for (int count : {1000, 10000, 100000}) {
+            double seconds[2] = {0.0, 0.0};
+            for (int pass = 0; pass < 2; ++pass) {
+                CrowdSystem crowd;
+                crowd.setGoalCount(static_cast<int>(targets.size()));
+                for (size_t g = 0; g < targets.size(); ++g) crowd.setGoalField(static_cast<int>(g), cache.acquire(grid, targets[g]));
+                std::mt19937 spawn(4u);
+                for (int i = 0; i < count; ++i) {
+                    glm::vec3 p = grid.cellCenter(grid.coords(freeCells[spawn() % freeCells.size()]), 0.0f);
+                    crowd.addAgent(glm::vec2(p.x, p.z), i % static_cast<int>(targets.size()));
+                }
+                start = Clock::now();
+                for (int t = 0; t < ticks; ++t) crowd.update(dt, grid, nullptr, pass == 0 ? nullptr : &JobSystem::shared());
+                seconds[pass] = secondsSince(start);
+            }
+            std::cout << std::setw(10) << count << std::setw(16) << static_cast<long long>(ticks / seconds[0])
+                      << std::setw(16) << static_cast<long long>(ticks / seconds[1])
+                      << std::setw(18) << static_cast<long long>(double(count) * ticks / seconds[1]) << std::endl;
+        }
+    }
+
+    // Multidão completa (campo de fluxo, hash espacial, desvio ORCA e colisão com
+    // o campo de distância das paredes): ticks por segundo por número de threads
+    void benchCrowd()
+    {
+        std::cout << "=== MULTIDÃO: DESVIO LOCAL + PAREDES (meta: 10k agentes a 60 Hz) ===" << std::endl;
+        std::vector<glm::vec3> walls;
+        const int size = 64;
+        buildPerfectMaze(size, 2.0f, 5u, walls);
+        const glm::vec2 lo(-1.0f), hi(size * 2.0f + 1.0f);
+        DistanceField field;
+        field.build(walls, lo, hi, 0.25f, 1.1f, 1.9f);
+        NavGrid grid;
+        grid.build({}, field, lo, hi, 0.5f, 0.35f);
+        std::vector<int> freeCells;
+        for (int i = 0; i < grid.width() * grid.height(); ++i) {
+            if (grid.data()[i]) freeCells.push_back(i);
+        }
+        std::mt19937 rng(8u);
+        FlowFieldCache cache(8);
+        std::vector<std::shared_ptr<const FlowField>> fields;
+        for (int i = 0; i < 4; ++i) fields.push_back(cache.acquire(grid, grid.coords(freeCells[rng() % freeCells.size()]), &JobSystem::shared()));
+
+        std::vector<unsigned int> threadCounts = {1};
+        const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int n = 2; n < hardware; n *= 2) threadCounts.push_back(n);
+        if (hardware > 1) threadCounts.push_back(hardware);
+
+        std::cout << std::setw(10) << "agentes" << std::setw(10) << "threads" << std::setw(14) << "ticks/s"
+                  << std::setw(14) << "ms/tick" << std::setw(16) << "vizinhos/agente" << std::endl;
+        const int ticks = 120;
+        const float dt = 1.0f / 60.0f;
+        for (int count : {1000, 10000, 50000}) {
+            for (unsigned int threads : threadCounts) {
+                JobSystem pool(threads - 1);
+                CrowdSystem crowd;
+                crowd.setGoalCount(static_cast<int>(fields.size()));
+                for (size_t g = 0; g < fields.size(); ++g) crowd.setGoalField(static_cast<int>(g), fields[g]);
+                std::mt19937 spawn(4u);
+                for (int i = 0; i < count; ++i) {
+                    glm::vec3 p = grid.cellCenter(grid.coords(freeCells[spawn() % freeCells.size()]), 0.0f);
+                    crowd.addAgent(glm::vec2(p.x, p.z), i % static_cast<int>(fields.size()));
+                }
+                auto start = Clock::now();
+                for (int t = 0; t < ticks; ++t) crowd.update(dt, grid, &field, &pool);
+                double seconds = secondsSince(start);
+
+                // Densidade final: vizinhos dentro do alcance, em média
+                SpatialHash hash;
+                hash.build(crowd.positionsX().data(), crowd.positionsZ().data(), crowd.size(), crowd.neighborDistance);
+                size_t neighborTotal = 0;
+                for (int i = 0; i < count; i += 16) {
+                    glm::vec2 p = crowd.position(i);
+                    hash.query(p.x, p.y, crowd.neighborDistance, [&](int j) {
+                        if (j != i && glm::length(crowd.position(j) - p) <= crowd.neighborDistance) ++neighborTotal;
+                    });
+                }
+                std::cout << std::setw(10) << count << std::setw(10) << threads
+                          << std::setw(14) << std::fixed << std::setprecision(1) << ticks / seconds
+                          << std::setw(14) << std::setprecision(3) << seconds / ticks * 1e3
+                          << std::setw(16) << std::setprecision(1) << double(neighborTotal) / ((count + 15) / 16) << std::endl;
+            }
+        }
+    }
+
+    // Baú no formato antigo (animação por objeto, com desvios), como referência
+    struct LegacyChest {
+        bool isAnimating = false, isOpen = false;
+        float lidOffsetY = 0.0f, targetLidOffsetY = 0.0f;
+        float currentLightIntensity = 0.0f, targetLightIntensity = 0.0f;
+
+        void update(float dt)
+        {
+            if (isAnimating) {
+                if (std::abs(lidOffsetY - targetLidOffsetY) < 0.01f) { lidOffsetY = targetLidOffsetY; isAnimating = false; }
+                else if (lidOffsetY < targetLidOffsetY) lidOffsetY += 2.0f * dt;
+                else lidOffsetY -= 2.0f * dt;
+            }
+            targetLightIntensity = isOpen ? 2.5f : 0.0f;
+            if (currentLightIntensity < targetLightIntensity) currentLightIntensity = std::min(currentLightIntensity + 3.0f * dt, targetLightIntensity);
+            else if (currentLightIntensity > targetLightIntensity) currentLightIntensity = std::max(currentLightIntensity - 3.0f * dt, targetLightIntensity);
+        }
+    };
+
+    // 100k baús, uma fração deles abrindo: o custo deve seguir as animações ativas
+    void benchAnimation()
+    {
+        std::cout << "=== ANIMAÇÃO: 100k BAÚS (tweens ativos compactos) ===" << std::endl;
+        std::cout << std::setw(10) << "abrindo" << std::setw(18) << "ativos (início)" << std::setw(22) << "por baú (us/tick)"
+                  << std::setw(20) << "tweens (us/tick)" << std::endl;
+        const int chestCount = 100000, ticks = 60;
+        const float dt = 1.0f / 60.0f;
+        for (double fraction : {0.0, 0.001, 0.01, 0.1, 1.0}) {
+            const int opening = static_cast<int>(chestCount * fraction);
+
+            std::vector<LegacyChest> legacy(chestCount);
+            for (int i = 0; i < opening; ++i) {
+                legacy[i * (chestCount / std::max(opening, 1))].isOpen = true;
+                legacy[i * (chestCount / std::max(opening, 1))].isAnimating = true;
+                legacy[i * (chestCount / std::max(opening, 1))].targetLidOffsetY = 0.7f;
+            }
+            auto start = Clock::now();
+            for (int t = 0; t < ticks; ++t) {
+                for (auto& chest : legacy) chest.update(dt);
+            }
+            double legacySeconds = secondsSince(start);
+
+            AnimationSystem animations;
+            for (int i = 0; i < chestCount; ++i) {
+                animations.addChannel(0.0f, i);
+                animations.addChannel(0.0f);
+            }
+            for (int i = 0; i < opening; ++i) {
+                int chest = i * (chestCount / std::max(opening, 1));
+                animations.animateTo(2 * chest, 0.7f, 2.0f);
+                animations.animateTo(2 * chest + 1, 2.5f, 3.0f);
+            }
+            size_t initiallyActive = animations.activeCount();
+            start = Clock::now();
+            for (int t = 0; t < ticks; ++t) animations.update(dt);
+            double tweenSeconds = secondsSince(start);
+
+            std::cout << std::setw(10) << opening << std::setw(17) << initiallyActive
+                      << std::setw(21) << std::fixed << std::setprecision(2) << legacySeconds / ticks * 1e6
+                      << std::setw(20) << tweenSeconds / ticks * 1e6 << std::endl;
+        }
+    }
+    // Geração de labirintos: layout por algoritmo e geometria (paredes fundidas, blocos em paralelo)
+    void benchMazeGeneration()
+    {
+        std::cout << "=== GERAÇÃO DE LABIRINTOS (layout + geometria) ===" << std::endl;
+        std::cout << std::setw(12) << "algoritmo" << std::setw(12) << "células" << std::setw(14) << "layout (ms)"
+                  << std::setw(16) << "geometria (ms)" << std::setw(14) << "triângulos" << std::setw(10) << "becos" << std::endl;
+        for (int size : {100, 1000}) {
+            for (MazeAlgorithm algorithm : {MazeAlgorithm::Backtracker, MazeAlgorithm::Wilson, MazeAlgorithm::Kruskal}) {
+                auto start = Clock::now();
+                MazeLayout maze = generateMaze(size, size, algorithm, 7u);
+                double layoutSeconds = secondsSince(start);
+
+                MazeGeometry geometry;
+                start = Clock::now();
+                buildMazeGeometry(maze, 2.0f, geometry, 16, &JobSystem::shared());
+                double geometrySeconds = secondsSince(start);
+
+                size_t triangles = 0;
+                for (const auto& block : geometry.wallBlocks) triangles += block.size() / 3;
+                // Becos sem saída: células com três paredes (inclui as bordas do labirinto)
+                size_t deadEnds = 0;
+                for (int z = 0; z < size; ++z) {
+                    for (int x = 0; x < size; ++x) {
+                        int walls = (maze.wallEast(x, z) ? 1 : 0) + (maze.wallSouth(x, z) ? 1 : 0)
+                                  + (x == 0 || maze.wallEast(x - 1, z) ? 1 : 0) + (z == 0 || maze.wallSouth(x, z - 1) ? 1 : 0);
+                        deadEnds += walls == 3 ? 1 : 0;
+                    }
+                }
+                std::cout << std::setw(12) << mazeAlgorithmName(algorithm) << std::setw(12) << size * size
+                          << std::setw(14) << std::fixed << std::setprecision(1) << layoutSeconds * 1e3
+                          << std::setw(16) << geometrySeconds * 1e3 << std::setw(14) << triangles << std::setw(10) << deadEnds << std::endl;
+            }
+        }
+    }
+    // Streaming: o jogador atravessa um labirinto enorme a 60 ticks/s reais; a
+    // memória residente fica presa ao orçamento, não ao tamanho do labirinto
+    void benchStreaming()
+    {
+        std::cout << "=== STREAMING DE CHUNKS (labirinto 2000x2000, jogador a 50 m/s) ===" << std::endl;
+        const int size = 2000;
+        auto start = Clock::now();
+        auto maze = std::make_shared<MazeLayout>(generateMaze(size, size, MazeAlgorithm::Kruskal, 3u));
+        std::cout << "layout: " << std::fixed << std::setprecision(0) << secondsSince(start) * 1e3 << " ms, "
+                  << maze->walls.size() / (1 << 20) << " MB" << std::endl;
+
+        // Estimativa do mundo inteiro montado de uma vez, por amostragem de chunks
+        WorldStreamer::Settings settings;
+        size_t sampleBytes = 0;
+        double buildSeconds = 0.0;
+        for (int i = 0; i < 16; ++i) {
+            start = Clock::now();
+            sampleBytes += WorldStreamer::buildChunk(*maze, settings, glm::ivec2(i * 7, i * 5))->memoryBytes;
+            buildSeconds += secondsSince(start);
+        }
+        const size_t chunksPerSide = (size + settings.chunkCells - 1) / settings.chunkCells;
+        std::cout << "chunk: " << std::setprecision(2) << buildSeconds / 16 * 1e3 << " ms, " << sampleBytes / 16 / 1024
+                  << " KB; mundo inteiro: ~" << sampleBytes / 16 * chunksPerSide * chunksPerSide / (1 << 20) << " MB" << std::endl;
+
+        std::cout << std::setw(14) << "orçamento" << std::setw(12) << "pico (MB)" << std::setw(10) << "cargas" << std::setw(10) << "despejos"
+                  << std::setw(12) << "esperas" << std::setw(14) << "update (us)" << std::setw(12) << "máx (us)" << std::endl;
+        const float speed = 50.0f, dt = 1.0f / 60.0f;
+        const int ticks = 360;
+        for (size_t budgetMB : {8, 32}) {
+            settings.memoryBudget = budgetMB << 20;
+            WorldStreamer streamer;
+            streamer.start(maze, settings);
+            glm::vec3 pos(5.0f, 1.5f, 5.0f);
+            streamer.waitFor(pos);
+
+            size_t peak = 0, stalls = 0;
+            double total = 0.0, worst = 0.0;
+            auto next = Clock::now();
+            for (int t = 0; t < ticks; ++t) {
+                start = Clock::now();
+                streamer.update(pos);
+                double seconds = secondsSince(start);
+                total += seconds;
+                worst = std::max(worst, seconds);
+                peak = std::max(peak, streamer.residentBytes());
+                // Diagonal com zigue-zague: entra em chunks novos e volta a antigos
+                const glm::vec3 step = glm::vec3(1.0f, 0.0f, (t / 60) % 2 ? -0.4f : 1.0f) * (speed * dt);
+                if (streamer.isResident(pos + step - 0.4f, pos + step + 0.4f)) pos += step;
+                else ++stalls;   // O jogo segura o jogador até o chunk chegar
+                next += std::chrono::microseconds(16667);
+                std::this_thread::sleep_until(next);
+            }
+            std::cout << std::setw(11) << budgetMB << " MB" << std::setw(12) << std::setprecision(1) << peak / double(1 << 20)
+                      << std::setw(10) << streamer.chunkLoads() << std::setw(10) << streamer.chunkEvictions() << std::setw(12) << stalls
+                      << std::setw(14) << std::setprecision(2) << total / ticks * 1e6 << std::setw(12) << worst * 1e6 << std::endl;
+        }
+    }
+    // Memória de GPU: malhas únicas por bloco (posição + normal por vértice)
+    // contra o kit de peças, com instâncias só da janela em volta da câmera
+    void benchTileKit()
+    {
+        std::cout << "=== KIT DE PEÇAS x MALHAS ÚNICAS (memória de GPU) ===" << std::endl;
+        const float cellSize = 2.0f, viewDistance = 100.0f;
+        const size_t vertexBytes = 6 * sizeof(float);
+        const int side = tileWindowSide(cellSize, viewDistance);
+        size_t kitMeshBytes = 0, kitWindowBytes = 0;
+        for (int kind = 0; kind < TILE_KIND_COUNT; ++kind) {
+            std::vector<glm::vec3> triangles;
+            buildTileMesh(static_cast<TileKind>(kind), cellSize, triangles);
+            kitMeshBytes += triangles.size() * vertexBytes;
+            kitWindowBytes += tileCapacity(static_cast<TileKind>(kind), side) * sizeof(TileInstance);
+        }
+        std::cout << "peças: " << kitMeshBytes << " B de malha; janela " << side << "x" << side << " células" << std::endl;
+        std::cout << std::setw(10) << "labirinto" << std::setw(16) << "únicas (MB)" << std::setw(18) << "instâncias (MB)"
+                  << std::setw(14) << "janela (KB)" << std::setw(14) << "recarga (ms)" << std::endl;
+        for (int size : {100, 250, 500, 1000, 2000}) {
+            MazeLayout maze = generateMaze(size, size, MazeAlgorithm::Backtracker, 11u);
+            MazeGeometry geometry;
+            buildMazeGeometry(maze, cellSize, geometry, 16, &JobSystem::shared());
+            size_t uniqueBytes = 0;
+            for (size_t b = 0; b < geometry.wallBlocks.size(); ++b)
+                uniqueBytes += (geometry.wallBlocks[b].size() + geometry.floorBlocks[b].size()) * vertexBytes;
+
+            // Todas as instâncias do labirinto de uma vez (sem janela), só para referência
+            TileWindow all;
+            gatherTiles(maze, glm::ivec2(0), glm::ivec2(size), all);
+            size_t allBytes = 0;
+            for (const auto& list : all.instances) allBytes += list.size() * sizeof(TileInstance);
+
+            // Recarga da janela quando a câmera muda de bloco
+            TileWindow window;
+            auto start = Clock::now();
+            const int refills = 20;
+            for (int i = 0; i < refills; ++i) {
+                const glm::ivec2 first(size / 2 - side / 2 + i * TILE_WINDOW_SNAP, size / 2 - side / 2);
+                gatherTiles(maze, first, first + side, window);
+            }
+            double refillSeconds = secondsSince(start) / refills;
+
+            std::cout << std::setw(10) << size << std::setw(16) << std::fixed << std::setprecision(1) << (uniqueBytes) / double(1 << 20)
+                      << std::setw(18) << (kitMeshBytes + allBytes) / double(1 << 20)
+                      << std::setw(14) << (kitMeshBytes + kitWindowBytes) / 1024.0
+                      << std::setw(14) << std::setprecision(2) << refillSeconds * 1e3 << std::endl;
+        }
+    }
+
+    // Lightmap: desdobramento, atlas e path tracing da geometria de labirintos
+    // gerados, e a faixa de luz resultante (sol direto + céu e quiques); a
+    // oclusão ambiente assada no mesmo atlas, para comparar o custo
+    void benchLightmap()
+    {
+        std::cout << "=== LIGHTMAP (path tracing na CPU, " << JobSystem::shared().threadCount() << " threads) ===" << std::endl;
+        LightmapSettings settings;
+        OcclusionSettings occlusionSettings;
+        std::cout << settings.samples << " caminhos x " << settings.bounces << " quiques por texel, "
+                  << settings.texelsPerMeter << " texels/m; oclusão: " << occlusionSettings.samples << " raios de "
+                  << occlusionSettings.radius << " m" << std::endl;
+        std::cout << std::setw(10) << "labirinto" << std::setw(12) << "triângulos" << std::setw(10) << "cartas"
+                  << std::setw(12) << "atlas" << std::setw(16) << "desdobrar (ms)" << std::setw(12) << "assar (ms)"
+                  << std::setw(14) << "texels/s" << std::setw(12) << "atlas (KB)" << std::setw(16) << "luz mín/máx"
+                  << std::setw(14) << "oclusão (ms)" << std::setw(10) << "AO médio" << std::endl;
+        for (int size : {8, 16, 32}) {
+            MazeGeometry geometry;
+            buildMazeGeometry(generateMaze(size, size, MazeAlgorithm::Backtracker, 5u), 2.0f, geometry);
+            std::vector<glm::vec3> triangles; // Na ordem dos colliders do jogo: paredes e piso de cada bloco
+            for (size_t b = 0; b < geometry.wallBlocks.size(); ++b) {
+                triangles.insert(triangles.end(), geometry.wallBlocks[b].begin(), geometry.wallBlocks[b].end());
+                triangles.insert(triangles.end(), geometry.floorBlocks[b].begin(), geometry.floorBlocks[b].end());
+            }
+            MeshBVH occluders;
+            occluders.build(triangles);
+
+            Lightmap lightmap;
+            auto start = Clock::now();
+            if (!lightmap.unwrap(triangles, settings)) {
+                std::cout << std::setw(10) << size << "  atlas maior que " << settings.maxAtlasSize << "x" << settings.maxAtlasSize << std::endl;
+                continue;
+            }
+            double unwrapSeconds = secondsSince(start);
+            start = Clock::now();
+            lightmap.bake(occluders, settings, &JobSystem::shared());
+            double bakeSeconds = secondsSince(start);
+
+            size_t used = 0;
+            float lo = 1e9f, hi = 0.0f;
+            const std::vector<uint8_t>& texels = lightmap.texels();
+            for (size_t i = 0; i < texels.size(); i += 4) {
+                if (texels[i + 3] == 0) continue;  // Texel fora das cartas
+                ++used;
+                const float light = std::max(texels[i], std::max(texels[i + 1], texels[i + 2])) / 255.0f * texels[i + 3] / 255.0f * Lightmap::RGBM_RANGE;
+                lo = std::min(lo, light);
+                hi = std::max(hi, light);
+            }
+            std::cout << std::setw(10) << size << std::setw(12) << triangles.size() / 3 << std::setw(10) << lightmap.chartCount()
+                      << std::setw(12) << (std::to_string(lightmap.width()) + "x" + std::to_string(lightmap.height()))
+                      << std::setw(16) << std::fixed << std::setprecision(2) << unwrapSeconds * 1e3
+                      << std::setw(12) << std::setprecision(0) << bakeSeconds * 1e3
+                      << std::setw(14) << used / bakeSeconds << std::setw(12) << texels.size() / 1024
+                      << std::setw(9) << std::setprecision(2) << lo << "/" << hi;
+
+            AmbientOcclusion occlusion;
+            start = Clock::now();
+            occlusion.bake(lightmap, occluders, occlusionSettings, &JobSystem::shared());
+            double occlusionSeconds = secondsSince(start);
+            double openSum = 0.0;
+            for (size_t y = 0; y < static_cast<size_t>(occlusion.height()); ++y) {
+                for (int x = 0; x < occlusion.width(); ++x) {
+                    glm::vec3 p, n;
+                    if (lightmap.texelSurface(x, static_cast<int>(y), p, n)) openSum += occlusion.texels()[y * occlusion.width() + x] / 255.0;
+                }
+            }
+            std::cout << std::setw(14) << std::setprecision(0) << occlusionSeconds * 1e3
+                      << std::setw(10) << std::setprecision(2) << openSum / used << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // Sem argumentos roda tudo; com nomes (ex.: "crowd"), só os pedidos
+    const std::pair<const char*, void (*)()> benches[] = {
+        {"collision", benchCollision}, {"sdf", benchDistanceField}, {"query", benchSceneQuery},
+        {"animation", benchAnimation}, {"paths", benchPathfinding}, {"guidance", benchGuidance},
+        {"flow", benchCrowdFlow}, {"crowd", benchCrowd}, {"maze", benchMazeGeneration},
+        {"stream", benchStreaming}, {"tiles", benchTileKit}, {"lightmap", benchLightmap},
+    };
+    for (const auto& bench : benches) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) selected |= std::string(argv[i]) == bench.first;
+        if (selected) bench.second();
+    }
+    return failedChecks ? 1 : 0;
+}
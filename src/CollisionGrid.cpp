@@ -0,0 +1,124 @@
+#include "CollisionGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#if defined(__SSE2__) || defined(_M_X64)
+#define COLLISION_GRID_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Limita a grade para que mapas muito grandes não gerem milhões de células vazias
+    const int MAX_CELLS_PER_AXIS = 1024;
+}
+
+void CollisionGrid::clear()
+{
+    cellsX = cellsZ = 0;
+    numColliders = 0;
+    cellStart.clear();
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    ids.clear();
+}
+
+int CollisionGrid::cellIndexX(float x) const
+{
+    return std::clamp(static_cast<int>(std::floor((x - origin.x) * invCellSize)), 0, cellsX - 1);
+}
+
+int CollisionGrid::cellIndexZ(float z) const
+{
+    return std::clamp(static_cast<int>(std::floor((z - origin.y) * invCellSize)), 0, cellsZ - 1);
+}
+
+void CollisionGrid::build(const std::vector<glm::vec3>& boxMin, const std::vector<glm::vec3>& boxMax, float size)
+{
+    clear();
+    numColliders = boxMin.size();
+    if (numColliders == 0) return;
+
+    glm::vec2 lo(std::numeric_limits<float>::max());
+    glm::vec2 hi(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < numColliders; ++i) {
+        lo = glm::min(lo, glm::vec2(boxMin[i].x, boxMin[i].z));
+        hi = glm::max(hi, glm::vec2(boxMax[i].x, boxMax[i].z));
+    }
+    glm::vec2 extent = hi - lo;
+    cellSize = std::max({size, extent.x / MAX_CELLS_PER_AXIS, extent.y / MAX_CELLS_PER_AXIS});
+    invCellSize = 1.0f / cellSize;
+    origin = lo;
+    cellsX = std::max(1, static_cast<int>(std::ceil(extent.x * invCellSize)));
+    cellsZ = std::max(1, static_cast<int>(std::ceil(extent.y * invCellSize)));
+
+    // 1ª passada: conta quantas caixas tocam cada célula
+    std::vector<unsigned int> counts(static_cast<size_t>(cellsX) * cellsZ + 1, 0);
+    for (size_t i = 0; i < numColliders; ++i) {
+        for (int z = cellIndexZ(boxMin[i].z); z <= cellIndexZ(boxMax[i].z); ++z)
+            for (int x = cellIndexX(boxMin[i].x); x <= cellIndexX(boxMax[i].x); ++x)
+                counts[static_cast<size_t>(z) * cellsX + x]++;
+    }
+
+    // Soma de prefixos -> início de cada célula
+    cellStart.assign(counts.size(), 0);
+    for (size_t c = 1; c < counts.size(); ++c) cellStart[c] = cellStart[c - 1] + counts[c - 1];
+    size_t total = cellStart.back();
+    minX.resize(total); minY.resize(total); minZ.resize(total);
+    maxX.resize(total); maxY.resize(total); maxZ.resize(total);
+    ids.resize(total);
+
+    // 2ª passada: copia as caixas para os arrays de cada célula
+    std::vector<unsigned int> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < numColliders; ++i) {
+        for (int z = cellIndexZ(boxMin[i].z); z <= cellIndexZ(boxMax[i].z); ++z) {
+            for (int x = cellIndexX(boxMin[i].x); x <= cellIndexX(boxMax[i].x); ++x) {
+                unsigned int e = cursor[static_cast<size_t>(z) * cellsX + x]++;
+                minX[e] = boxMin[i].x; minY[e] = boxMin[i].y; minZ[e] = boxMin[i].z;
+                maxX[e] = boxMax[i].x; maxY[e] = boxMax[i].y; maxZ[e] = boxMax[i].z;
+                ids[e] = static_cast<unsigned int>(i);
+            }
+        }
+    }
+}
+
+void CollisionGrid::gatherRange(size_t begin, size_t end, const glm::vec3& lo, const glm::vec3& hi, std::vector<unsigned int>& out) const
+{
+    size_t i = begin;
+#ifdef COLLISION_GRID_SSE2
+    // Testa 4 caixas por instrução: (lo.x <= maxX) & (hi.x >= minX) & ... nos três eixos
+    const __m128 loX = _mm_set1_ps(lo.x), loY = _mm_set1_ps(lo.y), loZ = _mm_set1_ps(lo.z);
+    const __m128 hiX = _mm_set1_ps(hi.x), hiY = _mm_set1_ps(hi.y), hiZ = _mm_set1_ps(hi.z);
+    for (; i + 4 <= end; i += 4) {
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(loX, _mm_loadu_ps(&maxX[i])), _mm_cmpge_ps(hiX, _mm_loadu_ps(&minX[i])));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(loY, _mm_loadu_ps(&maxY[i])), _mm_cmpge_ps(hiY, _mm_loadu_ps(&minY[i]))));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmple_ps(loZ, _mm_loadu_ps(&maxZ[i])), _mm_cmpge_ps(hiZ, _mm_loadu_ps(&minZ[i]))));
+        const int mask = _mm_movemask_ps(hit);
+        if (mask == 0) continue;
+        for (int lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) out.push_back(ids[i + lane]);
+        }
+    }
+#endif
+    // Caixas restantes (menos de 4) no caminho escalar
+    for (; i < end; ++i) {
+        if (lo.x <= maxX[i] && hi.x >= minX[i] && lo.y <= maxY[i] && hi.y >= minY[i] && lo.z <= maxZ[i] && hi.z >= minZ[i])
+            out.push_back(ids[i]);
+    }
+}
+
+void CollisionGrid::gather(const glm::vec3& lo, const glm::vec3& hi, std::vector<unsigned int>& out) const
+{
+    out.clear();
+    if (cellsX == 0) return;
+    if (hi.x < origin.x || hi.z < origin.y || lo.x > origin.x + cellsX * cellSize || lo.z > origin.y + cellsZ * cellSize) return;
+
+    for (int z = cellIndexZ(lo.z); z <= cellIndexZ(hi.z); ++z) {
+        for (int x = cellIndexX(lo.x); x <= cellIndexX(hi.x); ++x) {
+            size_t c = static_cast<size_t>(z) * cellsX + x;
+            gatherRange(cellStart[c], cellStart[c + 1], lo, hi, out);
+        }
+    }
+    // Caixas que cobrem várias células aparecem repetidas
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// ============================================================================
+// GRADE UNIFORME PARA COLISÃO COM PAREDES
+// ============================================================================
+// As AABBs dos colisores são distribuídas numa grade 2D sobre o plano XZ. Cada
+// célula guarda cópias das caixas que a tocam em arrays contíguos (SoA), de modo
+// que uma consulta visita apenas as células vizinhas e testa 4 caixas por vez
+// com SSE2 antes de devolver os candidatos à fase estreita.
+class CollisionGrid
+{
+public:
+    // Constrói a grade a partir de caixas [min, max]; cellSize em unidades do mundo
+    void build(const std::vector<glm::vec3>& boxMin, const std::vector<glm::vec3>& boxMax, float cellSize = 4.0f);
+    void clear();
+
+    // Índices (ordem de `build`) das caixas que tocam [lo, hi], sem repetição
+    void gather(const glm::vec3& lo, const glm::vec3& hi, std::vector<unsigned int>& out) const;
+
+    size_t colliderCount() const { return numColliders; }
+    size_t entryCount() const { return minX.size(); }
+
+private:
+    int cellIndexX(float x) const;
+    int cellIndexZ(float z) const;
+    // Caixas de [begin, end) que tocam [lo, hi], acrescentadas a `out`
+    void gatherRange(size_t begin, size_t end, const glm::vec3& lo, const glm::vec3& hi, std::vector<unsigned int>& out) const;
+
+    glm::vec2 origin = glm::vec2(0.0f);    // Canto mínimo da grade (x, z)
+    float cellSize = 4.0f;
+    float invCellSize = 0.25f;
+    int cellsX = 0, cellsZ = 0;
+    size_t numColliders = 0;
+
+    // Formato CSR: as entradas da célula c ficam em [cellStart[c], cellStart[c + 1])
+    std::vector<unsigned int> cellStart;
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    std::vector<unsigned int> ids;          // Caixa original de cada entrada
+};
@@ -0,0 +1,104 @@
+#include "CollisionWorld.h"
+#include "DistanceField.h"
+#include <algorithm>
+
+namespace {
+    // Candidatos da fase ampla; um buffer por thread evita alocação por consulta
+    thread_local std::vector<unsigned int> candidates;
+}
+
+void CollisionWorld::clear()
+{
+    meshes.clear();
+    grid.clear();
+}
+
+unsigned int CollisionWorld::addMesh(const std::vector<glm::vec3>& positions)
+{
+    auto mesh = std::make_shared<MeshBVH>();
+    mesh->build(positions);
+    return addMesh(std::move(mesh));
+}
+
+unsigned int CollisionWorld::addMesh(std::shared_ptr<const MeshBVH> mesh)
+{
+    meshes.push_back(std::move(mesh));
+    return static_cast<unsigned int>(meshes.size() - 1);
+}
+
+void CollisionWorld::build(float cellSize)
+{
+    std::vector<glm::vec3> boundsMin, boundsMax;
+    boundsMin.reserve(meshes.size());
+    boundsMax.reserve(meshes.size());
+    for (const auto& mesh : meshes) {
+        boundsMin.push_back(mesh->boundsMin());
+        boundsMax.push_back(mesh->boundsMax());
+    }
+    grid.build(boundsMin, boundsMax, cellSize);
+}
+
+bool CollisionWorld::sweep(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit) const
+{
+    QueryBudget budget;
+    budget.maxTriangleTests = triangleBudget;
+    return sweep(start, delta, radius, hit, budget);
+}
+
+bool CollisionWorld::sweep(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit, QueryBudget& budget) const
+{
+    glm::vec3 end = start + delta;
+    grid.gather(glm::min(start, end) - glm::vec3(radius), glm::max(start, end) + glm::vec3(radius), candidates);
+    if (candidates.size() > static_cast<size_t>(candidateBudget)) {
+        hit.truncated = true;
+        return false;
+    }
+    bool found = false;
+    for (unsigned int index : candidates) {
+        found |= meshes[index]->sweepSphere(start, delta, radius, hit, budget);
+        if (hit.truncated || hit.t <= 0.0f) break;
+    }
+    return found;
+}
+
+bool CollisionWorld::raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance) const
+{
+    glm::vec3 end = origin + dir * distance;
+    grid.gather(glm::min(origin, end), glm::max(origin, end), candidates);
+    bool found = false;
+    for (unsigned int index : candidates) found |= meshes[index]->raycast(origin, dir, distance);
+    return found;
+}
+
+glm::vec3 CollisionWorld::slide(const glm::vec3& start, const glm::vec3& delta, float radius, int maxIterations) const
+{
+    const float skin = 0.001f; // Folga para não terminar exatamente sobre a superfície
+    glm::vec3 pos = start;
+    glm::vec3 move = delta;
+    const float requested = glm::length(move);
+    if (requested > MAX_SWEEP_LENGTH) move *= MAX_SWEEP_LENGTH / requested;
+    QueryBudget budget;
+    budget.maxTriangleTests = triangleBudget;
+    for (int i = 0; i < maxIterations; ++i) {
+        float length = glm::length(move);
+        if (length < 1e-6f) break;
+        SweepHit hit;
+        bool found = sweep(pos, move, radius, hit, budget);
+        if (hit.truncated) {
+            // Contato incompleto: avançar pela varredura poderia atravessar a
+            // parede. O campo de distância move em passos de uma célula
+            overruns.fetch_add(1, std::memory_order_relaxed);
+            if (!fallbackField || fallbackField->empty() || !fallbackField->contains(glm::vec2(pos.x, pos.z))) return pos;
+            glm::vec3 moved = fallbackField->move(pos, move, radius);
+            return glm::vec3(moved.x, pos.y, moved.z);
+        }
+        if (!found) { pos += move; break; }
+
+        // Avança até o contato e projeta o restante no plano tangente
+        float travel = std::max(length * hit.t - skin, 0.0f);
+        pos += move * (travel / length);
+        glm::vec3 remaining = move * (1.0f - hit.t);
+        move = remaining - hit.normal * glm::dot(remaining, hit.normal);
+    }
+    return pos;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "CollisionGrid.h"
+#include "MeshBVH.h"
+
+class DistanceField;
+
+// ============================================================================
+// MUNDO DE COLISÃO
+// ============================================================================
+// Junta a grade uniforme (fase ampla, sobre as AABBs de cada malha) com uma BVH
+// de triângulos por malha (fase estreita). Não depende de OpenGL, para poder
+// ser usado também pelo executável de benchmark.
+//
+// Cada consulta tem custo limitado: o deslocamento é encurtado a
+// MAX_SWEEP_LENGTH, a fase ampla aceita no máximo `candidateBudget` malhas e a
+// estreita no máximo `triangleBudget` testes. Estourado o limite, o contato não
+// é confiável e slide() move pelo campo de distância (se houver) ou não move.
+class CollisionWorld
+{
+public:
+    void clear();
+
+    // Adiciona uma malha estática; `positions` tem 3 vértices por triângulo no mundo
+    unsigned int addMesh(const std::vector<glm::vec3>& positions);
+    // Reaproveita uma BVH já montada (ex.: por um chunk carregado em segundo plano)
+    unsigned int addMesh(std::shared_ptr<const MeshBVH> mesh);
+
+    // Monta a fase ampla depois que todas as malhas foram adicionadas
+    void build(float cellSize = 4.0f);
+
+    bool sweep(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit) const;
+    // Raio contra os triângulos; reduz `distance` se acertar antes dela
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance) const;
+
+    // Move a esfera deslizando pelas superfícies atingidas ("collide and slide")
+    glm::vec3 slide(const glm::vec3& start, const glm::vec3& delta, float radius, int maxIterations = 3) const;
+
+    // Limites por consulta (um slide inteiro, com todas as iterações)
+    void setTriangleBudget(int maxTriangleTests) { triangleBudget = maxTriangleTests; }
+    void setCandidateBudget(int maxCandidates) { candidateBudget = maxCandidates; }
+    // Campo usado quando o orçamento estoura; deve sobreviver a este objeto
+    void setFallbackField(const DistanceField* field) { fallbackField = field; }
+    // Consultas que estouraram o orçamento desde a criação
+    size_t budgetOverruns() const { return overruns.load(std::memory_order_relaxed); }
+
+    static constexpr float MAX_SWEEP_LENGTH = 1.0f;   // Um tick anda ~0,08 m
+
+    size_t meshCount() const { return meshes.size(); }
+    const MeshBVH& mesh(unsigned int index) const { return *meshes[index]; }
+    const CollisionGrid& broadphase() const { return grid; }
+
+private:
+    bool sweep(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit, QueryBudget& budget) const;
+
+    std::vector<std::shared_ptr<const MeshBVH>> meshes; // Compartilhadas: imutáveis depois de montadas
+    CollisionGrid grid;
+    int triangleBudget = 512;
+    int candidateBudget = 32;
+    const DistanceField* fallbackField = nullptr;
+    mutable std::atomic<size_t> overruns{0};
+};
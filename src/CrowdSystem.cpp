@@ -0,0 +1,225 @@
+#include "CrowdSystem.h"
+#include "JobSystem.h"
+#include "DistanceField.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int MAX_NEIGHBORS = 16;
+
+    float det(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+}
+
+int CrowdSystem::addAgent(const glm::vec2& position, int goal)
+{
+    positionX.push_back(position.x);
+    positionZ.push_back(position.y);
+    velocityX.push_back(0.0f);
+    velocityZ.push_back(0.0f);
+    preferredX.push_back(0.0f);
+    preferredZ.push_back(0.0f);
+    nextVelocityX.push_back(0.0f);
+    nextVelocityZ.push_back(0.0f);
+    goals.push_back(goal);
+    return static_cast<int>(positionX.size()) - 1;
+}
+
+void CrowdSystem::clear()
+{
+    positionX.clear();
+    positionZ.clear();
+    velocityX.clear();
+    velocityZ.clear();
+    preferredX.clear();
+    preferredZ.clear();
+    nextVelocityX.clear();
+    nextVelocityZ.clear();
+    goals.clear();
+}
+
+void CrowdSystem::setGoalCount(int count)
+{
+    goalFields.resize(count);
+}
+
+void CrowdSystem::setGoalField(int goal, std::shared_ptr<const FlowField> field)
+{
+    goalFields[goal] = std::move(field);
+}
+
+void CrowdSystem::update(float dt, const NavGrid& grid, const DistanceField* walls, JobSystem* jobs)
+{
+    const size_t count = positionX.size();
+    if (count == 0 || grid.empty() || dt <= 0.0f) return;
+    auto run = [&](const std::function<void(size_t, size_t)>& body) {
+        if (jobs) jobs->parallelFor(count, 1024, body);
+        else body(0, count);
+    };
+    run([&](size_t begin, size_t end) { preferVelocities(begin, end, dt, grid); });
+    neighbors.build(positionX.data(), positionZ.data(), count, neighborDistance, jobs);
+    run([&](size_t begin, size_t end) { avoid(begin, end, dt); });
+    run([&](size_t begin, size_t end) { integrate(begin, end, dt, grid, walls); });
+}
+
+void CrowdSystem::preferVelocities(size_t begin, size_t end, float dt, const NavGrid& grid)
+{
+    const int goalTotal = static_cast<int>(goalFields.size());
+    const glm::vec2 origin = grid.origin();
+    const float inverseCell = 1.0f / grid.cellSize();
+
+    // Direção desejada: uma leitura no campo do objetivo
+    for (size_t i = begin; i < end; ++i) {
+        const FlowField* field = goals[i] < goalTotal ? goalFields[goals[i]].get() : nullptr;
+        glm::vec2 direction(0.0f);
+        if (field) {
+            const glm::ivec2 c(static_cast<int>(std::floor((positionX[i] - origin.x) * inverseCell)),
+                               static_cast<int>(std::floor((positionZ[i] - origin.y) * inverseCell)));
+            if (c.x >= 0 && c.y >= 0 && c.x < field->width() && c.y < field->height()) {
+                const uint8_t code = field->directionCodes()[static_cast<size_t>(c.y) * field->width() + c.x];
+                direction = FlowField::directionVector(code);
+                // Sem direção numa célula livre: chegou (ou não há caminho); vai para outro objetivo
+                if (code == FlowField::NO_DIRECTION && grid.walkable(c) && goalTotal > 1)
+                    goals[i] = (goals[i] + 1 + static_cast<int>(i % (goalTotal - 1))) % goalTotal;
+            }
+        }
+        preferredX[i] = direction.x * maxSpeed;
+        preferredZ[i] = direction.y * maxSpeed;
+    }
+
+    // Steering: aproxima a velocidade da desejada com aceleração limitada
+    // (aritmética pura sobre os arrays, vetorizável)
+    const float maxDelta = acceleration * dt;
+    const float* vx = velocityX.data();
+    const float* vz = velocityZ.data();
+    float* px = preferredX.data();
+    float* pz = preferredZ.data();
+    for (size_t i = begin; i < end; ++i) {
+        const float ex = px[i] - vx[i], ez = pz[i] - vz[i];
+        const float scale = std::min(1.0f, maxDelta / std::sqrt(ex * ex + ez * ez + 1e-12f));
+        px[i] = vx[i] + ex * scale;
+        pz[i] = vz[i] + ez * scale;
+    }
+}
+
+void CrowdSystem::avoid(size_t begin, size_t end, float dt)
+{
+    struct Line {
+        glm::vec2 point, direction;    // Permitido: à esquerda de `direction`
+    };
+    const int neighborLimit = std::min(maxNeighbors, MAX_NEIGHBORS);
+    const float rangeSq = neighborDistance * neighborDistance;
+    const float combinedRadius = 2.0f * radius, combinedRadiusSq = combinedRadius * combinedRadius;
+    const float invTimeHorizon = 1.0f / timeHorizon, invTimeStep = 1.0f / dt;
+
+    for (size_t i = begin; i < end; ++i) {
+        const glm::vec2 position(positionX[i], positionZ[i]);
+        const glm::vec2 velocity(velocityX[i], velocityZ[i]);
+
+        // Os k vizinhos mais próximos, em ordem de (distância, índice): o
+        // resultado não depende da ordem em que o hash os devolve
+        std::pair<float, int> nearest[MAX_NEIGHBORS];
+        int found = 0;
+        neighbors.query(position.x, position.y, neighborDistance, [&](int j) {
+            if (j == static_cast<int>(i)) return;
+            const float dx = positionX[j] - position.x, dz = positionZ[j] - position.y;
+            const std::pair<float, int> candidate(dx * dx + dz * dz, j);
+            if (candidate.first > rangeSq || (found == neighborLimit && !(candidate < nearest[found - 1]))) return;
+            for (int k = 0; k < found; ++k) {
+                if (nearest[k].second == j) return;   // Duas células na mesma chave do hash
+            }
+            int slot = found < neighborLimit ? found++ : found - 1;
+            while (slot > 0 && candidate < nearest[slot - 1]) { nearest[slot] = nearest[slot - 1]; --slot; }
+            nearest[slot] = candidate;
+        });
+
+        // Um semiplano ORCA por vizinho; cada agente assume metade do desvio
+        Line lines[MAX_NEIGHBORS];
+        for (int n = 0; n < found; ++n) {
+            const int j = nearest[n].second;
+            const glm::vec2 relativePosition(positionX[j] - position.x, positionZ[j] - position.y);
+            const glm::vec2 relativeVelocity = velocity - glm::vec2(velocityX[j], velocityZ[j]);
+            const float distSq = nearest[n].first;
+            glm::vec2 u;
+            Line& line = lines[n];
+            if (distSq > combinedRadiusSq) {
+                const glm::vec2 w = relativeVelocity - invTimeHorizon * relativePosition;
+                const float wLengthSq = glm::dot(w, w);
+                const float dotProduct = glm::dot(w, relativePosition);
+                if (dotProduct < 0.0f && dotProduct * dotProduct > combinedRadiusSq * wLengthSq) {
+                    // Mais perto do círculo de corte do cone
+                    const float wLength = std::sqrt(wLengthSq);
+                    const glm::vec2 unitW = w / wLength;
+                    line.direction = glm::vec2(unitW.y, -unitW.x);
+                    u = (combinedRadius * invTimeHorizon - wLength) * unitW;
+                } else {
+                    // Mais perto de uma das pernas do cone
+                    const float leg = std::sqrt(distSq - combinedRadiusSq);
+                    if (det(relativePosition, w) > 0.0f) {
+                        line.direction = glm::vec2(relativePosition.x * leg - relativePosition.y * combinedRadius,
+                                                   relativePosition.x * combinedRadius + relativePosition.y * leg) / distSq;
+                    } else {
+                        line.direction = -glm::vec2(relativePosition.x * leg + relativePosition.y * combinedRadius,
+                                                    -relativePosition.x * combinedRadius + relativePosition.y * leg) / distSq;
+                    }
+                    u = glm::dot(relativeVelocity, line.direction) * line.direction - relativeVelocity;
+                }
+            } else {
+                // Já se sobrepõem: separa dentro deste passo
+                const glm::vec2 w = relativeVelocity - invTimeStep * relativePosition;
+                const float wLength = std::max(std::sqrt(glm::dot(w, w)), 1e-6f);
+                const glm::vec2 unitW = w / wLength;
+                line.direction = glm::vec2(unitW.y, -unitW.x);
+                u = (combinedRadius * invTimeStep - wLength) * unitW;
+            }
+            line.point = velocity + 0.5f * u;
+        }
+
+        // Programa linear aproximado: projeta a velocidade preferida em cada
+        // semiplano violado (duas passadas), limitada à velocidade máxima
+        glm::vec2 result(preferredX[i], preferredZ[i]);
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int n = 0; n < found; ++n) {
+                const Line& line = lines[n];
+                if (det(line.direction, line.point - result) > 0.0f)
+                    result = line.point + line.direction * glm::dot(line.direction, result - line.point);
+            }
+        }
+        const float speedSq = glm::dot(result, result);
+        if (speedSq > maxSpeed * maxSpeed) result *= maxSpeed / std::sqrt(speedSq);
+        nextVelocityX[i] = result.x;
+        nextVelocityZ[i] = result.y;
+    }
+}
+
+void CrowdSystem::integrate(size_t begin, size_t end, float dt, const NavGrid& grid, const DistanceField* walls)
+{
+    const glm::vec2 origin = grid.origin();
+    const float inverseCell = 1.0f / grid.cellSize();
+    auto walkable = [&](float x, float z) {
+        return grid.walkable(static_cast<int>(std::floor((x - origin.x) * inverseCell)), static_cast<int>(std::floor((z - origin.y) * inverseCell)));
+    };
+    for (size_t i = begin; i < end; ++i) {
+        const float x = positionX[i], z = positionZ[i];
+        float vx = nextVelocityX[i], vz = nextVelocityZ[i];
+        if (walls) {
+            // Mesmo campo de distância do jogador; a velocidade passa a ser o
+            // deslocamento real (deslizando na parede)
+            const glm::vec3 moved = walls->move(glm::vec3(x, 0.0f, z), glm::vec3(vx, 0.0f, vz) * dt, radius);
+            vx = (moved.x - x) / dt;
+            vz = (moved.z - z) / dt;
+            positionX[i] = moved.x;
+            positionZ[i] = moved.z;
+        } else {
+            // Grade: um eixo bloqueado por célula não caminhável zera a velocidade nele
+            const bool free = walkable(x, z);
+            const float nx = x + vx * dt, nz = z + vz * dt;
+            if (!free || walkable(nx, z)) positionX[i] = nx;
+            else vx = 0.0f;
+            if (!free || walkable(positionX[i], nz)) positionZ[i] = nz;
+            else vz = 0.0f;
+        }
+        velocityX[i] = vx;
+        velocityZ[i] = vz;
+    }
+}
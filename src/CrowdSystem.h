@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "FlowField.h"
+#include "SpatialHash.h"
+
+class NavGrid;
+class DistanceField;
+class JobSystem;
+
+// ============================================================================
+// MULTIDÃO DE AGENTES (NPCs)
+// ============================================================================
+// Estado em arrays paralelos (SoA). Cada agente tem um objetivo, e cada
+// objetivo tem um campo de fluxo compartilhado por todos que o seguem: a
+// direção desejada é só uma leitura no campo. Um tick tem quatro fases, cada
+// uma em blocos no JobSystem:
+//   1. velocidade preferida: leitura do campo e steering com aceleração limitada;
+//   2. hash espacial das posições, refeito do zero;
+//   3. desvio recíproco (ORCA): cada vizinho próximo vira um semiplano de
+//      velocidades permitidas e a preferida é projetada neles;
+//   4. integração contra as paredes (campo de distância do jogador ou grade).
+// As fases 3 e 4 leem o estado do tick anterior e escrevem em buffers novos,
+// então os blocos nunca disputam dados.
+class CrowdSystem
+{
+public:
+    float maxSpeed = 2.5f;             // Unidades por segundo
+    float acceleration = 10.0f;        // Variação máxima de velocidade por segundo
+    float radius = 0.3f;               // Raio de cada agente
+    float neighborDistance = 2.0f;     // Alcance da busca de vizinhos
+    float timeHorizon = 1.5f;          // Antecedência do desvio (segundos)
+    int maxNeighbors = 8;              // Só os mais próximos entram no desvio
+
+    int addAgent(const glm::vec2& position, int goal);
+    void clear();
+
+    // Campo seguido por quem tem o objetivo `goal`; trocar o campo (alvo que se
+    // move) não mexe nos agentes
+    void setGoalCount(int count);
+    void setGoalField(int goal, std::shared_ptr<const FlowField> field);
+    int goalCount() const { return static_cast<int>(goalFields.size()); }
+
+    // Ao chegar no alvo, o agente passa para outro objetivo. Com `walls`, os
+    // agentes colidem com o mesmo campo de distância usado pelo jogador;
+    // sem ele, só com as células bloqueadas da grade.
+    void update(float dt, const NavGrid& grid, const DistanceField* walls = nullptr, JobSystem* jobs = nullptr);
+
+    size_t size() const { return positionX.size(); }
+    glm::vec2 position(int agent) const { return glm::vec2(positionX[agent], positionZ[agent]); }
+    glm::vec2 velocity(int agent) const { return glm::vec2(velocityX[agent], velocityZ[agent]); }
+    int goal(int agent) const { return goals[agent]; }
+    const std::vector<float>& positionsX() const { return positionX; }
+    const std::vector<float>& positionsZ() const { return positionZ; }
+
+private:
+    void preferVelocities(size_t begin, size_t end, float dt, const NavGrid& grid);
+    void avoid(size_t begin, size_t end, float dt);
+    void integrate(size_t begin, size_t end, float dt, const NavGrid& grid, const DistanceField* walls);
+
+    std::vector<float> positionX, positionZ;
+    std::vector<float> velocityX, velocityZ;
+    std::vector<float> preferredX, preferredZ;   // Rascunho da fase 1
+    std::vector<float> nextVelocityX, nextVelocityZ;
+    std::vector<int> goals;
+    std::vector<std::shared_ptr<const FlowField>> goalFields;
+    SpatialHash neighbors;
+};
@@ -0,0 +1,220 @@
+#include "DistanceField.h"
+#include "BakedScene.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+    const int MAX_CELLS_PER_AXIS = 4096;
+    const float FAR_AWAY = 1e20f;
+
+    // Transformada de distância exata 1D (Felzenszwalb & Huttenlocher): recebe o
+    // custo f de cada amostra e devolve a distância quadrática em d
+    void distanceTransform1D(const float* f, int n, float* d, int* v, float* z)
+    {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -FAR_AWAY;
+        z[1] = FAR_AWAY;
+        for (int q = 1; q < n; ++q) {
+            float s = ((f[q] + float(q) * q) - (f[v[k]] + float(v[k]) * v[k])) / (2.0f * q - 2.0f * v[k]);
+            while (s <= z[k]) {
+                --k;
+                s = ((f[q] + float(q) * q) - (f[v[k]] + float(v[k]) * v[k])) / (2.0f * q - 2.0f * v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = FAR_AWAY;
+        }
+        k = 0;
+        for (int q = 0; q < n; ++q) {
+            while (z[k + 1] < q) ++k;
+            d[q] = float(q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    }
+
+    // Transformada 2D separável: colunas e depois linhas, cada uma em paralelo
+    void distanceTransform2D(std::vector<float>& grid, int cols, int rows)
+    {
+        JobSystem& jobs = JobSystem::shared();
+        jobs.parallelFor(cols, 64, [&](size_t begin, size_t end) {
+            std::vector<float> f(rows), d(rows), z(rows + 1);
+            std::vector<int> v(rows);
+            for (size_t x = begin; x < end; ++x) {
+                for (int z2 = 0; z2 < rows; ++z2) f[z2] = grid[static_cast<size_t>(z2) * cols + x];
+                distanceTransform1D(f.data(), rows, d.data(), v.data(), z.data());
+                for (int z2 = 0; z2 < rows; ++z2) grid[static_cast<size_t>(z2) * cols + x] = d[z2];
+            }
+        });
+        jobs.parallelFor(rows, 64, [&](size_t begin, size_t end) {
+            std::vector<float> f(cols), z(cols + 1);
+            std::vector<int> v(cols);
+            for (size_t row = begin; row < end; ++row) {
+                float* line = &grid[row * cols];
+                std::copy(line, line + cols, f.begin());
+                distanceTransform1D(f.data(), cols, line, v.data(), z.data());
+            }
+        });
+    }
+
+    float distanceToSegment2D(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b)
+    {
+        glm::vec2 ab = b - a;
+        float lengthSq = glm::dot(ab, ab);
+        float t = lengthSq > 0.0f ? glm::clamp(glm::dot(p - a, ab) / lengthSq, 0.0f, 1.0f) : 0.0f;
+        return glm::length(p - (a + ab * t));
+    }
+
+    float cross2D(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+}
+
+void DistanceField::build(const std::vector<glm::vec3>& triangles, const glm::vec2& boundsMin, const glm::vec2& boundsMax,
+                          float cellSize, float bandMinY, float bandMaxY)
+{
+    glm::vec2 extent = boundsMax - boundsMin;
+    requestedCell = cellSize;
+    cell = std::max({cellSize, extent.x / MAX_CELLS_PER_AXIS, extent.y / MAX_CELLS_PER_AXIS});
+    fieldOrigin = boundsMin;
+    bandMin = bandMinY;
+    bandMax = bandMaxY;
+    cols = std::max(1, static_cast<int>(std::ceil(extent.x / cell)));
+    rows = std::max(1, static_cast<int>(std::ceil(extent.y / cell)));
+
+    // Rasterização conservadora das pegadas: marca as células cujo centro está a
+    // menos de meia célula do triângulo projetado (paredes verticais viram segmentos)
+    std::vector<uint8_t> solid(static_cast<size_t>(cols) * rows, 0);
+    const float reach = cell * 0.5f;
+    for (size_t t = 0; t + 2 < triangles.size(); t += 3) {
+        const glm::vec3& a3 = triangles[t];
+        const glm::vec3& b3 = triangles[t + 1];
+        const glm::vec3& c3 = triangles[t + 2];
+        float lowY = std::min({a3.y, b3.y, c3.y}), highY = std::max({a3.y, b3.y, c3.y});
+        if (highY < bandMin || lowY > bandMax) continue;
+
+        glm::vec2 a(a3.x, a3.z), b(b3.x, b3.z), c(c3.x, c3.z);
+        glm::vec2 lo = glm::min(a, glm::min(b, c)) - glm::vec2(reach);
+        glm::vec2 hi = glm::max(a, glm::max(b, c)) + glm::vec2(reach);
+        int x0 = std::max(0, static_cast<int>(std::floor((lo.x - fieldOrigin.x) / cell)));
+        int x1 = std::min(cols - 1, static_cast<int>(std::floor((hi.x - fieldOrigin.x) / cell)));
+        int z0 = std::max(0, static_cast<int>(std::floor((lo.y - fieldOrigin.y) / cell)));
+        int z1 = std::min(rows - 1, static_cast<int>(std::floor((hi.y - fieldOrigin.y) / cell)));
+        float area = cross2D(b - a, c - a);
+        for (int z = z0; z <= z1; ++z) {
+            for (int x = x0; x <= x1; ++x) {
+                glm::vec2 p = fieldOrigin + (glm::vec2(float(x), float(z)) + 0.5f) * cell;
+                bool inside = false;
+                if (std::abs(area) > 1e-8f) {
+                    float w0 = cross2D(b - a, p - a), w1 = cross2D(c - b, p - b), w2 = cross2D(a - c, p - c);
+                    inside = (w0 >= 0 && w1 >= 0 && w2 >= 0) || (w0 <= 0 && w1 <= 0 && w2 <= 0);
+                }
+                if (inside || distanceToSegment2D(p, a, b) <= reach || distanceToSegment2D(p, b, c) <= reach ||
+                    distanceToSegment2D(p, c, a) <= reach)
+                { solid[static_cast<size_t>(z) * cols + x] = 1; }
+            }
+        }
+    }
+
+    // Distância até a parede (fora) e até o espaço livre (dentro)
+    std::vector<float> outside(solid.size()), inside(solid.size());
+    for (size_t i = 0; i < solid.size(); ++i) {
+        outside[i] = solid[i] ? 0.0f : FAR_AWAY;
+        inside[i] = solid[i] ? FAR_AWAY : 0.0f;
+    }
+    distanceTransform2D(outside, cols, rows);
+    distanceTransform2D(inside, cols, rows);
+
+    // A superfície fica na borda entre células: meia célula antes do centro vizinho
+    distances.resize(solid.size());
+    for (size_t i = 0; i < solid.size(); ++i) {
+        float d = solid[i] ? -(std::sqrt(inside[i]) - 0.5f) : (std::sqrt(outside[i]) - 0.5f);
+        distances[i] = d * cell;
+    }
+}
+
+bool DistanceField::contains(const glm::vec2& xz) const
+{
+    glm::vec2 local = xz - fieldOrigin;
+    return !distances.empty() && local.x >= 0.0f && local.y >= 0.0f && local.x <= cols * cell && local.y <= rows * cell;
+}
+
+float DistanceField::sample(const glm::vec2& xz) const
+{
+    if (distances.empty()) return 0.0f;
+    glm::vec2 u = (xz - fieldOrigin) / cell - 0.5f;
+    u = glm::clamp(u, glm::vec2(0.0f), glm::vec2(float(cols - 1), float(rows - 1)));
+    int x0 = static_cast<int>(u.x), z0 = static_cast<int>(u.y);
+    int x1 = std::min(x0 + 1, cols - 1), z1 = std::min(z0 + 1, rows - 1);
+    float fx = u.x - x0, fz = u.y - z0;
+    float top = glm::mix(at(x0, z0), at(x1, z0), fx);
+    float bottom = glm::mix(at(x0, z1), at(x1, z1), fx);
+    return glm::mix(top, bottom, fz);
+}
+
+glm::vec2 DistanceField::gradient(const glm::vec2& xz) const
+{
+    glm::vec2 dx(cell, 0.0f), dz(0.0f, cell);
+    return glm::vec2(sample(xz + dx) - sample(xz - dx), sample(xz + dz) - sample(xz - dz)) / (2.0f * cell);
+}
+
+bool DistanceField::isClear(const glm::vec3& pos, float radius) const
+{
+    glm::vec2 xz(pos.x, pos.z);
+    // Uma célula de margem cobre o erro da rasterização e da interpolação
+    return contains(xz) && sample(xz) > radius + cell;
+}
+
+glm::vec3 DistanceField::resolve(const glm::vec3& pos, float radius) const
+{
+    glm::vec3 result = pos;
+    for (int i = 0; i < 4; ++i) {
+        glm::vec2 xz(result.x, result.z);
+        float d = sample(xz);
+        if (d >= radius) break;
+        glm::vec2 g = gradient(xz);
+        float length = glm::length(g);
+        if (length < 1e-6f) break;
+        glm::vec2 push = g / length * (radius - d);
+        result.x += push.x;
+        result.z += push.y;
+    }
+    return result;
+}
+
+glm::vec3 DistanceField::move(const glm::vec3& pos, const glm::vec3& delta, float radius) const
+{
+    // Passos de no máximo uma célula, para não atravessar paredes finas
+    int steps = std::max(1, static_cast<int>(std::ceil(glm::length(delta) / cell)));
+    glm::vec3 result = pos;
+    for (int i = 0; i < steps; ++i) result = resolve(result + delta / float(steps), radius);
+    return result;
+}
+
+void DistanceField::serialize(std::vector<char>& out) const
+{
+    ByteWriter writer;
+    writer.write(fieldOrigin);
+    writer.write(requestedCell);
+    writer.write(cell);
+    writer.write(bandMin);
+    writer.write(bandMax);
+    writer.write(cols);
+    writer.write(rows);
+    writer.writeArray(distances);
+    out = std::move(writer.data);
+}
+
+bool DistanceField::deserialize(const std::vector<char>& in)
+{
+    ByteReader reader(in);
+    bool ok = reader.read(fieldOrigin) && reader.read(requestedCell) && reader.read(cell) && reader.read(bandMin) &&
+              reader.read(bandMax) && reader.read(cols) && reader.read(rows) && reader.readArray(distances);
+    if (!ok || distances.size() != static_cast<size_t>(cols) * rows) { distances.clear(); return false; }
+    return true;
+}
+
+bool DistanceField::matches(const glm::vec2& boundsMin, float cellSize, float bandMinY, float bandMaxY) const
+{
+    return !distances.empty() && fieldOrigin == boundsMin && requestedCell == cellSize && bandMin == bandMinY && bandMax == bandMaxY;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// ============================================================================
+// CAMPO DE DISTÂNCIA COM SINAL DO PLANO XZ
+// ============================================================================
+// Planta baixa do labirinto rasterizada numa grade 2D: cada célula guarda a
+// distância (em unidades do mundo) até a parede mais próxima, negativa dentro
+// das paredes. Mover um corpo vira uma amostra e um gradiente, em O(1),
+// independente da quantidade de triângulos da cena.
+class DistanceField
+{
+public:
+    // Rasteriza os triângulos que cruzam a faixa de altura [bandMinY, bandMaxY]
+    // (3 vértices por triângulo) e calcula a transformada de distância exata
+    void build(const std::vector<glm::vec3>& triangles, const glm::vec2& boundsMin, const glm::vec2& boundsMax,
+               float cellSize, float bandMinY, float bandMaxY);
+
+    bool empty() const { return distances.empty(); }
+    bool contains(const glm::vec2& xz) const;
+
+    // Distância interpolada (bilinear); fora do campo retorna 0
+    float sample(const glm::vec2& xz) const;
+    // Direção de afastamento das paredes (diferenças centrais da amostra)
+    glm::vec2 gradient(const glm::vec2& xz) const;
+
+    // Verdadeiro se um círculo de raio `radius` está garantidamente livre
+    bool isClear(const glm::vec3& pos, float radius) const;
+    // Empurra o círculo para fora das paredes ao longo do gradiente
+    glm::vec3 resolve(const glm::vec3& pos, float radius) const;
+    // Move e resolve numa chamada só (corpos simples, sem BVH)
+    glm::vec3 move(const glm::vec3& pos, const glm::vec3& delta, float radius) const;
+
+    // Conservação no arquivo de dados pré-calculados (BakedScene)
+    void serialize(std::vector<char>& out) const;
+    bool deserialize(const std::vector<char>& in);
+    bool matches(const glm::vec2& boundsMin, float cellSize, float bandMinY, float bandMaxY) const;
+
+    int width() const { return cols; }
+    int height() const { return rows; }
+    float cellSize() const { return cell; }
+    glm::vec2 origin() const { return fieldOrigin; }
+
+private:
+    float at(int x, int z) const { return distances[static_cast<size_t>(z) * cols + x]; }
+
+    glm::vec2 fieldOrigin = glm::vec2(0.0f);
+    float cell = 0.25f;
+    float requestedCell = 0.25f;           // Tamanho pedido (pode crescer em mapas enormes)
+    float bandMin = 0.0f, bandMax = 0.0f;
+    int cols = 0, rows = 0;
+    std::vector<float> distances;
+};
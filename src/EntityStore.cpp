@@ -0,0 +1,172 @@
+#include "EntityStore.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+// ============================================================================
+// CRIAÇÃO E REMOÇÃO
+// ============================================================================
+Entity EntityStore::create()
+{
+    Entity entity;
+    if (freeSlot != Entity::INVALID) {
+        entity.index = freeSlot;
+        freeSlot = slots[freeSlot].dense;
+    } else {
+        entity.index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    Slot& slot = slots[entity.index];
+    entity.generation = slot.generation;
+    slot.dense = static_cast<uint32_t>(owners.size());
+
+    owners.push_back(entity);
+    transforms.emplace_back(1.0f);
+    locals.emplace_back(1.0f);
+    parents.emplace_back();
+    mins.emplace_back(0.0f);
+    maxs.emplace_back(0.0f);
+    meshes.emplace_back();
+    flagBits.push_back(EntityFlag::Dirty);
+    levelsDirty = true;
+    return entity;
+}
+
+void EntityStore::destroy(Entity entity)
+{
+    if (!alive(entity)) return;
+    Slot& slot = slots[entity.index];
+    const uint32_t dense = slot.dense;
+    const uint32_t last = static_cast<uint32_t>(owners.size() - 1);
+
+    // A última entidade ocupa o buraco, mantendo os arrays contíguos
+    if (dense != last) {
+        owners[dense] = owners[last];
+        transforms[dense] = transforms[last];
+        locals[dense] = locals[last];
+        parents[dense] = parents[last];
+        mins[dense] = mins[last];
+        maxs[dense] = maxs[last];
+        meshes[dense] = meshes[last];
+        flagBits[dense] = flagBits[last];
+        slots[owners[dense].index].dense = dense;
+    }
+    owners.pop_back();
+    transforms.pop_back();
+    locals.pop_back();
+    parents.pop_back();
+    mins.pop_back();
+    maxs.pop_back();
+    meshes.pop_back();
+    flagBits.pop_back();
+
+    ++slot.generation;
+    slot.dense = freeSlot;
+    freeSlot = entity.index;
+    // Filhos da entidade removida viram raízes na próxima reconstrução dos níveis
+    levelsDirty = true;
+}
+
+bool EntityStore::alive(Entity entity) const
+{
+    return entity.index < slots.size() && slots[entity.index].generation == entity.generation &&
+           slots[entity.index].dense < owners.size() && owners[slots[entity.index].dense] == entity;
+}
+
+void EntityStore::clear()
+{
+    slots.clear();
+    owners.clear();
+    freeSlot = Entity::INVALID;
+    transforms.clear();
+    locals.clear();
+    parents.clear();
+    mins.clear();
+    maxs.clear();
+    meshes.clear();
+    flagBits.clear();
+    levelsDirty = true;
+}
+
+// ============================================================================
+// HIERARQUIA DE TRANSFORMAÇÕES
+// ============================================================================
+void EntityStore::setParent(Entity entity, Entity parent)
+{
+    // Recusa ciclos: o novo pai não pode descender da própria entidade
+    for (Entity ancestor = parent; alive(ancestor); ancestor = parents[denseIndex(ancestor)]) {
+        if (ancestor == entity) return;
+    }
+    size_t dense = denseIndex(entity);
+    parents[dense] = parent;
+    flagBits[dense] |= EntityFlag::Dirty;
+    levelsDirty = true;
+}
+
+void EntityStore::setLocalTransform(Entity entity, const glm::mat4& local)
+{
+    size_t dense = denseIndex(entity);
+    locals[dense] = local;
+    flagBits[dense] |= EntityFlag::Dirty;
+}
+
+void EntityStore::rebuildLevels()
+{
+    const uint32_t count = static_cast<uint32_t>(owners.size());
+    parentDense.assign(count, Entity::INVALID);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (alive(parents[i])) parentDense[i] = slots[parents[i].index].dense;
+    }
+
+    // Profundidade de cada entidade, subindo pelos pais até um valor já conhecido
+    std::vector<uint32_t> depth(count, Entity::INVALID);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t node = i;
+        chain.clear();
+        while (node != Entity::INVALID && depth[node] == Entity::INVALID) {
+            chain.push_back(node);
+            node = parentDense[node];
+        }
+        uint32_t d = node == Entity::INVALID ? 0 : depth[node] + 1;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) depth[*it] = d++;
+        maxDepth = std::max(maxDepth, depth[i]);
+    }
+
+    // Ordenação por contagem: cada nível vira um intervalo contínuo de levelOrder
+    levelStarts.assign(count ? maxDepth + 2 : 1, 0);
+    for (uint32_t i = 0; i < count; ++i) ++levelStarts[depth[i] + 1];
+    for (size_t d = 1; d < levelStarts.size(); ++d) levelStarts[d] += levelStarts[d - 1];
+    levelOrder.resize(count);
+    std::vector<uint32_t> cursor(levelStarts.begin(), levelStarts.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) levelOrder[cursor[depth[i]]++] = i;
+
+    // A estrutura mudou: tudo é recalculado uma vez
+    for (uint8_t& flags : flagBits) flags |= EntityFlag::Dirty;
+    levelsDirty = false;
+}
+
+void EntityStore::updateTransforms(JobSystem* jobs)
+{
+    if (levelsDirty) rebuildLevels();
+    worldChanged.assign(owners.size(), 0);
+
+    // Dentro de um nível, cada entidade só lê o pai (nível anterior, já pronto)
+    for (size_t d = 0; d + 1 < levelStarts.size(); ++d) {
+        const uint32_t levelBegin = levelStarts[d];
+        const size_t levelSize = levelStarts[d + 1] - levelBegin;
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t k = levelBegin + begin; k < levelBegin + end; ++k) {
+                const uint32_t i = levelOrder[k];
+                const uint32_t p = parentDense[i];
+                const bool parentChanged = p != Entity::INVALID && worldChanged[p];
+                if (!(flagBits[i] & EntityFlag::Dirty) && !parentChanged) continue;
+                transforms[i] = p == Entity::INVALID ? locals[i] : transforms[p] * locals[i];
+                flagBits[i] &= ~EntityFlag::Dirty;
+                worldChanged[i] = 1;
+            }
+        };
+        if (jobs && levelSize > 4096) jobs->parallelFor(levelSize, 1024, body);
+        else body(0, levelSize);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// ============================================================================
+// ARMAZENAMENTO DE ENTIDADES
+// ============================================================================
+// Componentes em arrays densos e paralelos (SoA): a entidade na posição i de
+// um array é a mesma na posição i de todos os outros, então laços de
+// renderização e atualização percorrem memória contígua. Fora do laço, as
+// entidades são referenciadas por handles com geração, que continuam seguros
+// quando outras entidades são removidas (remoção troca com a última posição).
+//
+// Cada entidade tem uma transformação local e, opcionalmente, um pai; a matriz
+// do mundo só é recalculada para subárvores marcadas como sujas, nível por
+// nível de profundidade (todas as entidades de um nível são independentes).
+
+// Identificador estável; a geração detecta handles de entidades já destruídas
+struct Entity {
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+    uint32_t index = INVALID;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != INVALID; }
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+// Geometria pronta para desenhar (VAO do OpenGL, sem depender do glad aqui)
+struct RenderMesh {
+    unsigned int vao = 0;
+    unsigned int vbo = 0;              // Guardado para poder liberar a malha (chunks descarregados)
+    unsigned int lightmapVBO = 0;      // UVs do lightmap (atributo 2), só na geometria estática assada
+    int vertexCount = 0;
+};
+
+namespace EntityFlag {
+    constexpr uint8_t Collider = 1 << 0;  // Faz parte do mundo de colisão
+    constexpr uint8_t Dirty    = 1 << 1;  // Transformação local mudou desde o último update
+    constexpr uint8_t Lightmapped = 1 << 2; // Luz estática assada no atlas (RenderMesh::lightmapVBO)
+    constexpr uint8_t Animated = 1 << 3;    // Move-se durante o jogo: fica fora do cache de sombras
+}
+
+class EntityStore
+{
+public:
+    Entity create();
+    void destroy(Entity entity);
+    bool alive(Entity entity) const;
+    void clear();
+
+    size_t size() const { return owners.size(); }
+    // Posição atual da entidade nos arrays densos (muda quando outra é removida)
+    size_t denseIndex(Entity entity) const { return slots[entity.index].dense; }
+    Entity entityAt(size_t dense) const { return owners[dense]; }
+
+    // Hierarquia: a matriz do mundo é pai->mundo * local
+    void setParent(Entity entity, Entity parent);   // Entity() remove o pai
+    Entity parent(Entity entity) const { return parents[denseIndex(entity)]; }
+    void setLocalTransform(Entity entity, const glm::mat4& local);
+    const glm::mat4& localTransform(Entity entity) const { return locals[denseIndex(entity)]; }
+    // Recalcula as matrizes do mundo das subárvores sujas; com `jobs`, os níveis
+    // grandes são repartidos entre as threads
+    void updateTransforms(JobSystem* jobs = nullptr);
+
+    // Componentes por handle (transform = matriz do mundo, válida após updateTransforms)
+    const glm::mat4& transform(Entity entity) const { return transforms[denseIndex(entity)]; }
+    glm::vec3& boundsMin(Entity entity) { return mins[denseIndex(entity)]; }
+    const glm::vec3& boundsMin(Entity entity) const { return mins[denseIndex(entity)]; }
+    glm::vec3& boundsMax(Entity entity) { return maxs[denseIndex(entity)]; }
+    const glm::vec3& boundsMax(Entity entity) const { return maxs[denseIndex(entity)]; }
+    RenderMesh& mesh(Entity entity) { return meshes[denseIndex(entity)]; }
+    const RenderMesh& mesh(Entity entity) const { return meshes[denseIndex(entity)]; }
+    uint8_t& flags(Entity entity) { return flagBits[denseIndex(entity)]; }
+    uint8_t flags(Entity entity) const { return flagBits[denseIndex(entity)]; }
+
+    // Arrays densos, todos com size() elementos e na mesma ordem
+    const std::vector<glm::mat4>& denseTransforms() const { return transforms; }
+    const std::vector<glm::vec3>& denseBoundsMin() const { return mins; }
+    const std::vector<glm::vec3>& denseBoundsMax() const { return maxs; }
+    const std::vector<RenderMesh>& denseMeshes() const { return meshes; }
+    const std::vector<uint8_t>& denseFlags() const { return flagBits; }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;               // Posição nos arrays densos (ou próximo livre)
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots;              // Indexado por Entity::index
+    std::vector<Entity> owners;           // Denso: handle de cada posição
+    uint32_t freeSlot = Entity::INVALID;  // Lista de slots livres encadeada por `dense`
+
+    std::vector<glm::mat4> transforms;    // Mundo
+    std::vector<glm::mat4> locals;        // Relativa ao pai
+    std::vector<Entity> parents;
+    std::vector<glm::vec3> mins, maxs;
+    std::vector<RenderMesh> meshes;
+    std::vector<uint8_t> flagBits;
+
+    void rebuildLevels();
+
+    // Posições densas agrupadas por profundidade; refeito quando a hierarquia muda
+    std::vector<uint32_t> parentDense;    // Posição densa do pai ou Entity::INVALID
+    std::vector<uint32_t> levelOrder;
+    std::vector<uint32_t> levelStarts;    // levelOrder[levelStarts[d], levelStarts[d + 1]) = profundidade d
+    std::vector<uint8_t> worldChanged;    // Rascunho do update: matriz do mundo refeita neste passo
+    bool levelsDirty = true;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cmath>
+
+// ============================================================================
+// PASSO FIXO DE SIMULAÇÃO
+// ============================================================================
+// Acumula o tempo real decorrido e o converte em ticks de duração fixa, para que
+// colisão e animações não dependam da taxa de quadros. Depois de um travamento
+// longo, no máximo maxCatchUpSteps ticks são executados e o resto é descartado
+// (o jogo "desacelera" em vez de entrar numa espiral de recuperação).
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(double ticksPerSecond = 60.0, int maxCatchUpSteps = 5)
+        : step(1.0 / ticksPerSecond), maxSteps(maxCatchUpSteps) {}
+
+    void setTickRate(double ticksPerSecond) { step = 1.0 / ticksPerSecond; }
+    void setMaxCatchUpSteps(int steps) { maxSteps = steps > 0 ? steps : 1; }
+
+    // Soma o tempo decorrido e retorna quantos ticks devem ser simulados agora
+    int advance(double elapsedSeconds)
+    {
+        accumulator += elapsedSeconds;
+        int steps = static_cast<int>(accumulator / step);
+        if (steps > maxSteps) {
+            steps = maxSteps;
+            accumulator = std::fmod(accumulator, step);
+        } else {
+            accumulator -= steps * step;
+        }
+        return steps;
+    }
+
+    double stepSeconds() const { return step; }
+    // Tempo ainda não simulado. A fração de interpolação da renderização sai
+    // daqui via GameSnapshot::time (o acumulador é só da thread de simulação)
+    double leftover() const { return accumulator; }
+    double timeUntilNextStep() const { return step - accumulator; }
+
+private:
+    double step;
+    int maxSteps;
+    double accumulator = 0.0;
+};
@@ -0,0 +1,121 @@
+#include "FlowField.h"
+#include "JobSystem.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const float INF = std::numeric_limits<float>::infinity();
+    const float DIAGONAL_COST = 1.41421356f;
+    const int DIRECTIONS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    bool openGreater(const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; }
+}
+
+const glm::vec2 FlowField::DIRECTION_VECTORS[9] = {
+    {1.0f, 0.0f}, {-1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, -1.0f},
+    {0.70710678f, 0.70710678f}, {0.70710678f, -0.70710678f}, {-0.70710678f, 0.70710678f}, {-0.70710678f, -0.70710678f},
+    {0.0f, 0.0f}};
+
+void FlowField::build(const NavGrid& grid, const std::vector<glm::ivec2>& targets, JobSystem* jobs)
+{
+    targetCells = targets;
+    cols = grid.width();
+    rows = grid.height();
+    fieldOrigin = grid.origin();
+    cell = grid.cellSize();
+    const size_t cellCount = static_cast<size_t>(cols) * rows;
+    distances.assign(cellCount, INF);
+    directions.assign(cellCount, NO_DIRECTION);
+
+    // Campo de integração: Dijkstra com todos os alvos como origem (mesmos
+    // passos do A*: 8 vizinhos, sem cortar quinas)
+    std::vector<std::pair<float, int>> open;
+    for (const glm::ivec2& target : targets) {
+        if (!grid.walkable(target)) continue;
+        distances[grid.index(target)] = 0.0f;
+        open.emplace_back(0.0f, grid.index(target));
+    }
+    std::make_heap(open.begin(), open.end(), openGreater);
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), openGreater);
+        const auto [cost, current] = open.back();
+        open.pop_back();
+        if (cost > distances[current]) continue;   // Entrada velha
+        const int x = current % cols, z = current / cols;
+        for (int d = 0; d < 8; ++d) {
+            const int nx = x + DIRECTIONS[d][0], nz = z + DIRECTIONS[d][1];
+            if (!grid.walkable(nx, nz)) continue;
+            const bool diagonal = d >= 4;
+            if (diagonal && (!grid.walkable(nx, z) || !grid.walkable(x, nz))) continue;
+            const int next = nz * cols + nx;
+            const float g = cost + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (g >= distances[next]) continue;
+            distances[next] = g;
+            open.emplace_back(g, next);
+            std::push_heap(open.begin(), open.end(), openGreater);
+        }
+    }
+
+    // Direções: cada faixa de linhas é independente, então vai em paralelo
+    auto pointRows = [&](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; ++z) {
+            for (int x = 0; x < cols; ++x) {
+                const size_t i = z * cols + x;
+                if (distances[i] == INF || distances[i] == 0.0f) continue;
+                float best = distances[i];
+                for (int d = 0; d < 8; ++d) {
+                    const int nx = x + DIRECTIONS[d][0], nz = static_cast<int>(z) + DIRECTIONS[d][1];
+                    if (!grid.walkable(nx, nz)) continue;
+                    if (d >= 4 && (!grid.walkable(nx, static_cast<int>(z)) || !grid.walkable(x, nz))) continue;
+                    const float neighbor = distances[static_cast<size_t>(nz) * cols + nx];
+                    if (neighbor < best) { best = neighbor; directions[i] = static_cast<uint8_t>(d); }
+                }
+            }
+        }
+    };
+    if (jobs) jobs->parallelFor(rows, 32, pointRows);
+    else pointRows(0, rows);
+}
+
+glm::vec2 FlowField::direction(const glm::vec2& xz) const
+{
+    const int x = static_cast<int>(std::floor((xz.x - fieldOrigin.x) / cell));
+    const int z = static_cast<int>(std::floor((xz.y - fieldOrigin.y) / cell));
+    if (x < 0 || z < 0 || x >= cols || z >= rows) return glm::vec2(0.0f);
+    return DIRECTION_VECTORS[directions[static_cast<size_t>(z) * cols + x]];
+}
+
+float FlowField::distance(const glm::ivec2& c) const
+{
+    if (c.x < 0 || c.y < 0 || c.x >= cols || c.y >= rows) return -1.0f;
+    const float d = distances[static_cast<size_t>(c.y) * cols + c.x];
+    return d == INF ? -1.0f : d;
+}
+
+// ============================================================================
+// CACHE DE CAMPOS
+// ============================================================================
+std::shared_ptr<const FlowField> FlowFieldCache::acquire(const NavGrid& grid, const glm::ivec2& target, JobSystem* jobs)
+{
+    ++useClock;
+    for (Entry& entry : entries) {
+        if (entry.target == target) {
+            entry.lastUse = useClock;
+            return entry.field;
+        }
+    }
+
+    auto field = std::make_shared<FlowField>();
+    field->build(grid, {target}, jobs);
+    ++buildCount;
+    if (entries.size() >= capacity && !entries.empty()) {
+        auto oldest = std::min_element(entries.begin(), entries.end(),
+                                       [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+        *oldest = {target, useClock, field};
+    } else {
+        entries.push_back({target, useClock, field});
+    }
+    return field;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class NavGrid;
+class JobSystem;
+
+// ============================================================================
+// CAMPO DE FLUXO
+// ============================================================================
+// Um Dijkstra a partir dos alvos dá a distância de cada célula até o alvo mais
+// próximo (campo de integração); cada célula guarda então a direção do vizinho
+// com a menor distância. Qualquer quantidade de agentes segue o campo só com
+// uma leitura por agente, sem busca de caminho individual.
+class FlowField
+{
+public:
+    static constexpr uint8_t NO_DIRECTION = 8;   // Alvo, parede ou célula sem caminho
+
+    void build(const NavGrid& grid, const std::vector<glm::ivec2>& targets, JobSystem* jobs = nullptr);
+
+    bool empty() const { return directions.empty(); }
+    const std::vector<glm::ivec2>& targets() const { return targetCells; }
+
+    // Direção unitária no plano XZ para a posição (zero no alvo ou fora do campo)
+    glm::vec2 direction(const glm::vec2& xz) const;
+    // Distância em células até o alvo mais próximo (negativo = inalcançável)
+    float distance(const glm::ivec2& c) const;
+
+    // Acesso direto para laços em lote
+    int width() const { return cols; }
+    int height() const { return rows; }
+    glm::vec2 origin() const { return fieldOrigin; }
+    float cellSize() const { return cell; }
+    const std::vector<uint8_t>& directionCodes() const { return directions; }
+    static const glm::vec2& directionVector(uint8_t code) { return DIRECTION_VECTORS[code]; }
+
+private:
+    static const glm::vec2 DIRECTION_VECTORS[9];
+
+    std::vector<glm::ivec2> targetCells;
+    std::vector<float> distances;
+    std::vector<uint8_t> directions;
+    glm::vec2 fieldOrigin = glm::vec2(0.0f);
+    float cell = 1.0f;
+    int cols = 0, rows = 0;
+};
+
+// Campos já calculados, por célula alvo; o menos usado sai quando enche.
+// Os campos são compartilhados, então quem ainda segura um campo despejado
+// continua com uma cópia válida.
+class FlowFieldCache
+{
+public:
+    explicit FlowFieldCache(size_t capacity = 16) : capacity(capacity) {}
+
+    std::shared_ptr<const FlowField> acquire(const NavGrid& grid, const glm::ivec2& target, JobSystem* jobs = nullptr);
+    void clear() { entries.clear(); }
+
+    size_t size() const { return entries.size(); }
+    size_t builds() const { return buildCount; }
+
+private:
+    struct Entry {
+        glm::ivec2 target;
+        uint64_t lastUse;
+        std::shared_ptr<const FlowField> field;
+    };
+
+    size_t capacity;
+    std::vector<Entry> entries;
+    uint64_t useClock = 0;
+    size_t buildCount = 0;
+};
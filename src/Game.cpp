@@ -1,9 +1,13 @@
 #include "Game.h"
 #include "tiny_obj_loader.h"
+#include "JobSystem.h"
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <random>
+#include <unordered_map>
 
 // ============================================================================
 // IMPLEMENTAÇÃO DAS FUNÇÕES WRAPPER
@@ -22,6 +26,36 @@ void mouse_button_callback_wrapper(GLFWwindow* window, int button, int action, i
     if (game) game->MouseButtonCallback(button, action, mods);
 }
 
+namespace {
+    // Triângulos intercalados (posição + normal) num VAO pronto para desenhar
+    RenderMesh uploadMesh(const std::vector<float>& vertexData)
+    {
+        RenderMesh mesh;
+        mesh.vertexCount = static_cast<int>(vertexData.size() / 6);
+        glGenVertexArrays(1, &mesh.vao);
+        glGenBuffers(1, &mesh.vbo);
+        glBindVertexArray(mesh.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+        return mesh;
+    }
+
+    // Variante mínima de shader.frag: nenhum material da cena usa textura,
+    // mapa normal ou PBR
+    ShaderFeatures litFeatures(int bakedLighting, int lightCount)
+    {
+        ShaderFeatures features;
+        features.bakedLighting = bakedLighting;
+        features.lightCount = lightCount;
+        return features;
+    }
+}
+
 // Implementação da Classe Game
 Game::Game(unsigned int width, unsigned int height) : Width(width), Height(height), IsRunning(true)
 {
@@ -84,8 +118,13 @@ Game::Game(unsigned int width, unsigned int height) : Width(width), Height(heigh
 
 Game::~Game()
 {
-    delete SceneShader;
+    StopSimulation();
+    delete Tiles;
+    delete Map;
+    delete Shadows;
+    if (bakedLightingTexture) glDeleteTextures(1, &bakedLightingTexture);
     delete Text;
+    delete Programs;
     glfwTerminate();
 }
 
@@ -101,16 +140,104 @@ void Game::Init()
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     std::cout << "Carregando shaders..." << std::endl;
-    SceneShader = new Shader("shaders/shader.vert", "shaders/shader.frag");
-    Shader* textShader = new Shader("shaders/text.vert", "shaders/text.frag");
+    // Cada programa (e cada variante de shader.frag) é compilado uma vez. Os
+    // fixos são pedidos todos juntos aqui e o driver os compila enquanto a cena
+    // carrega; cada get() espera só pelo programa que devolve
+    Programs = new ShaderCache(&JobSystem::shared());
+    const char* fixedPrograms[][2] = {
+        {"shaders/text.vert", "shaders/text.frag"},
+        {"shaders/debug.vert", "shaders/debug.frag"},
+        {"shaders/shadow_depth.vert", "shaders/shadow_depth.frag"},
+        {"shaders/shadow_tile.vert", "shaders/shadow_depth.frag"},
+        {"shaders/shadow_npc.vert", "shaders/shadow_depth.frag"},
+        {"shaders/minimap.vert", "shaders/minimap.frag"},
+        {"shaders/minimap_marker.vert", "shaders/minimap_marker.frag"},
+    };
+    for (const auto& program : fixedPrograms) Programs->request(program[0], program[1]);
+    Programs->request("shaders/shader.vert", "shaders/shader.frag", litFeatures(0, 0));
+    Programs->submit();
+
+    // Linha de orientação: um único VBO dinâmico, desenhado como uma line strip
+    glGenVertexArrays(1, &guideVAO);
+    glGenBuffers(1, &guideVBO);
+    glBindVertexArray(guideVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, guideVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    // NPCs: uma caixa compartilhada (posição + normal, como as malhas da cena)
+    // e um VBO de posições por instância, reenviado a cada quadro
+    std::vector<float> box;
+    const glm::vec3 lo(-0.3f, 0.0f, -0.3f), hi(0.3f, 1.6f, 0.3f);
+    const int faces[6][4] = {{0, 2, 6, 4}, {1, 5, 7, 3}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 6, 7, 5}};
+    const glm::vec3 normals[6] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    for (int f = 0; f < 6; ++f) {
+        for (int corner : {0, 1, 2, 0, 2, 3}) {
+            int v = faces[f][corner];
+            box.insert(box.end(), {v & 1 ? hi.x : lo.x, v & 2 ? hi.y : lo.y, v & 4 ? hi.z : lo.z,
+                                   normals[f].x, normals[f].y, normals[f].z});
+        }
+    }
+    npcVertexCount = static_cast<int>(box.size() / 6);
+    glGenVertexArrays(1, &npcVAO);
+    glGenBuffers(1, &npcMeshVBO);
+    glGenBuffers(1, &npcInstanceVBO);
+    glBindVertexArray(npcVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, npcMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, box.size() * sizeof(float), box.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ARRAY_BUFFER, npcInstanceVBO);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glBindVertexArray(0);
     
     std::cout << "Inicializando TextRenderer..." << std::endl;
-    Text = new TextRenderer(*textShader, Width, Height);
+    Text = new TextRenderer(Programs->get("shaders/text.vert", "shaders/text.frag"), Width, Height);
     Text->Load("fonts/DejaVuSansMono.ttf", 48);
 
+    // Sombras do sol (a mesma direção de dirLight): a geometria estática fica em
+    // cache por cascata, só tampas e NPCs são redesenhados a cada quadro
+    Shadows = new ShadowCascades(glm::vec3(-0.5f, -1.0f, -0.5f));
+    std::cout << "Sombras: " << ShadowCascades::CASCADES << " cascatas, " << Shadows->gpuBytes() / (1024 * 1024) << " MB de GPU" << std::endl;
+
     
-    std::cout << "Carregando cena do labirinto..." << std::endl;
-    loadScene("models/lab.obj");
+    const float cellSize = 2.0f;       // Lado da célula do labirinto gerado
+    if (mazeWidth > 0) {
+        mazeLayout = std::make_shared<const MazeLayout>(generateMaze(mazeWidth, mazeHeight, mazeAlgorithm, mazeSeed, CHESTS_TO_WIN));
+        if (useTileKit) {
+            Tiles = new TileRenderer(cellSize, VIEW_DISTANCE);
+            std::cout << "Kit de peças: " << Tiles->gpuBytes() / 1024 << " KB de GPU para qualquer tamanho de labirinto" << std::endl;
+        }
+        generateScene(cellSize, streamWorld);
+    } else {
+        std::cout << "Carregando cena do labirinto..." << std::endl;
+        loadScene("models/lab.obj");
+    }
+
+    // Variantes de shader.frag que os quadros vão pedir (luz assada x luzes de
+    // baú ao alcance, até o número de baús): entregues ao driver agora, e o
+    // primeiro quadro só espera pelas que desenhar
+    const int maxLights = std::min(static_cast<int>(chests.size()), MAX_OBJECT_LIGHTS);
+    for (int lights = 0; lights <= maxLights; ++lights) {
+        Programs->request("shaders/shader.vert", "shaders/shader.frag", litFeatures(0, lights));
+        if (bakedLightingMode) Programs->request("shaders/shader.vert", "shaders/shader.frag", litFeatures(bakedLightingMode, lights));
+        Programs->request("shaders/npc.vert", "shaders/shader.frag", litFeatures(0, lights));
+        if (Tiles) Programs->request("shaders/tile.vert", "shaders/shader.frag", litFeatures(0, lights));
+    }
+    Programs->submit();
+    std::cout << "Shaders: " << Programs->programCount() << " programas, " << Programs->compilingCount() << " ainda compilando"
+              << (Programs->parallelCompile() ? " (compilação paralela no driver)" : "") << std::endl;
+
+    DebugShader = &Programs->get("shaders/debug.vert", "shaders/debug.frag");
+    ShadowShader = &Programs->get("shaders/shadow_depth.vert", "shaders/shadow_depth.frag");
+    ShadowTileShader = &Programs->get("shaders/shadow_tile.vert", "shaders/shadow_depth.frag");
+    ShadowNpcShader = &Programs->get("shaders/shadow_npc.vert", "shaders/shadow_depth.frag");
+    createMinimap(cellSize);
     std::cout << "=== INICIALIZAÇÃO CONCLUÍDA ===" << std::endl;
 }
 
@@ -133,40 +260,36 @@ void Game::loadScene(const std::string& path)
     }
     
     std::cout << "✓ Arquivo OBJ carregado com sucesso! (" << shapes.size() << " objetos encontrados)" << std::endl;
+    // Índice nome -> entidade: só existe durante o carregamento
+    std::unordered_map<std::string, Entity> entityByName;
+    std::map<std::string, std::vector<glm::vec3>> shapePositions; // Triângulos de cada objeto, para a BVH
     for (const auto& shape : shapes) {
-        SceneObject obj;
         std::vector<float> vertex_data;
+        std::vector<glm::vec3>& positions = shapePositions[shape.name];
         glm::vec3 min_bound(std::numeric_limits<float>::max());
         glm::vec3 max_bound(std::numeric_limits<float>::lowest());
         for (const auto& index : shape.mesh.indices) {
             glm::vec3 pos = { attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1], attrib.vertices[3 * index.vertex_index + 2] };
             vertex_data.insert(vertex_data.end(), {pos.x, pos.y, pos.z});
+            positions.push_back(pos);
             min_bound = glm::min(min_bound, pos);
             max_bound = glm::max(max_bound, pos);
             if (index.normal_index >= 0 && !attrib.normals.empty()) { vertex_data.insert(vertex_data.end(), {attrib.normals[3 * index.normal_index + 0], attrib.normals[3 * index.normal_index + 1], attrib.normals[3 * index.normal_index + 2]}); }
             else { vertex_data.insert(vertex_data.end(), {0.0f, 1.0f, 0.0f}); }
         }
-        obj.vertexCount = shape.mesh.indices.size();
-        obj.boundingBoxMin = min_bound;
-        obj.boundingBoxMax = max_bound;
-        GLuint VBO;
-        glGenVertexArrays(1, &obj.vao);
-        glGenBuffers(1, &VBO);
-        glBindVertexArray(obj.vao);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(float), vertex_data.data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glBindVertexArray(0);
-        sceneObjects[shape.name] = obj;
+        Entity& entity = entityByName[shape.name];
+        if (!entity.valid()) entity = entities.create();
+        entities.mesh(entity) = uploadMesh(vertex_data);
+        entities.boundsMin(entity) = min_bound;
+        entities.boundsMax(entity) = max_bound;
         std::cout << "Objeto carregado: " << shape.name << std::endl;
     }
 
     std::map<int, std::string> baseNames;
     std::map<int, std::string> lidNames;
-    for (auto const& [name, object] : sceneObjects) {
+    std::vector<glm::vec3> wallTriangles; // Triângulos de todos os colliders (campo de distância)
+    std::vector<glm::vec3> floorTriangles; // Só o piso (grade de navegação)
+    for (auto const& [name, entity] : entityByName) {
         std::string lower_name = name;
         std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(),
                        [](unsigned char c){ return std::tolower(c); });
@@ -178,51 +301,560 @@ void Game::loadScene(const std::string& path)
                 else if (lower_name.find("tampa") != std::string::npos) lidNames[chest_num] = name;
             }
         }
-        else if (name.rfind("Paredes", 0) == 0 || name.rfind("Piso", 0) == 0) colliders.push_back(&sceneObjects[name]);
-        else if (name.find("Portal") != std::string::npos) portalObject = &sceneObjects[name];
+        else if (name.rfind("Paredes", 0) == 0 || name.rfind("Piso", 0) == 0 || name.rfind("Curve", 0) == 0) {
+            addCollider(entity, shapePositions[name], wallTriangles);
+            if (name.rfind("Piso", 0) == 0) {
+                floorTriangles.insert(floorTriangles.end(), shapePositions[name].begin(), shapePositions[name].end());
+            }
+        }
+        else if (name.find("Portal") != std::string::npos) {
+            addPortal(shapePositions[name]);
+        }
     }
     for (auto const& [num, name] : baseNames) {
         if (lidNames.count(num)) {
-            auto chest = std::make_unique<Chest>();
-            chest->base = &sceneObjects[name];
-            chest->lid = &sceneObjects[lidNames[num]];
-            chest->base_name = name;
-            chest->update(0);
-            chests.push_back(std::move(chest));
+            addChest(entityByName[name], entityByName[lidNames[num]], name, shapePositions[name], shapePositions[lidNames[num]]);
+        }
+    }
+
+    finishScene(wallTriangles, floorTriangles, path);
+}
+
+// Labirinto gerado: as mesmas entidades, colliders e interativos do OBJ, sem arquivo
+// Em streaming, paredes e piso ficam por conta do WorldStreamer; aqui só os objetivos
+void Game::generateScene(float cellSize, bool streamed)
+{
+    const MazeLayout& maze = *mazeLayout;
+    std::cout << "Gerando labirinto " << maze.width << "x" << maze.height << (streamed ? " (em chunks)" : "") << "..." << std::endl;
+    MazeGeometry geometry;
+    if (streamed) buildMazeObjectives(maze, cellSize, geometry);
+    else buildMazeGeometry(maze, cellSize, geometry, 16, &JobSystem::shared());
+
+    // Com o kit de peças, paredes e piso só existem como colliders (sem malha própria)
+    auto createMesh = [&](const std::vector<glm::vec3>& triangles, bool visible = true) {
+        Entity entity = entities.create();
+        if (visible) {
+            std::vector<float> vertexData;
+            interleaveFaceNormals(triangles, vertexData);
+            entities.mesh(entity) = uploadMesh(vertexData);
+        }
+        glm::vec3 lo(std::numeric_limits<float>::max()), hi(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& p : triangles) { lo = glm::min(lo, p); hi = glm::max(hi, p); }
+        entities.boundsMin(entity) = lo;
+        entities.boundsMax(entity) = hi;
+        return entity;
+    };
+
+    std::vector<glm::vec3> wallTriangles, floorTriangles;
+    for (size_t b = 0; b < geometry.wallBlocks.size(); ++b) {
+        addCollider(createMesh(geometry.wallBlocks[b], !Tiles), geometry.wallBlocks[b], wallTriangles);
+        addCollider(createMesh(geometry.floorBlocks[b], !Tiles), geometry.floorBlocks[b], wallTriangles);
+        floorTriangles.insert(floorTriangles.end(), geometry.floorBlocks[b].begin(), geometry.floorBlocks[b].end());
+    }
+    for (size_t i = 0; i < geometry.chests.size(); ++i) {
+        const MazeGeometry::ChestParts& parts = geometry.chests[i];
+        addChest(createMesh(parts.base), createMesh(parts.lid), "Bau_" + std::to_string(i + 1) + "_Base", parts.base, parts.lid);
+    }
+    createMesh(geometry.portal);
+    addPortal(geometry.portal);
+
+    // Começa no centro da célula inicial, olhando para um lado aberto
+    cameraPos = mazeCellCenter(maze.startCell, cellSize) + glm::vec3(0.0f, 1.5f, 0.0f);
+    yaw = maze.wallSouth(maze.startCell.x, maze.startCell.y) ? 0.0f : 90.0f;
+    cameraFront = glm::vec3(std::cos(glm::radians(yaw)), 0.0f, std::sin(glm::radians(yaw)));
+
+    // Sem colliders estáticos, finishScene só cadastra os interativos (SDF e
+    // navegação ficam de fora: cresceriam com o labirinto inteiro)
+    finishScene(wallTriangles, floorTriangles, "");
+    if (streamed) {
+        WorldStreamer::Settings settings;
+        settings.cellSize = cellSize;
+        settings.buildMeshes = !Tiles;
+        streamer.start(mazeLayout, settings);
+        streamer.waitFor(cameraPos);   // O jogo começa com o raio inicial pronto
+        rebuildStreamedCollision();
+    }
+}
+
+// A fase ampla é refeita sobre as BVHs já montadas dos chunks residentes:
+// nenhuma malha é reprocessada, só a grade das AABBs
+void Game::rebuildStreamedCollision()
+{
+    collisionWorld.clear();
+    for (const auto& chunk : streamer.resident()) collisionWorld.addMesh(chunk->collider);
+    collisionWorld.build();
+    ++worldVersion;
+}
+
+// A planta do minimapa vem do layout gerado (paredes por célula) ou, na cena
+// do OBJ, da grade de navegação (células não caminháveis ficam cheias)
+void Game::createMinimap(float mazeCellSize)
+{
+    std::vector<uint8_t> cells;
+    int width = 0, height = 0, revealRadius = 0;
+    glm::vec2 origin(0.0f);
+    float cellSize = mazeCellSize;
+    const float REVEAL_METERS = 6.0f;
+    if (mazeLayout) {
+        width = mazeLayout->width;
+        height = mazeLayout->height;
+        cells = mazeLayout->walls;
+    } else if (!navGrid.empty()) {
+        width = navGrid.width();
+        height = navGrid.height();
+        origin = navGrid.origin();
+        cellSize = navGrid.cellSize();
+        cells.resize(navGrid.data().size());
+        for (size_t i = 0; i < cells.size(); ++i) cells[i] = navGrid.data()[i] ? 0 : Minimap::SOLID;
+    }
+    if (cells.empty()) return;
+    if (!Minimap::fits(width, height)) {
+        std::cout << "Aviso: labirinto grande demais para a textura do minimapa (" << width << "x" << height << ")" << std::endl;
+        return;
+    }
+    revealRadius = static_cast<int>(std::ceil(REVEAL_METERS / cellSize));
+
+    MinimapShader = &Programs->get("shaders/minimap.vert", "shaders/minimap.frag");
+    MarkerShader = &Programs->get("shaders/minimap_marker.vert", "shaders/minimap_marker.frag");
+    Map = new Minimap(*MinimapShader, *MarkerShader, width, height, origin, cellSize, cells, revealRadius);
+
+    std::vector<glm::vec3> chestPositions(chests.size());
+    glm::vec3 portalPosition(0.0f);
+    for (const Interactable& item : interactables) {
+        const glm::vec3 center = (item.baseMesh.boundsMin() + item.baseMesh.boundsMax()) * 0.5f;
+        if (item.chestIndex < 0) portalPosition = center;
+        else chestPositions[item.chestIndex] = center;
+    }
+    Map->setObjectives(chestPositions, portalPosition);
+}
+
+void Game::addCollider(Entity entity, const std::vector<glm::vec3>& triangles, std::vector<glm::vec3>& wallTriangles)
+{
+    colliders.push_back(entity);
+    colliderFirstVertex.push_back(wallTriangles.size());
+    entities.flags(entity) |= EntityFlag::Collider;
+    collisionWorld.addMesh(triangles); // Uma BVH de triângulos por collider
+    wallTriangles.insert(wallTriangles.end(), triangles.begin(), triangles.end());
+}
+
+Shader& Game::litProgram(const char* vertexPath, int bakedLighting, int lightCount)
+{
+    return Programs->get(vertexPath, "shaders/shader.frag", litFeatures(bakedLighting, lightCount));
+}
+
+const Game::LightUniforms& Game::lightUniformsOf(const Shader& shader)
+{
+    auto found = lightUniforms.find(shader.ID);
+    if (found != lightUniforms.end()) return found->second;
+    // Primeiro uso do programa (já ligado): os nomes são montados só aqui
+    LightUniforms& uniforms = lightUniforms[shader.ID];
+    uniforms.indices = glGetUniformLocation(shader.ID, "pointLightIndices");
+    for (int i = 0; i < MAX_SCENE_LIGHTS; ++i) {
+        const std::string name = "pointLights[" + std::to_string(i) + "].";
+        uniforms.position[i] = glGetUniformLocation(shader.ID, (name + "position").c_str());
+        uniforms.color[i] = glGetUniformLocation(shader.ID, (name + "color").c_str());
+        uniforms.intensity[i] = glGetUniformLocation(shader.ID, (name + "intensity").c_str());
+        uniforms.constant[i] = glGetUniformLocation(shader.ID, (name + "constant").c_str());
+        uniforms.linear[i] = glGetUniformLocation(shader.ID, (name + "linear").c_str());
+        uniforms.quadratic[i] = glGetUniformLocation(shader.ID, (name + "quadratic").c_str());
+        uniforms.radius[i] = glGetUniformLocation(shader.ID, (name + "radius").c_str());
+    }
+    return uniforms;
+}
+
+// Atlas numa textura (RGBA8 do lightmap ou R8 da oclusão) e, em cada collider, as
+// suas UVs num VBO extra do mesmo VAO (os vértices da malha seguem a ordem dos
+// triângulos do collider)
+void Game::uploadBakedLighting()
+{
+    glGenTextures(1, &bakedLightingTexture);
+    glBindTexture(GL_TEXTURE_2D, bakedLightingTexture);
+    if (bakedLightingMode == 1) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, lightmap.width(), lightmap.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, lightmap.texels().data());
+    } else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Linhas de um byte por texel
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, occlusion.width(), occlusion.height(), 0, GL_RED, GL_UNSIGNED_BYTE, occlusion.texels().data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    const std::vector<glm::vec2>& uvs = lightmap.uvs();
+    for (size_t c = 0; c < colliders.size(); ++c) {
+        RenderMesh& mesh = entities.mesh(colliders[c]);
+        const size_t first = colliderFirstVertex[c];
+        const size_t count = (c + 1 < colliders.size() ? colliderFirstVertex[c + 1] : uvs.size()) - first;
+        if (mesh.vao == 0 || static_cast<size_t>(mesh.vertexCount) != count) continue; // Malha diferente do collider
+        glGenBuffers(1, &mesh.lightmapVBO);
+        glBindVertexArray(mesh.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.lightmapVBO);
+        glBufferData(GL_ARRAY_BUFFER, count * sizeof(glm::vec2), &uvs[first], GL_STATIC_DRAW);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+        glEnableVertexAttribArray(2);
+        glBindVertexArray(0);
+        entities.flags(colliders[c]) |= EntityFlag::Lightmapped;
+    }
+    const size_t textureBytes = bakedLightingMode == 1 ? lightmap.texels().size() : occlusion.texels().size();
+    std::cout << (bakedLightingMode == 1 ? "Lightmap: " : "Oclusão ambiente: ") << lightmap.width() << "x" << lightmap.height()
+              << ", " << lightmap.texelsPerMeter() << " texels/m, " << textureBytes / 1024 << " KB" << std::endl;
+}
+
+void Game::addPortal(const std::vector<glm::vec3>& triangles)
+{
+    Interactable portal;
+    portal.baseMesh.build(triangles);
+    interactables.push_back(std::move(portal));
+}
+
+void Game::addChest(Entity base, Entity lid, const std::string& name,
+                    const std::vector<glm::vec3>& baseTriangles, const std::vector<glm::vec3>& lidTriangles)
+{
+    Chest chest;
+    chest.base = base;
+    chest.lid = lid;
+    chest.base_name = name;
+    // Tampa e luz seguem a base pela hierarquia de transformações
+    entities.setParent(chest.lid, chest.base);
+    entities.flags(chest.lid) |= EntityFlag::Animated;
+    chest.light = entities.create();
+    entities.setParent(chest.light, chest.base);
+    glm::vec3 chestCenter = (entities.boundsMin(chest.base) + entities.boundsMax(chest.base)) / 2.0f;
+    entities.setLocalTransform(chest.light, glm::translate(glm::mat4(1.0f), chestCenter + glm::vec3(0.0f, 0.3f, 0.0f)));
+    // Canais parados (fechado); o da tampa aponta para o interativo do baú
+    chest.lidChannel = animations.addChannel(0.0f, static_cast<int>(interactables.size()));
+    chest.lightChannel = animations.addChannel(0.0f);
+    Interactable target;
+    target.chestIndex = static_cast<int>(chests.size());
+    target.baseMesh.build(baseTriangles);
+    target.lidMesh.build(lidTriangles);
+    interactables.push_back(std::move(target));
+    chests.push_back(chest);
+}
+
+// Estruturas derivadas da cena pronta: colisão, consultas, SDF e navegação.
+// Com `sourcePath` vazio (cena gerada) nada é lido nem salvo em .bake.
+void Game::finishScene(const std::vector<glm::vec3>& wallTriangles, const std::vector<glm::vec3>& floorTriangles, const std::string& sourcePath)
+{
+    glm::vec2 wallsMin(std::numeric_limits<float>::max()), wallsMax(std::numeric_limits<float>::lowest());
+    for (Entity collider : colliders) {
+        const glm::vec3& lo = entities.boundsMin(collider);
+        const glm::vec3& hi = entities.boundsMax(collider);
+        wallsMin = glm::min(wallsMin, glm::vec2(lo.x, lo.z));
+        wallsMax = glm::max(wallsMax, glm::vec2(hi.x, hi.z));
+    }
+
+    // As AABBs das BVHs vão para a grade de colisão (fase ampla)
+    collisionWorld.build();
+
+    // Interativos no serviço de consultas; o userData é o índice em `interactables`
+    for (size_t i = 0; i < interactables.size(); ++i) {
+        Interactable& item = interactables[i];
+        glm::vec3 lo, hi;
+        item.getBounds(0.0f, lo, hi);
+        unsigned int tags = item.chestIndex < 0 ? QueryTag::Portal : QueryTag::Chest;
+        item.queryHandle = sceneQuery.add(lo, hi, tags, static_cast<int>(i));
+    }
+
+    // Dados pré-calculados: reaproveita o arquivo .bake se o OBJ não mudou
+    const std::string bakePath = sourcePath + ".bake";
+    const uint64_t sourceStamp = sourcePath.empty() ? 0 : BakedScene::sourceStamp(sourcePath);
+    bool bakeChanged = !sourcePath.empty() && !bakedScene.load(bakePath, sourceStamp);
+
+    // Campo de distância da planta baixa, na faixa de altura ocupada pelo jogador
+    const float fieldCellSize = 0.25f, fieldBandMin = 1.1f, fieldBandMax = 1.9f;
+    const glm::vec2 fieldMin = wallsMin - 1.0f, fieldMax = wallsMax + 1.0f;
+    const std::vector<char>* cachedField = bakedScene.find("sdf2d");
+    if (!colliders.empty() &&
+        !(cachedField && floorField.deserialize(*cachedField) && floorField.matches(fieldMin, fieldCellSize, fieldBandMin, fieldBandMax))) {
+        std::cout << "Calculando campo de distância da planta baixa..." << std::endl;
+        floorField.build(wallTriangles, fieldMin, fieldMax, fieldCellSize, fieldBandMin, fieldBandMax);
+        std::vector<char> data;
+        floorField.serialize(data);
+        bakedScene.put("sdf2d", std::move(data));
+        bakeChanged = !sourcePath.empty();
+    }
+    // Consultas de colisão que estouram o orçamento andam pelo campo
+    collisionWorld.setFallbackField(&floorField);
+
+    // Grade de navegação: piso livre a pelo menos o raio do agente das paredes
+    const float navCellSize = 0.5f, navAgentRadius = 0.35f;
+    const std::vector<char>* cachedNav = bakedScene.find("nav2d");
+    if (!colliders.empty() &&
+        !(cachedNav && navGrid.deserialize(*cachedNav) && navGrid.matches(fieldMin, navCellSize, navAgentRadius))) {
+        std::cout << "Calculando grade de navegação..." << std::endl;
+        navGrid.build(floorTriangles, floorField, fieldMin, fieldMax, navCellSize, navAgentRadius);
+        std::vector<char> data;
+        navGrid.serialize(data);
+        bakedScene.put("nav2d", std::move(data));
+        bakeChanged = !sourcePath.empty();
+    }
+    // O grafo abstrato do HPA* e os marcos da orientação são baratos de refazer
+    // e não vão para o arquivo
+    if (!navGrid.empty()) {
+        navigation.build(navGrid, 16, &JobSystem::shared());
+        guidance.buildLandmarks(navGrid, &JobSystem::shared());
+    }
+
+    // Luz estática de paredes e piso: o desdobramento é refeito sempre (barato) e só
+    // o que foi assado vai para o arquivo. Por padrão só a oclusão ambiente (raios
+    // curtos, só de sombra) do OBJ; o lightmap completo é pedido com UseLightmaps e
+    // a oclusão do labirinto gerado, que não tem .bake e seria assada a cada
+    // execução, com UseAmbientOcclusion. O kit de peças não tem malha por collider
+    // e fica de fora
+    const bool bakeOcclusion = !sourcePath.empty() || bakeGeneratedOcclusion;
+    if (!colliders.empty() && !Tiles && (bakeLightmaps || bakeOcclusion)) {
+        // O atlas também tem de caber numa textura desta GPU
+        LightmapSettings lightmapSettings;
+        GLint maxTextureSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        if (maxTextureSize > 0) lightmapSettings.maxAtlasSize = std::min(lightmapSettings.maxAtlasSize, static_cast<int>(maxTextureSize));
+        const OcclusionSettings occlusionSettings;
+        MeshBVH occluders;
+        if (!lightmap.unwrap(wallTriangles, lightmapSettings)) {
+            std::cout << "Aviso: paredes e piso não cabem num atlas de " << lightmapSettings.maxAtlasSize << "x"
+                      << lightmapSettings.maxAtlasSize << "; sem luz assada" << std::endl;
+        } else if (bakeLightmaps) {
+            const std::vector<char>* cached = bakedScene.find("lightmap");
+            if (!(cached && lightmap.deserialize(*cached) && lightmap.matches(lightmapSettings))) {
+                std::cout << "Assando lightmap " << lightmap.width() << "x" << lightmap.height() << " ("
+                          << lightmap.chartCount() << " cartas)..." << std::endl;
+                occluders.build(wallTriangles);
+                lightmap.bake(occluders, lightmapSettings, &JobSystem::shared());
+                std::vector<char> data;
+                lightmap.serialize(data);
+                bakedScene.put("lightmap", std::move(data));
+                bakeChanged = !sourcePath.empty();
+            }
+            bakedLightingMode = 1;
+        } else {
+            const std::vector<char>* cached = bakedScene.find("ao");
+            if (!(cached && occlusion.deserialize(*cached, lightmap) && occlusion.matches(occlusionSettings))) {
+                std::cout << "Assando oclusão ambiente " << lightmap.width() << "x" << lightmap.height() << "..." << std::endl;
+                occluders.build(wallTriangles);
+                occlusion.bake(lightmap, occluders, occlusionSettings, &JobSystem::shared());
+                std::vector<char> data;
+                occlusion.serialize(data);
+                bakedScene.put("ao", std::move(data));
+                bakeChanged = !sourcePath.empty();
+            }
+            bakedLightingMode = 2;
+        }
+        if (bakedLightingMode) uploadBakedLighting();
+    }
+
+    if (bakeChanged && !bakedScene.save(bakePath, sourceStamp)) {
+        std::cout << "Aviso: não foi possível salvar " << bakePath << std::endl;
+    }
+}
+
+// ============================================================================
+// THREAD DE SIMULAÇÃO
+// ============================================================================
+void Game::StartSimulation()
+{
+    // Publica o estado inicial antes de a thread existir, para que o primeiro
+    // frame já tenha um snapshot válido
+    inputBuffer.writeBuffer().cameraFront = cameraFront;
+    inputBuffer.publish();
+    recordTickStart();
+    publishSnapshot(glfwGetTime());
+    snapshotBuffer.update();
+
+    simulationThread = std::thread(&Game::SimulationLoop, this);
+}
+
+void Game::StopSimulation()
+{
+    IsRunning = false;
+    if (simulationThread.joinable()) simulationThread.join();
+}
+
+void Game::UseGeneratedMaze(int width, int height, MazeAlgorithm algorithm, uint32_t seed)
+{
+    mazeWidth = width;
+    mazeHeight = height;
+    mazeAlgorithm = algorithm;
+    mazeSeed = seed;
+}
+
+void Game::UseWorldStreaming(bool enabled)
+{
+    streamWorld = enabled;
+}
+
+void Game::UseTileKit(bool enabled)
+{
+    useTileKit = enabled;
+}
+
+void Game::UseLightmaps(bool enabled)
+{
+    bakeLightmaps = enabled;
+}
+
+void Game::UseAmbientOcclusion(bool enabled)
+{
+    bakeGeneratedOcclusion = enabled;
+}
+
+void Game::SetSimulationRate(double ticksPerSecond, int maxCatchUpSteps)
+{
+    simulationClock.setTickRate(ticksPerSecond);
+    simulationClock.setMaxCatchUpSteps(maxCatchUpSteps);
+}
+
+void Game::SpawnCrowd(int count)
+{
+    crowd.clear();
+    if (count <= 0 || navGrid.empty() || navGrid.walkableCount() == 0) return;
+
+    // Um objetivo por baú (campo fixo, calculado uma vez) e um para o jogador
+    std::vector<glm::ivec2> chestCells;
+    for (const Interactable& item : interactables) {
+        if (item.chestIndex < 0) continue;
+        glm::ivec2 cell = navGrid.nearestWalkable(navGrid.cellAt((item.baseMesh.boundsMin() + item.baseMesh.boundsMax()) * 0.5f));
+        if (cell.x >= 0) chestCells.push_back(cell);
+    }
+    playerGoal = static_cast<int>(chestCells.size());
+    crowd.setGoalCount(playerGoal + 1);
+    for (int goal = 0; goal < playerGoal; ++goal) {
+        crowd.setGoalField(goal, flowFields.acquire(navGrid, chestCells[goal], &JobSystem::shared()));
+    }
+    playerGoalCell = glm::ivec2(-1);
+    playerFieldTimer = 0.0f;
+
+    // Posições sorteadas entre as células livres (semente fixa: mesma multidão sempre)
+    std::vector<int> freeCells;
+    for (int i = 0; i < navGrid.width() * navGrid.height(); ++i) {
+        if (navGrid.data()[i]) freeCells.push_back(i);
+    }
+    std::mt19937 rng(1234u);
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 pos = navGrid.cellCenter(navGrid.coords(freeCells[rng() % freeCells.size()]), 0.0f);
+        crowd.addAgent(glm::vec2(pos.x, pos.z), i % (playerGoal + 1));
+    }
+    std::cout << "Multidão: " << count << " NPCs, " << playerGoal + 1 << " objetivos" << std::endl;
+}
+
+void Game::SimulationLoop()
+{
+    const float tickDt = static_cast<float>(simulationClock.stepSeconds());
+    InputState input;
+    double lastTime = glfwGetTime();
+
+    while (IsRunning)
+    {
+        double now = glfwGetTime();
+        int steps = simulationClock.advance(now - lastTime);
+        lastTime = now;
+
+        // Todos os ticks usam o mesmo dt, independente da taxa de quadros
+        for (int i = 0; i < steps; ++i) {
+            if (inputBuffer.update()) input = inputBuffer.readBuffer();
+
+            // Cliques chegam pelo callback do mouse e são tratados aqui
+            for (int clicks = pendingInteractions.exchange(0); clicks > 0; --clicks) {
+                handleInteraction(input.cameraFront);
+            }
+
+            if (i == steps - 1) recordTickStart();
+            ProcessInput(input, tickDt);
+            Update(tickDt);
         }
+
+        // O instante do último tick é "agora" menos o tempo ainda acumulado
+        if (steps > 0) publishSnapshot(now - simulationClock.leftover());
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(simulationClock.timeUntilNextStep()));
     }
 }
 
+void Game::recordTickStart()
+{
+    GameSnapshot& snapshot = snapshotBuffer.writeBuffer();
+    snapshot.previousCameraPos = cameraPos;
+    snapshot.previousAnimationValues = animations.values();
+    snapshot.previousNpcPositions.resize(crowd.size());
+    for (size_t i = 0; i < crowd.size(); ++i) snapshot.previousNpcPositions[i] = glm::vec2(crowd.positionsX()[i], crowd.positionsZ()[i]);
+}
+
+void Game::publishSnapshot(double tickTime)
+{
+    GameSnapshot& snapshot = snapshotBuffer.writeBuffer();
+    snapshot.time = tickTime;
+    snapshot.tickDuration = simulationClock.stepSeconds();
+    snapshot.cameraPos = cameraPos;
+    snapshot.animationValues = animations.values(); // Cópia contígua, reaproveita a capacidade
+    if (snapshot.guidePathVersion != guidePathVersion) { // Idem: a linha só é copiada quando muda
+        snapshot.guidePath = guidePath;
+        snapshot.guidePathVersion = guidePathVersion;
+    }
+    if (snapshot.worldVersion != worldVersion) { // Cada buffer guarda a sua versão
+        snapshot.worldChunks = streamer.resident();
+        snapshot.worldVersion = worldVersion;
+    }
+    snapshot.npcPositions.resize(crowd.size());
+    for (size_t i = 0; i < crowd.size(); ++i) snapshot.npcPositions[i] = glm::vec2(crowd.positionsX()[i], crowd.positionsZ()[i]);
+    snapshot.chestsOpen.resize(chests.size());
+    for (size_t i = 0; i < chests.size(); ++i) snapshot.chestsOpen[i] = chests[i].isOpen;
+    snapshot.chestsOpenedCount = chestsOpenedCount;
+    snapshot.portalIsActive = portalIsActive;
+    snapshot.gameWon = gameWon;
+    snapshot.uiMessage = uiMessage;
+    snapshot.uiMessageTimer = uiMessageTimer;
+    snapshotBuffer.publish();
+}
+
 // ============================================================================
 // PROCESSAMENTO DE INPUT
 // ============================================================================
-void Game::ProcessInput(float dt)
+void Game::PollInput()
+{
+    // Sair do jogo com ESC ou ao fechar a janela
+    if (glfwGetKey(Window, GLFW_KEY_ESCAPE) == GLFW_PRESS || glfwWindowShouldClose(Window)) IsRunning = false;
+
+    InputState& input = inputBuffer.writeBuffer();
+    input.forward = glfwGetKey(Window, GLFW_KEY_W) == GLFW_PRESS;
+    input.backward = glfwGetKey(Window, GLFW_KEY_S) == GLFW_PRESS;
+    input.left = glfwGetKey(Window, GLFW_KEY_A) == GLFW_PRESS;
+    input.right = glfwGetKey(Window, GLFW_KEY_D) == GLFW_PRESS;
+    // G liga/desliga a orientação (só na borda de descida da tecla)
+    bool guideKeyDown = glfwGetKey(Window, GLFW_KEY_G) == GLFW_PRESS;
+    if (guideKeyDown && !guideKeyWasDown) guidanceRequested = !guidanceRequested;
+    guideKeyWasDown = guideKeyDown;
+    input.guidance = guidanceRequested;
+    input.cameraFront = cameraFront;
+    inputBuffer.publish();
+}
+
+void Game::ProcessInput(const InputState& input, float dt)
 {
-    // Sair do jogo com ESC
-    if (glfwGetKey(Window, GLFW_KEY_ESCAPE) == GLFW_PRESS) IsRunning = false;
+    guidanceEnabled = input.guidance;
     float cameraSpeed = 5.0f * dt;
     glm::vec3 moveDir(0.0f);
-    if (glfwGetKey(Window, GLFW_KEY_W) == GLFW_PRESS) moveDir += cameraFront;
-    if (glfwGetKey(Window, GLFW_KEY_S) == GLFW_PRESS) moveDir -= cameraFront;
-    if (glfwGetKey(Window, GLFW_KEY_A) == GLFW_PRESS) moveDir -= glm::normalize(glm::cross(cameraFront, cameraUp));
-    if (glfwGetKey(Window, GLFW_KEY_D) == GLFW_PRESS) moveDir += glm::normalize(glm::cross(cameraFront, cameraUp));
+    if (input.forward) moveDir += input.cameraFront;
+    if (input.backward) moveDir -= input.cameraFront;
+    if (input.left) moveDir -= glm::normalize(glm::cross(input.cameraFront, cameraUp));
+    if (input.right) moveDir += glm::normalize(glm::cross(input.cameraFront, cameraUp));
     moveDir.y = 0;
     if (glm::length(moveDir) > 0.0f) { moveDir = glm::normalize(moveDir) * cameraSpeed; }
-    if (!checkWallCollision(cameraPos + glm::vec3(moveDir.x, 0.0f, 0.0f))) { cameraPos.x += moveDir.x; }
-    if (!checkWallCollision(cameraPos + glm::vec3(0.0f, 0.0f, moveDir.z))) { cameraPos.z += moveDir.z; }
-    if (cameraPos.y < 1.5f) { cameraPos.y = 1.5f; }
-}
-
-bool Game::checkWallCollision(glm::vec3 futurePos)
-{
     float playerRadius = 0.4f;
-    for (const auto& wall : colliders) {
-        if (futurePos.x + playerRadius > wall->boundingBoxMin.x && futurePos.x - playerRadius < wall->boundingBoxMax.x &&
-            futurePos.y > wall->boundingBoxMin.y && futurePos.y < wall->boundingBoxMax.y &&
-            futurePos.z + playerRadius > wall->boundingBoxMin.z && futurePos.z - playerRadius < wall->boundingBoxMax.z)
-        { return true; }
+    // Chunk à frente ainda não carregado: espera em vez de atravessar paredes que não existem
+    const glm::vec3 reach(playerRadius + glm::length(moveDir));
+    if (!streamer.isResident(cameraPos - reach, cameraPos + reach)) return;
+    if (floorField.isClear(cameraPos, playerRadius + glm::length(moveDir))) {
+        // Caminho rápido: longe de qualquer parede, uma amostra do campo basta
+        cameraPos += moveDir;
+    } else {
+        // Perto das paredes: esfera varrida contra os triângulos, deslizando ao encostar
+        glm::vec3 nextPos = collisionWorld.slide(cameraPos, moveDir, playerRadius);
+        cameraPos.x = nextPos.x;
+        cameraPos.z = nextPos.z;
     }
-    return false;
+    if (cameraPos.y < 1.5f) { cameraPos.y = 1.5f; }
 }
 
 // ============================================================================
@@ -230,20 +862,122 @@ bool Game::checkWallCollision(glm::vec3 futurePos)
 // ============================================================================
 void Game::Update(float dt)
 {
-    // Verificar se a janela deve fechar
-    if (glfwWindowShouldClose(Window)) IsRunning = false;
-    
-    // Atualizar animações dos baús
-    for (auto& chest : chests) { 
-        chest->update(dt); 
+    // Mundo em chunks: a colisão só é refeita quando o conjunto residente muda
+    if (streamer.active() && streamer.update(cameraPos)) rebuildStreamedCollision();
+
+    // Atualizar animações: só as tampas e luzes em movimento custam algo
+    animations.update(dt);
+
+    // A caixa do baú acompanha a tampa; só os canais que mudaram neste tick
+    for (int channel : animations.changedChannels()) {
+        int owner = animations.userData(channel);
+        if (owner < 0) continue;
+        const Interactable& item = interactables[owner];
+        glm::vec3 lo, hi;
+        item.getBounds(animations.value(channel), lo, hi);
+        sceneQuery.move(item.queryHandle, lo, hi);
     }
     
+    updateGuidance();
+
+    // NPCs: o campo do jogador só é refeito quando ele muda de célula, no máximo 4x por segundo
+    if (crowd.size() > 0) {
+        playerFieldTimer -= dt;
+        glm::ivec2 playerCell = navGrid.nearestWalkable(navGrid.cellAt(cameraPos), 2);
+        if (playerCell.x >= 0 && playerCell != playerGoalCell && playerFieldTimer <= 0.0f) {
+            crowd.setGoalField(playerGoal, flowFields.acquire(navGrid, playerCell, &JobSystem::shared()));
+            playerGoalCell = playerCell;
+            playerFieldTimer = 0.25f;
+        }
+        crowd.update(dt, navGrid, floorField.empty() ? nullptr : &floorField, &JobSystem::shared());
+    }
+
     // Atualizar timer da mensagem da UI
     if (uiMessageTimer > 0.0f) { 
         uiMessageTimer -= dt; 
     }
 }
 
+void Game::updateGuidance()
+{
+    // Orçamento de tempo da busca e da extração do caminho por tick: mesmo no
+    // pior caso (alvo novo num labirinto enorme) elas se espalham por vários
+    // ticks; o resto dos 0,1 ms fica para refazer a linha
+    const auto GUIDANCE_BUDGET = std::chrono::microseconds(50);
+    const float GUIDE_HEIGHT = 0.1f;
+
+    // Alvos: baús ainda não abertos, ou o portal depois que ele se ativa
+    guidanceGoals.clear();
+    if (guidanceEnabled && !gameWon && !navGrid.empty()) {
+        for (const Interactable& item : interactables) {
+            const bool isPortal = item.chestIndex < 0;
+            if (isPortal != portalIsActive || (!isPortal && chests[item.chestIndex].hasBeenCounted)) continue;
+            glm::vec3 center = (item.baseMesh.boundsMin() + item.baseMesh.boundsMax()) * 0.5f;
+            glm::ivec2 cell = navGrid.nearestWalkable(navGrid.cellAt(center));
+            if (cell.x >= 0) guidanceGoals.push_back(cell);
+        }
+    }
+    if (guidanceGoals.empty()) {
+        if (!guidePath.empty()) {
+            guidePath.clear();
+            ++guidePathVersion;
+        }
+        if (!guidance.goals().empty()) guidance.reset(navGrid, guidanceGoals);
+        guidanceCells.clear();
+        guideCorners.clear();
+        return;
+    }
+    if (guidance.empty() || guidanceGoals != guidance.goals()) {
+        // Alvo novo (baú aberto, portal ativado): a linha antiga some até a busca terminar
+        guidance.reset(navGrid, guidanceGoals);
+        guidanceCells.clear();
+        guideCorners.clear();
+        if (!guidePath.empty()) {
+            guidePath.clear();
+            ++guidePathVersion;
+        }
+    }
+
+    // Só repara a busca; a linha só é refeita quando a busca avançou ou o
+    // jogador saiu dela
+    glm::ivec2 start = navGrid.nearestWalkable(navGrid.cellAt(cameraPos), 2);
+    if (start.x < 0 || !guidance.update(start, IncrementalPathfinder::Clock::now() + GUIDANCE_BUDGET)) return;
+    if (guidance.lastExpandedCount() == 0 && !guidanceCells.empty()) {
+        // Jogador andando sobre a linha: o resto do caminho continua ótimo, então
+        // só saem as células já percorridas (e os cantos delas) do fim dos vetores
+        const size_t count = guidanceCells.size(), window = std::min<size_t>(count, 4);
+        size_t onPath = count;
+        for (size_t i = count; i > count - window && onPath == count; --i) {
+            if (guidanceCells[i - 1] == start) onPath = i - 1;
+        }
+        if (onPath == count - 1) return; // Mesma célula
+        if (onPath < count) {
+            guidanceCells.resize(onPath + 1);
+            guidePath.pop_back();        // Posição antiga do jogador
+            while (!guideCorners.empty() && guideCorners.back() >= onPath) {
+                guideCorners.pop_back();
+                guidePath.pop_back();
+            }
+            guidePath.push_back(glm::vec3(cameraPos.x, GUIDE_HEIGHT, cameraPos.z));
+            ++guidePathVersion;
+            return;
+        }
+    }
+    guidanceCells.assign(guidance.path().rbegin(), guidance.path().rend());
+
+    // Só os cantos do caminho viram vértices; a célula do jogador dá lugar à
+    // posição dele (a linha é desenhada do alvo até o jogador)
+    guidePath.clear();
+    guideCorners.clear();
+    for (size_t i = 0; i + 1 < guidanceCells.size(); ++i) {
+        if (i > 0 && guidanceCells[i - 1] - guidanceCells[i] == guidanceCells[i] - guidanceCells[i + 1]) continue;
+        guideCorners.push_back(i);
+        guidePath.push_back(navGrid.cellCenter(guidanceCells[i], GUIDE_HEIGHT));
+    }
+    if (!guidanceCells.empty()) guidePath.push_back(glm::vec3(cameraPos.x, GUIDE_HEIGHT, cameraPos.z));
+    ++guidePathVersion;
+}
+
 // ============================================================================
 // RENDERIZAÇÃO PRINCIPAL
 // ============================================================================
@@ -253,71 +987,317 @@ void Game::Render()
     glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glEnable(GL_DEPTH_TEST);
-    SceneShader->use();
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)Width / (float)Height, 0.1f, 100.0f);
-    glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
-    SceneShader->setMat4("projection", projection);
-    SceneShader->setMat4("view", view);
-    
+
+    // Variantes pedidas no carregamento que o driver já terminou (sem esperar)
+    Programs->poll();
+
+    // ===== SNAPSHOT DA SIMULAÇÃO =====
+    // A renderização fica um tick atrás e interpola entre o último tick e o
+    // anterior (que vem no mesmo snapshot) pela fração do tick que já se passou
+    // desde o último publicado. O slot de leitura é só desta thread até o
+    // próximo update(): nada é copiado
+    snapshotBuffer.update();
+    const GameSnapshot& current = snapshotBuffer.readBuffer();
+    const std::vector<float>& previousValues = current.previousAnimationValues.size() == current.animationValues.size()
+                                                   ? current.previousAnimationValues : current.animationValues;
+    float alpha = static_cast<float>((glfwGetTime() - current.time) / current.tickDuration);
+    alpha = glm::clamp(alpha, 0.0f, 1.0f);
+    glm::vec3 renderCameraPos = glm::mix(current.previousCameraPos, current.cameraPos, alpha);
+
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)Width / (float)Height, 0.1f, VIEW_DISTANCE);
+    glm::mat4 view = glm::lookAt(renderCameraPos, renderCameraPos + cameraFront, cameraUp);
+
+    // Tampas dos baús: transformação local interpolada entre os dois últimos ticks;
+    // só as subárvores que mudaram têm a matriz do mundo recalculada
+    for (size_t i = 0; i < chests.size() && !current.animationValues.empty(); ++i) {
+        const int channel = chests[i].lidChannel;
+        float offset = glm::mix(previousValues[channel], current.animationValues[channel], alpha);
+        if (entities.localTransform(chests[i].lid)[3].y != offset) // Tampa parada não suja nada
+            entities.setLocalTransform(chests[i].lid, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, offset, 0.0f)));
+    }
+    entities.updateTransforms(&JobSystem::shared());
+
+    // ===== LUZES DOS BAÚS =====
+    // Todas as acesas, cada uma com o raio de corte tirado da sua atenuação
+    sceneLights.clear();
+    for (size_t i = 0; i < chests.size() && !current.animationValues.empty() && sceneLights.size() < MAX_SCENE_LIGHTS; ++i) {
+        const int channel = chests[i].lightChannel;
+        const float intensity = glm::mix(previousValues[channel], current.animationValues[channel], alpha);
+        if (intensity <= 0.0f) continue;
+        PointLight light;
+        light.position = chests[i].getLightWorldPosition(entities);
+        light.color = chests[i].lightColor;
+        light.intensity = intensity;
+        // Parâmetros de atenuação para luz com alcance maior
+        light.constant = 1.0f;
+        light.linear = 0.05f;
+        light.quadratic = 0.01f;
+        light.radius = lightCutoffRadius(light);
+        sceneLights.push_back(light);
+    }
+    // Todas vão para cada programa uma vez por quadro; cada draw recebe só a
+    // lista curta das que alcançam a sua caixa (o tamanho dela escolhe a
+    // variante), reenviada apenas quando muda em relação ao draw anterior
+    int lightIndices[MAX_OBJECT_LIGHTS] = {};
+    int boundIndices[MAX_OBJECT_LIGHTS] = {};
+    const LightUniforms* boundLights = nullptr;
+    auto setSceneLights = [&](Shader& shader) {
+        boundLights = &lightUniformsOf(shader);
+        std::fill(boundIndices, boundIndices + MAX_OBJECT_LIGHTS, -1); // Programa novo: a primeira lista sempre sobe
+        if (boundLights->indices < 0) return;                           // LIGHT_COUNT 0: a variante não tem as luzes
+        for (size_t i = 0; i < sceneLights.size(); ++i) {
+            const PointLight& light = sceneLights[i];
+            glUniform3fv(boundLights->position[i], 1, &light.position[0]);
+            glUniform3fv(boundLights->color[i], 1, &light.color[0]);
+            glUniform1f(boundLights->intensity[i], light.intensity);
+            glUniform1f(boundLights->constant[i], light.constant);
+            glUniform1f(boundLights->linear[i], light.linear);
+            glUniform1f(boundLights->quadratic[i], light.quadratic);
+            glUniform1f(boundLights->radius[i], light.radius);
+        }
+    };
+    // No programa do último setSceneLights
+    auto setObjectLights = [&](const int* indices, int count) {
+        if (count > 0 && !std::equal(indices, indices + count, boundIndices)) {
+            std::copy(indices, indices + count, boundIndices);
+            glUniform4iv(boundLights->indices, 1, boundIndices);
+        }
+    };
+
     // ===== CONFIGURAÇÃO DE ILUMINAÇÃO =====
-    SceneShader->setVec3("viewPos", cameraPos);
-    SceneShader->setVec3("objectColor", glm::vec3(0.6f, 0.5f, 0.4f)); // Cor base dos objetos
-    
-    // Luz direcional (simula luz solar)
-    SceneShader->setVec3("dirLight.direction", glm::vec3(-0.5f, -1.0f, -0.5f));
-    SceneShader->setVec3("dirLight.color", glm::vec3(0.8f, 0.8f, 0.8f));
-
-    Chest* activeLightChest = nullptr;
-    for (auto& chest : chests) {
-        if (chest->currentLightIntensity > 0.0f) {
-            activeLightChest = chest.get();
-            break; 
+    // Os mesmos parâmetros para todas as variantes de shader.frag (uniforms que
+    // a variante não tem são ignorados)
+    auto setSceneUniforms = [&](Shader& shader) {
+        shader.use();
+        shader.setMat4("projection", projection);
+        shader.setMat4("view", view);
+        shader.setVec3("viewPos", renderCameraPos);
+        shader.setVec3("objectColor", glm::vec3(0.6f, 0.5f, 0.4f)); // Cor base dos objetos
+        // Luz direcional (simula luz solar)
+        shader.setVec3("dirLight.direction", glm::vec3(-0.5f, -1.0f, -0.5f));
+        shader.setVec3("dirLight.color", glm::vec3(0.8f, 0.8f, 0.8f));
+        setSceneLights(shader);
+        shader.setInt("bakedTexture", 2);
+        Shadows->bind(shader, 3);
+    };
+
+    // Chunks do mundo que entraram ou saíram desde o último quadro (o kit de
+    // peças desenha as paredes sozinho)
+    if (!Tiles && uploadedWorldVersion != current.worldVersion) {
+        syncWorldChunks(current);
+        Shadows->invalidateStatic();
+    }
+    if (Tiles && Tiles->update(*mazeLayout, renderCameraPos)) Shadows->invalidateStatic();
+
+    // NPCs: posições interpoladas entre os dois últimos ticks (sombras e desenho)
+    if (!current.npcPositions.empty()) {
+        const bool interpolate = current.previousNpcPositions.size() == current.npcPositions.size();
+        npcInstances.resize(current.npcPositions.size());
+        for (size_t i = 0; i < npcInstances.size(); ++i) {
+            glm::vec2 p = interpolate ? glm::mix(current.previousNpcPositions[i], current.npcPositions[i], alpha) : current.npcPositions[i];
+            npcInstances[i] = glm::vec3(p.x, 0.0f, p.y);
         }
+        glBindBuffer(GL_ARRAY_BUFFER, npcInstanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, npcInstances.size() * sizeof(glm::vec3), nullptr, GL_STREAM_DRAW); // Descarta o buffer antigo
+        glBufferSubData(GL_ARRAY_BUFFER, 0, npcInstances.size() * sizeof(glm::vec3), npcInstances.data());
     }
-    if (activeLightChest) {
-        SceneShader->setVec3("chestLight.position", activeLightChest->getLightWorldPosition());
-        SceneShader->setVec3("chestLight.color", activeLightChest->lightColor);
-        SceneShader->setFloat("chestLight.intensity", activeLightChest->currentLightIntensity);
-        // Parâmetros de atenuação para luz com alcance maior
-        SceneShader->setFloat("chestLight.constant", 1.0f);
-        SceneShader->setFloat("chestLight.linear", 0.05f);
-        SceneShader->setFloat("chestLight.quadratic", 0.01f);
-    } else {
-        SceneShader->setFloat("chestLight.intensity", 0.0f);
+
+    // ===== SOMBRAS =====
+    // A camada estática de uma cascata só é redesenhada quando ela é recentrada
+    // (no máximo uma por quadro) ou a geometria muda; tampas e NPCs vão por cima
+    const std::vector<glm::mat4>& transforms = entities.denseTransforms();
+    const std::vector<RenderMesh>& meshes = entities.denseMeshes();
+    const std::vector<uint8_t>& flags = entities.denseFlags();
+    const std::vector<glm::vec3>& boundsMin = entities.denseBoundsMin();
+    const std::vector<glm::vec3>& boundsMax = entities.denseBoundsMax();
+    dynamicCasters.clear();
+    for (const Chest& chest : chests) {
+        const glm::vec3& lo = entities.boundsMin(chest.lid);
+        const glm::vec3& hi = entities.boundsMax(chest.lid);
+        const glm::vec4 center = entities.transform(chest.lid) * glm::vec4((lo.x + hi.x) * 0.5f, (lo.y + hi.y) * 0.5f, (lo.z + hi.z) * 0.5f, 1.0f);
+        dynamicCasters.push_back(glm::vec4(center.x, center.y, center.z, glm::length(hi - lo) * 0.5f));
+    }
+    for (const glm::vec3& p : npcInstances) dynamicCasters.push_back(glm::vec4(p.x, 0.8f, p.z, 0.9f)); // Caixa de 0,6 x 1,6 x 0,6
+    auto drawStaticShadows = [&](int cascade) {
+        if (Tiles) {
+            ShadowTileShader->use();
+            ShadowTileShader->setMat4("lightSpace", Shadows->lightSpace(cascade));
+            ShadowTileShader->setFloat("cellSize", Tiles->cellSize());
+            Tiles->draw();
+        }
+        ShadowShader->use();
+        ShadowShader->setMat4("lightSpace", Shadows->lightSpace(cascade));
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (meshes[i].vertexCount == 0 || (flags[i] & EntityFlag::Animated)) continue;
+            if (!Shadows->overlaps(cascade, boundsMin[i], boundsMax[i])) continue;
+            ShadowShader->setMat4("model", transforms[i]);
+            glBindVertexArray(meshes[i].vao);
+            glDrawArrays(GL_TRIANGLES, 0, meshes[i].vertexCount);
+        }
+        glBindVertexArray(0);
+    };
+    auto drawDynamicShadows = [&](int cascade) {
+        ShadowShader->use();
+        ShadowShader->setMat4("lightSpace", Shadows->lightSpace(cascade));
+        for (const Chest& chest : chests) {
+            const RenderMesh& mesh = entities.mesh(chest.lid);
+            if (mesh.vertexCount == 0) continue;
+            ShadowShader->setMat4("model", entities.transform(chest.lid));
+            glBindVertexArray(mesh.vao);
+            glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
+        }
+        if (!npcInstances.empty()) {
+            ShadowNpcShader->use();
+            ShadowNpcShader->setMat4("lightSpace", Shadows->lightSpace(cascade));
+            glBindVertexArray(npcVAO);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, npcVertexCount, static_cast<int>(npcInstances.size()));
+        }
+        glBindVertexArray(0);
+    };
+    Shadows->update(renderCameraPos, dynamicCasters, drawStaticShadows, drawDynamicShadows);
+
+    // ===== PEÇAS DO LABIRINTO (INSTANCIADAS) =====
+    // Paredes, pilares e piso de um labirinto gerado: um draw por peça
+    if (Tiles) {
+        // Um draw por peça para a janela inteira: as luzes que alcançam a vista
+        const int count = assignLights(sceneLights, renderCameraPos - glm::vec3(VIEW_DISTANCE), renderCameraPos + glm::vec3(VIEW_DISTANCE), lightIndices);
+        Shader& tileShader = litProgram("shaders/tile.vert", 0, count);
+        setSceneUniforms(tileShader);
+        tileShader.setFloat("cellSize", Tiles->cellSize());
+        setObjectLights(lightIndices, count);
+        Tiles->draw();
     }
 
     // ===== RENDERIZAÇÃO DOS OBJETOS DA CENA =====
-    for (auto const& [name, object] : sceneObjects) {
-        SceneShader->setMat4("model", object.modelMatrix);
-        
-        // Renderização com cores sólidas (sem texturas)
-        SceneShader->setInt("useTexture", 0);
-        
-        glBindVertexArray(object.vao);
-        glDrawArrays(GL_TRIANGLES, 0, object.vertexCount);
+    // Cada objeto usa a menor variante de shader.frag que o atende (luz assada
+    // e quantas luzes de baú o alcançam); os draws são agrupados por variante
+    // para trocar de programa só algumas vezes por quadro
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, bakedLightingTexture);
+    glActiveTexture(GL_TEXTURE0);
+    // Percurso linear pelos arrays densos do EntityStore
+    sceneDraws.clear();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (meshes[i].vertexCount == 0) continue; // Entidades sem geometria (ex.: luzes)
+        SceneDraw draw;
+        draw.entity = static_cast<uint32_t>(i);
+        draw.bakedLighting = (flags[i] & EntityFlag::Lightmapped) ? bakedLightingMode : 0;
+        // As transformações só transladam: a caixa local desloca junto
+        const glm::vec3 offset(transforms[i][3].x, transforms[i][3].y, transforms[i][3].z);
+        draw.lightCount = assignLights(sceneLights, boundsMin[i] + offset, boundsMax[i] + offset, draw.lights);
+        sceneDraws.push_back(draw);
+    }
+    std::stable_sort(sceneDraws.begin(), sceneDraws.end(), [](const SceneDraw& a, const SceneDraw& b) {
+        return a.bakedLighting != b.bakedLighting ? a.bakedLighting < b.bakedLighting : a.lightCount < b.lightCount;
+    });
+    Shader* sceneShader = nullptr;
+    for (size_t d = 0; d < sceneDraws.size(); ++d) {
+        const SceneDraw& draw = sceneDraws[d];
+        if (d == 0 || draw.bakedLighting != sceneDraws[d - 1].bakedLighting || draw.lightCount != sceneDraws[d - 1].lightCount) {
+            sceneShader = &litProgram("shaders/shader.vert", draw.bakedLighting, draw.lightCount);
+            setSceneUniforms(*sceneShader);
+        }
+        setObjectLights(draw.lights, draw.lightCount);
+        sceneShader->setMat4("model", transforms[draw.entity]);
+        glBindVertexArray(meshes[draw.entity].vao);
+        glDrawArrays(GL_TRIANGLES, 0, meshes[draw.entity].vertexCount);
     }
     
+    // ===== NPCs (INSTANCIADOS) =====
+    // Instâncias já enviadas antes das sombras; um único draw para todos
+    if (!current.npcPositions.empty()) {
+        glm::vec3 npcMin(std::numeric_limits<float>::max()), npcMax(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& p : npcInstances) { npcMin = glm::min(npcMin, p); npcMax = glm::max(npcMax, p); }
+        const int count = assignLights(sceneLights, npcMin + glm::vec3(-0.3f, 0.0f, -0.3f), npcMax + glm::vec3(0.3f, 1.6f, 0.3f), lightIndices);
+        Shader& npcShader = litProgram("shaders/npc.vert", 0, count);
+        setSceneUniforms(npcShader);
+        npcShader.setVec3("objectColor", glm::vec3(0.3f, 0.45f, 0.8f));
+        setObjectLights(lightIndices, count);
+        glBindVertexArray(npcVAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, npcVertexCount, static_cast<int>(npcInstances.size()));
+        glBindVertexArray(0);
+    }
+
+    // ===== LINHA DE ORIENTAÇÃO =====
+    // Um único draw; o VBO só é reenviado quando a simulação publica uma linha nova
+    if (uploadedGuideVersion != current.guidePathVersion) {
+        glBindBuffer(GL_ARRAY_BUFFER, guideVBO);
+        glBufferData(GL_ARRAY_BUFFER, current.guidePath.size() * sizeof(glm::vec3), current.guidePath.data(), GL_DYNAMIC_DRAW);
+        guideVertexCount = static_cast<int>(current.guidePath.size());
+        uploadedGuideVersion = current.guidePathVersion;
+    }
+    if (guideVertexCount >= 2) {
+        DebugShader->use();
+        DebugShader->setMat4("projection", projection);
+        DebugShader->setMat4("view", view);
+        DebugShader->setMat4("model", glm::mat4(1.0f));
+        DebugShader->setVec4("debugColor", glm::vec4(0.3f, 1.0f, 0.6f, 0.8f));
+        glBindVertexArray(guideVAO);
+        glDrawArrays(GL_LINE_STRIP, 0, guideVertexCount);
+        glBindVertexArray(0);
+    }
+
     // ===== INTERFACE DO USUÁRIO =====
     glDisable(GL_DEPTH_TEST);
+
+    // Minimapa: a névoa só sobe quando a câmera muda de célula; dois draws
+    if (Map) {
+        Map->update(renderCameraPos);
+        Map->draw(renderCameraPos, cameraFront, current.chestsOpen, current.portalIsActive, static_cast<float>(Width), static_cast<float>(Height));
+    }
     
     // Contador de baús abertos
-    std::string counterText = "Baús abertos: " + std::to_string(chestsOpenedCount) + "/" + std::to_string(CHESTS_TO_WIN);
+    std::string counterText = "Baús abertos: " + std::to_string(current.chestsOpenedCount) + "/" + std::to_string(CHESTS_TO_WIN);
     Text->RenderText(counterText, 25.0f, 25.0f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
-    if (portalIsActive && !gameWon) {
+    if (current.portalIsActive && !current.gameWon) {
         if (fmod((float)glfwGetTime(), 1.0f) > 0.5f) {
             Text->RenderText("Procure o portal!", (Width / 2.0f) - 200.0f, Height - 50.0f, 0.7f, glm::vec3(0.3f, 1.0f, 0.3f));
         }
     }
-    if (gameWon) {
+    if (current.gameWon) {
         Text->RenderText("FIM", (Width / 2.0f) - 70.0f, Height / 2.0f, 2.0f, glm::vec3(1.0f, 0.9f, 0.2f));
     }
-    else if (uiMessageTimer > 0.0f) {
-        Text->RenderText(uiMessage, (Width / 2.0f) - 300.0f, Height / 2.0f, 0.7f, glm::vec3(1.0f, 0.2f, 0.2f));
+    else if (current.uiMessageTimer > 0.0f) {
+        Text->RenderText(current.uiMessage, (Width / 2.0f) - 300.0f, Height / 2.0f, 0.7f, glm::vec3(1.0f, 0.2f, 0.2f));
     }
     glfwSwapBuffers(Window);
     glfwPollEvents();
 }
 
+// Diferença entre os chunks publicados e os que estão na GPU. Os envios por
+// quadro são limitados; o restante fica para os próximos quadros.
+void Game::syncWorldChunks(const GameSnapshot& snapshot)
+{
+    const int MAX_UPLOADS_PER_FRAME = 4;
+    auto published = [&](const glm::ivec2& coord) {
+        for (const auto& chunk : snapshot.worldChunks) if (chunk->coord == coord) return true;
+        return false;
+    };
+    for (size_t i = 0; i < streamedMeshes.size();) {
+        if (published(streamedMeshes[i].coord)) { ++i; continue; }
+        RenderMesh& mesh = entities.mesh(streamedMeshes[i].entity);
+        glDeleteBuffers(1, &mesh.vbo);
+        glDeleteVertexArrays(1, &mesh.vao);
+        entities.destroy(streamedMeshes[i].entity);
+        streamedMeshes[i] = streamedMeshes.back();
+        streamedMeshes.pop_back();
+    }
+
+    int uploads = 0;
+    for (const auto& chunk : snapshot.worldChunks) {
+        bool uploaded = false;
+        for (const StreamedMesh& streamed : streamedMeshes) uploaded |= streamed.coord == chunk->coord;
+        if (uploaded) continue;
+        if (uploads++ == MAX_UPLOADS_PER_FRAME) return;   // A versão fica pendente: continua no próximo quadro
+        Entity entity = entities.create();
+        entities.mesh(entity) = uploadMesh(chunk->vertexData);
+        entities.boundsMin(entity) = chunk->boundsMin;
+        entities.boundsMax(entity) = chunk->boundsMax;
+        streamedMeshes.push_back({chunk->coord, entity});
+    }
+    uploadedWorldVersion = snapshot.worldVersion;
+}
+
 void Game::FramebufferSizeCallback(int width, int height) { glViewport(0, 0, width, height); }
 
 void Game::MouseCallback(double xpos, double ypos)
@@ -343,56 +1323,71 @@ void Game::MouseCallback(double xpos, double ypos)
 
 void Game::MouseButtonCallback(int button, int action, int mods)
 {
+    // A interação altera o estado do jogo, então é repassada à simulação
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        handleInteraction();
+        pendingInteractions.fetch_add(1);
     }
 }
 
-void Game::handleInteraction()
+void Game::handleInteraction(const glm::vec3& viewDir)
 {
     if (gameWon) return;
     const float interaction_range = 3.5f;
-    if (portalObject != nullptr) {
-        glm::vec3 portalCenter = (portalObject->boundingBoxMin + portalObject->boundingBoxMax) / 2.0f;
-        float distanceToPortal = glm::distance(cameraPos, portalCenter);
-        if (distanceToPortal < interaction_range) {
-            if (chestsOpenedCount >= CHESTS_TO_WIN) {
-                gameWon = true;
-            } else {
-                int remaining = CHESTS_TO_WIN - chestsOpenedCount;
-                uiMessage = "Faltam " + std::to_string(remaining) + " baus para abrir o portal!";
-                uiMessageTimer = 3.0f;
-            }
-            return;
+
+    // Paredes na frente encurtam o alcance: não se abre baú através delas
+    float range = interaction_range;
+    collisionWorld.raycast(cameraPos, viewDir, range);
+
+    // Raio na direção do olhar; só a geometria dos alvos cruzados é testada
+    int target = sceneQuery.raycast(cameraPos, viewDir, range, QueryTag::Chest | QueryTag::Portal, [&](int id, float best) {
+        const Interactable& item = interactables[id];
+        float distance = best;
+        bool hit = item.baseMesh.raycast(cameraPos, viewDir, distance);
+        if (item.chestIndex >= 0) {
+            // A tampa só sobe: desloca o raio em vez de mover a malha
+            glm::vec3 lidOrigin = cameraPos - glm::vec3(0.0f, animations.value(chests[item.chestIndex].lidChannel), 0.0f);
+            hit |= item.lidMesh.raycast(lidOrigin, viewDir, distance);
         }
-    }
-    float closest_distance = std::numeric_limits<float>::max();
-    Chest* target_chest = nullptr;
-    if (chests.empty()) { return; }
-    for (auto& chest : chests) {
-        glm::vec3 chestCenter = (chest->base->boundingBoxMin + chest->base->boundingBoxMax) / 2.0f;
-        float distance = glm::distance(cameraPos, chestCenter);
-        if (distance < closest_distance) {
-            closest_distance = distance;
-            target_chest = chest.get();
+        return hit ? distance : -1.0f;
+    });
+    if (target < 0) return;
+
+    if (interactables[target].chestIndex < 0) {
+        if (chestsOpenedCount >= CHESTS_TO_WIN) {
+            gameWon = true;
+        } else {
+            int remaining = CHESTS_TO_WIN - chestsOpenedCount;
+            uiMessage = "Faltam " + std::to_string(remaining) + " baus para abrir o portal!";
+            uiMessageTimer = 3.0f;
         }
+        return;
     }
-    if (target_chest && closest_distance < interaction_range) {
-        if (target_chest->toggleOpen()) {
-            chestsOpenedCount++;
-            if (chestsOpenedCount >= CHESTS_TO_WIN) {
-                portalIsActive = true;
-            }
+    if (chests[interactables[target].chestIndex].toggleOpen(animations)) {
+        chestsOpenedCount++;
+        if (chestsOpenedCount >= CHESTS_TO_WIN) {
+            portalIsActive = true;
         }
     }
 }
 
+// --- Implementação dos métodos da struct Interactable ---
+void Interactable::getBounds(float lidOffsetY, glm::vec3& boundsMin, glm::vec3& boundsMax) const
+{
+    boundsMin = baseMesh.boundsMin();
+    boundsMax = baseMesh.boundsMax();
+    if (!lidMesh.empty()) {
+        glm::vec3 lift(0.0f, lidOffsetY, 0.0f);
+        boundsMin = glm::min(boundsMin, lidMesh.boundsMin() + lift);
+        boundsMax = glm::max(boundsMax, lidMesh.boundsMax() + lift);
+    }
+}
+
 // --- Implementação dos métodos da struct Chest ---
-bool Chest::toggleOpen()
+bool Chest::toggleOpen(AnimationSystem& animations)
 {
     isOpen = !isOpen;
-    targetLidOffsetY = isOpen ? 0.7f : 0.0f;
-    isAnimating = true;
+    animations.animateTo(lidChannel, isOpen ? OPEN_LID_OFFSET : 0.0f, animationSpeed);
+    animations.animateTo(lightChannel, isOpen ? OPEN_LIGHT_INTENSITY : 0.0f, lightFadeSpeed);
     if (isOpen && !hasBeenCounted) {
         hasBeenCounted = true;
         return true;
@@ -400,50 +1395,10 @@ bool Chest::toggleOpen()
     return false;
 }
 
-void Chest::update(float dt)
-{
-    // Atualizar animação da tampa
-    if (isAnimating) {
-        if (std::abs(lidOffsetY - targetLidOffsetY) < 0.01f) { 
-            lidOffsetY = targetLidOffsetY; 
-            isAnimating = false; 
-        }
-        else if (lidOffsetY < targetLidOffsetY) { 
-            lidOffsetY += animationSpeed * dt; 
-        }
-        else { 
-            lidOffsetY -= animationSpeed * dt; 
-        }
-        lid->modelMatrix = base->modelMatrix;
-        lid->modelMatrix = glm::translate(lid->modelMatrix, glm::vec3(0.0f, lidOffsetY, 0.0f));
-    }
-    
-    // Atualizar intensidade da luz baseada no estado de abertura
-    if (isOpen) {
-        targetLightIntensity = 2.5f; // Luz forte quando aberto
-    } else {
-        targetLightIntensity = 0.0f; // Sem luz quando fechado
-    }
-    
-    // Interpolar intensidade da luz suavemente
-    if (currentLightIntensity < targetLightIntensity) {
-        currentLightIntensity += lightFadeSpeed * dt;
-        if (currentLightIntensity > targetLightIntensity) {
-            currentLightIntensity = targetLightIntensity;
-        }
-    } else if (currentLightIntensity > targetLightIntensity) {
-        currentLightIntensity -= lightFadeSpeed * dt;
-        if (currentLightIntensity < targetLightIntensity) {
-            currentLightIntensity = targetLightIntensity;
-        }
-    }
-}
-
-glm::vec3 Chest::getLightWorldPosition() const
+glm::vec3 Chest::getLightWorldPosition(const EntityStore& entities) const
 {
-    glm::vec3 chestCenter = (base->boundingBoxMin + base->boundingBoxMax) / 2.0f;
-    // Posicionar a luz no centro do baú, ligeiramente acima
-    return chestCenter + glm::vec3(0.0f, 0.3f, 0.0f);
+    // A entidade da luz fica no centro do baú, ligeiramente acima, presa à base
+    return glm::vec3(entities.transform(light)[3]);
 }
 
 
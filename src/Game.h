@@ -10,41 +10,100 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <atomic>
+#include <thread>
 
 #include "Shader.h"
 #include "TextRenderer.h"
+#include "TripleBuffer.h"
+#include "FixedTimestep.h"
+#include "CollisionWorld.h"
+#include "DistanceField.h"
+#include "HierarchicalPathfinder.h"
+#include "IncrementalPathfinder.h"
+#include "FlowField.h"
+#include "CrowdSystem.h"
+#include "NavGrid.h"
+#include "BakedScene.h"
+#include "SceneQuery.h"
+#include "EntityStore.h"
+#include "AnimationSystem.h"
+#include "MazeGenerator.h"
+#include "WorldStreamer.h"
+#include "TileRenderer.h"
+#include "Minimap.h"
+#include "Lightmap.h"
+#include "ShadowCascades.h"
+#include "LightAssignment.h"
 
 // ============================================================================
 // ESTRUTURAS DE DADOS DA CENA
 // ============================================================================
 
-// Representa um objeto 3D na cena
-struct SceneObject {
-    GLuint vao = 0;                    // Vertex Array Object
-    int vertexCount = 0;               // Número de vértices
-    glm::mat4 modelMatrix = glm::mat4(1.0f);  // Matriz de transformação
-    glm::vec3 boundingBoxMin, boundingBoxMax; // Bounding box para colisão
-};
-
 // Representa um baú com animação e iluminação
 struct Chest {
-    SceneObject* base = nullptr;       // Parte inferior do baú
-    SceneObject* lid = nullptr;        // Tampa do baú
+    Entity base;                       // Parte inferior do baú
+    Entity lid;                        // Tampa do baú (filha da base)
+    Entity light;                      // Ponto de luz preso à base
     std::string base_name;             // Nome do objeto base
     bool hasBeenCounted = false;       // Se já foi contado para vitória
-    bool isAnimating = false;          // Se está em animação
     bool isOpen = false;               // Estado de abertura
-    float lidOffsetY = 0.0f;           // Offset atual da tampa
-    float targetLidOffsetY = 0.0f;     // Offset alvo da tampa
+    int lidChannel = -1;               // Canal do AnimationSystem com o offset da tampa
+    int lightChannel = -1;             // Canal do AnimationSystem com a intensidade da luz
     float animationSpeed = 2.0f;       // Velocidade da animação
     glm::vec3 lightColor = glm::vec3(1.0f, 0.9f, 0.6f); // Cor dourada da luz
-    float currentLightIntensity = 0.0f; // Intensidade atual da luz
-    float targetLightIntensity = 0.0f;  // Intensidade alvo da luz
     float lightFadeSpeed = 3.0f;       // Velocidade do fade da luz
+    static constexpr float OPEN_LID_OFFSET = 0.7f; // Altura da tampa aberta
+    static constexpr float OPEN_LIGHT_INTENSITY = 2.5f; // Luz forte quando aberto
+
+    bool toggleOpen(AnimationSystem& animations); // Alternar estado e acordar as animações
+    glm::vec3 getLightWorldPosition(const EntityStore& entities) const; // Posição da luz no mundo
+};
+
+// Alvo do raio de interação, com a geometria exata de cada parte
+struct Interactable {
+    int chestIndex = -1;               // Índice em Game::chests; -1 = portal
+    MeshBVH baseMesh;                  // Base do baú ou o próprio portal
+    MeshBVH lidMesh;                   // Tampa em repouso (só baús)
+    int queryHandle = -1;              // Cadastro em Game::sceneQuery
 
-    bool toggleOpen();                 // Alternar estado de abertura
-    void update(float dt);             // Atualizar animação
-    glm::vec3 getLightWorldPosition() const; // Posição da luz no mundo
+    // Caixa atual: base mais a tampa subida de `lidOffsetY`
+    void getBounds(float lidOffsetY, glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+};
+
+// ============================================================================
+// ESTADO COMPARTILHADO ENTRE AS THREADS
+// ============================================================================
+
+// Entrada amostrada pela thread de renderização (GLFW só pode ser consultado nela)
+struct InputState {
+    bool forward = false, backward = false, left = false, right = false;
+    bool guidance = false;                   // Caminho até o próximo objetivo ligado (tecla G)
+    glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+};
+
+// Estado imutável publicado pela simulação a cada tick
+struct GameSnapshot {
+    double time = 0.0;                       // Instante do último tick simulado (glfwGetTime)
+    double tickDuration = 1.0 / 60.0;        // Duração de um tick em segundos
+    glm::vec3 cameraPos = glm::vec3(0.0f);
+    std::vector<float> animationValues;      // Valor de cada canal do AnimationSystem
+    std::vector<glm::vec3> guidePath;        // Linha de orientação (vazia = desligada)
+    std::vector<glm::vec2> npcPositions;     // Posição XZ de cada NPC
+    // O mesmo estado no fim do tick anterior ao último: a renderização interpola
+    // sempre entre dois ticks consecutivos, mesmo quando perde snapshots
+    glm::vec3 previousCameraPos = glm::vec3(0.0f);
+    std::vector<float> previousAnimationValues;
+    std::vector<glm::vec2> previousNpcPositions;
+    unsigned int guidePathVersion = 0;       // Muda sempre que a linha muda
+    std::vector<std::shared_ptr<const WorldChunk>> worldChunks; // Chunks residentes (mundo em streaming)
+    unsigned int worldVersion = 0;           // Muda sempre que o conjunto residente muda
+    std::vector<uint8_t> chestsOpen;         // 1 = baú aberto (marcadores do minimapa)
+    int chestsOpenedCount = 0;
+    bool portalIsActive = false;
+    bool gameWon = false;
+    std::string uiMessage;
+    float uiMessageTimer = 0.0f;
 };
 
 // ============================================================================
@@ -56,12 +115,20 @@ public:
     Game(unsigned int width, unsigned int height);
     ~Game();
 
+    void UseGeneratedMaze(int width, int height, MazeAlgorithm algorithm, uint32_t seed); // Antes de Init: dispensa o OBJ
+    void UseWorldStreaming(bool enabled); // Antes de Init: labirinto gerado carregado em chunks, sob demanda
+    void UseTileKit(bool enabled);     // Antes de Init: labirinto gerado desenhado com peças instanciadas
+    void UseLightmaps(bool enabled);   // Antes de Init: lightmap completo no lugar da oclusão ambiente
+    void UseAmbientOcclusion(bool enabled); // Antes de Init: oclusão ambiente também no labirinto gerado (sem cache)
     void Init();
-    void ProcessInput(float dt);
-    void Update(float dt);
+    void SetSimulationRate(double ticksPerSecond, int maxCatchUpSteps); // Antes de StartSimulation
+    void SpawnCrowd(int count);        // NPCs que vagam entre os baús e o jogador (antes de StartSimulation)
+    void StartSimulation();            // Inicia a thread de simulação
+    void StopSimulation();             // Encerra e aguarda a thread de simulação
+    void PollInput();                  // Amostra o teclado (thread de renderização)
     void Render();
 
-    bool IsRunning;
+    std::atomic<bool> IsRunning;
 
     // Funções de Callback para o GLFW
     void FramebufferSizeCallback(int width, int height);
@@ -72,8 +139,36 @@ private:
     // Variáveis da Janela e Renderização
     unsigned int Width, Height;
     GLFWwindow* Window;
-    Shader* SceneShader = nullptr;
+    ShaderCache* Programs = nullptr;   // Dono de todos os programas (os Shader* abaixo são dele)
+    Shader* DebugShader = nullptr;
+    TileRenderer* Tiles = nullptr;     // Só com o kit de peças (labirinto gerado)
+    static constexpr float VIEW_DISTANCE = 100.0f; // Plano distante da projeção
     TextRenderer* Text = nullptr;
+    Shader* MinimapShader = nullptr;
+    Shader* MarkerShader = nullptr;
+    Minimap* Map = nullptr;            // Planta com névoa de guerra no canto da tela
+    Shader* ShadowShader = nullptr;    // Profundidade das malhas, das peças e dos NPCs
+    Shader* ShadowTileShader = nullptr;
+    Shader* ShadowNpcShader = nullptr;
+    ShadowCascades* Shadows = nullptr;
+    std::vector<glm::vec4> dynamicCasters; // Esferas das tampas e dos NPCs (rascunho por quadro)
+    std::vector<PointLight> sceneLights;   // Luzes dos baús acesas neste quadro
+    // Draws da cena agrupados por variante de shader.frag (rascunho por quadro)
+    struct SceneDraw {
+        uint32_t entity;               // Índice denso no EntityStore
+        int bakedLighting;             // BAKED_LIGHTING da variante
+        int lightCount;                // LIGHT_COUNT da variante
+        int lights[MAX_OBJECT_LIGHTS]; // Índices em sceneLights
+    };
+    std::vector<SceneDraw> sceneDraws;
+    // Locais dos uniforms de luz numa variante de shader.frag, consultados uma
+    // vez por programa: o quadro só envia valores, sem montar nomes
+    struct LightUniforms {
+        GLint indices = -1;            // pointLightIndices; -1 = variante sem luzes de baú
+        GLint position[MAX_SCENE_LIGHTS], color[MAX_SCENE_LIGHTS], intensity[MAX_SCENE_LIGHTS];
+        GLint constant[MAX_SCENE_LIGHTS], linear[MAX_SCENE_LIGHTS], quadratic[MAX_SCENE_LIGHTS], radius[MAX_SCENE_LIGHTS];
+    };
+    std::map<unsigned int, LightUniforms> lightUniforms; // Chave: ID do programa
 
     // Estado do Jogo
     int chestsOpenedCount = 0;
@@ -83,6 +178,14 @@ private:
     std::string uiMessage;
     float uiMessageTimer = 0.0f;
 
+    // Labirinto gerado (largura 0 = carregar models/lab.obj)
+    int mazeWidth = 0, mazeHeight = 0;
+    MazeAlgorithm mazeAlgorithm = MazeAlgorithm::Backtracker;
+    uint32_t mazeSeed = 1;
+    bool streamWorld = false;
+    bool useTileKit = false;
+    std::shared_ptr<const MazeLayout> mazeLayout; // Imutável: lido pelas duas threads e pelo streaming
+
     // Câmera
     glm::vec3 cameraPos   = glm::vec3(9.0f, 1.5f, 20.0f);
     glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
@@ -93,16 +196,90 @@ private:
     bool firstMouse = true;
 
     // Objetos da Cena
-    std::map<std::string, SceneObject> sceneObjects;
-    std::vector<SceneObject*> colliders;
-    SceneObject* portalObject = nullptr;
-    std::vector<std::unique_ptr<Chest>> chests;
-    
+    EntityStore entities;              // Transformações, caixas e malhas em arrays densos
+    std::vector<Entity> colliders;
+    CollisionWorld collisionWorld;     // BVH por collider + grade XZ como fase ampla
+    DistanceField floorField;          // SDF da planta baixa: caminho rápido de movimento
+    NavGrid navGrid;                   // Células caminháveis do labirinto (A*)
+    HierarchicalPathfinder navigation; // HPA* sobre a grade: caminhos longos
+    BakedScene bakedScene;             // Dados pré-calculados guardados ao lado do OBJ
+    // Luz estática de paredes e piso, num atlas com as UVs de Lightmap::unwrap:
+    // oclusão ambiente (padrão) ou o lightmap completo (RGBM)
+    Lightmap lightmap;
+    AmbientOcclusion occlusion;
+    unsigned int bakedLightingTexture = 0;
+    int bakedLightingMode = 0;         // BAKED_LIGHTING de shader.frag na estática: 1 = lightmap, 2 = oclusão
+    bool bakeLightmaps = false;
+    bool bakeGeneratedOcclusion = false; // O OBJ sempre tem oclusão (fica no .bake); o labirinto gerado só se pedida
+    std::vector<size_t> colliderFirstVertex; // Início de cada collider em wallTriangles (UVs do lightmap)
+    std::vector<Chest> chests;
+    AnimationSystem animations;        // Tampas e luzes em movimento (thread de simulação)
+    std::vector<Interactable> interactables;
+    SceneQuery sceneQuery;             // Proximidade e raio de seleção dos objetos marcados
+    WorldStreamer streamer;            // Chunks do labirinto gerado (thread de simulação)
+    unsigned int worldVersion = 0;
+
+    // Orientação até o baú fechado mais próximo (ou o portal), reparada a cada tick
+    IncrementalPathfinder guidance;    // Thread de simulação
+    bool guidanceEnabled = false;
+    std::vector<glm::ivec2> guidanceGoals;
+    std::vector<glm::ivec2> guidanceCells;   // Do alvo até o jogador: as células percorridas saem do fim
+    std::vector<glm::vec3> guidePath;        // Cantos (do alvo para o jogador) e, por último, o jogador
+    std::vector<size_t> guideCorners;        // Célula de cada canto de guidePath
+    unsigned int guidePathVersion = 0;
+    // NPCs: campos de fluxo por alvo (baús e jogador) e agentes em SoA
+    FlowFieldCache flowFields;
+    CrowdSystem crowd;
+    int playerGoal = -1;               // Objetivo da multidão que segue o jogador
+    glm::ivec2 playerGoalCell = glm::ivec2(-1);
+    float playerFieldTimer = 0.0f;     // Limita a frequência de recálculo do campo do jogador
+    // Lado da renderização: tecla e linha na GPU
+    bool guidanceRequested = false, guideKeyWasDown = false;
+    unsigned int guideVAO = 0, guideVBO = 0;
+    unsigned int uploadedGuideVersion = 0;
+    int guideVertexCount = 0;
+    // NPCs na GPU: uma caixa e um buffer de posições por instância
+    unsigned int npcVAO = 0, npcMeshVBO = 0, npcInstanceVBO = 0;
+    int npcVertexCount = 0;
+    std::vector<glm::vec3> npcInstances;
+    // Chunks do mundo já enviados à GPU, cada um como uma entidade
+    struct StreamedMesh {
+        glm::ivec2 coord;
+        Entity entity;
+    };
+    std::vector<StreamedMesh> streamedMeshes;
+    unsigned int uploadedWorldVersion = 0;
+
+    // Simulação desacoplada da renderização
+    FixedTimestep simulationClock{60.0, 5};     // 60 ticks/s, no máximo 5 de recuperação
+    std::thread simulationThread;
+    TripleBuffer<InputState> inputBuffer;       // Renderização -> simulação
+    TripleBuffer<GameSnapshot> snapshotBuffer;  // Simulação -> renderização
+    std::atomic<int> pendingInteractions{0};    // Cliques ainda não processados
 
     // Funções privadas da classe Game
     void loadScene(const std::string& path);
-    bool checkWallCollision(glm::vec3 futurePos);
-    void handleInteraction();
+    void generateScene(float cellSize, bool streamed);
+    void rebuildStreamedCollision();
+    void syncWorldChunks(const GameSnapshot& snapshot);
+    void addCollider(Entity entity, const std::vector<glm::vec3>& triangles, std::vector<glm::vec3>& wallTriangles);
+    void addPortal(const std::vector<glm::vec3>& triangles);
+    void addChest(Entity base, Entity lid, const std::string& name,
+                  const std::vector<glm::vec3>& baseTriangles, const std::vector<glm::vec3>& lidTriangles);
+    void createMinimap(float mazeCellSize);
+    void uploadBakedLighting();
+    // Variante mínima de shader.frag (sem textura nem PBR) sobre `vertexPath`;
+    // espera o driver só se essa variante ainda estiver compilando
+    Shader& litProgram(const char* vertexPath, int bakedLighting, int lightCount);
+    const LightUniforms& lightUniformsOf(const Shader& shader);
+    void finishScene(const std::vector<glm::vec3>& wallTriangles, const std::vector<glm::vec3>& floorTriangles, const std::string& sourcePath);
+    void SimulationLoop();
+    void ProcessInput(const InputState& input, float dt);
+    void Update(float dt);
+    void updateGuidance();
+    void recordTickStart();            // Estado antes do último tick do lote, no snapshot em montagem
+    void publishSnapshot(double tickTime);
+    void handleInteraction(const glm::vec3& viewDir);
 };
 
 // Funções "Wrapper" para que o GLFW, que é uma biblioteca em C, possa chamar os métodos da nossa classe C++
@@ -0,0 +1,81 @@
+#include "GridPathfinder.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float DIAGONAL_COST = 1.41421356f;
+    const int DIRECTIONS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+}
+
+float GridPathfinder::octile(const glm::ivec2& a, const glm::ivec2& b)
+{
+    float dx = static_cast<float>(std::abs(a.x - b.x));
+    float dz = static_cast<float>(std::abs(a.y - b.y));
+    return std::max(dx, dz) + (DIAGONAL_COST - 1.0f) * std::min(dx, dz);
+}
+
+float GridPathfinder::findPath(const NavGrid& grid, const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>* path,
+                               const glm::ivec2& boundsMin, const glm::ivec2& boundsMax)
+{
+    expanded = 0;
+    if (path) path->clear();
+    if (!grid.walkable(start) || !grid.walkable(goal)) return -1.0f;
+
+    const glm::ivec2 lo = glm::max(boundsMin, glm::ivec2(0));
+    const glm::ivec2 hi = glm::min(boundsMax, glm::ivec2(grid.width() - 1, grid.height() - 1));
+    auto inBounds = [&](int x, int z) { return x >= lo.x && z >= lo.y && x <= hi.x && z <= hi.y; };
+    if (!inBounds(start.x, start.y) || !inBounds(goal.x, goal.y)) return -1.0f;
+
+    // Pool do tamanho da grade; o carimbo evita limpar os nós a cada busca
+    const size_t cellCount = static_cast<size_t>(grid.width()) * grid.height();
+    if (pool.size() != cellCount) {
+        pool.assign(cellCount, Node());
+        currentVisit = 0;
+    }
+    if (++currentVisit == 0) {
+        for (Node& node : pool) node.visit = 0;
+        currentVisit = 1;
+    }
+    auto compare = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; }; // Heap mínima por f
+    open.clear();
+
+    const int startIndex = grid.index(start), goalIndex = grid.index(goal);
+    pool[startIndex] = {0.0f, -1, currentVisit, false};
+    open.push_back({octile(start, goal), startIndex});
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        const int current = open.back().index;
+        open.pop_back();
+        Node& node = pool[current];
+        if (node.closed) continue;          // Entrada velha: o nó já saiu com custo menor
+        node.closed = true;
+        ++expanded;
+
+        if (current == goalIndex) {
+            if (path) {
+                for (int i = current; i >= 0; i = pool[i].parent) path->push_back(grid.coords(i));
+                std::reverse(path->begin(), path->end());
+            }
+            return node.g;
+        }
+
+        const glm::ivec2 cell = grid.coords(current);
+        for (int d = 0; d < 8; ++d) {
+            const int nx = cell.x + DIRECTIONS[d][0], nz = cell.y + DIRECTIONS[d][1];
+            if (!inBounds(nx, nz) || !grid.walkable(nx, nz)) continue;
+            const bool diagonal = d >= 4;
+            if (diagonal && (!grid.walkable(nx, cell.y) || !grid.walkable(cell.x, nz))) continue;
+
+            const int next = nz * grid.width() + nx;
+            const float g = node.g + (diagonal ? DIAGONAL_COST : 1.0f);
+            Node& neighbor = pool[next];
+            if (neighbor.visit == currentVisit && (neighbor.closed || neighbor.g <= g)) continue;
+            neighbor = {g, current, currentVisit, false};
+            open.push_back({g + octile(glm::ivec2(nx, nz), goal), next});
+            std::push_heap(open.begin(), open.end(), compare);
+        }
+    }
+    return -1.0f;
+}
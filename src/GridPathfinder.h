@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+class NavGrid;
+
+// ============================================================================
+// A* NA GRADE DE NAVEGAÇÃO
+// ============================================================================
+// Busca com 8 vizinhos (diagonal só quando os dois vizinhos retos estão livres,
+// para não cortar quinas), heurística octil e fila de prioridade em heap
+// binária. Os nós ficam num pool do tamanho da grade, reaproveitado entre
+// buscas: um carimbo de busca invalida o conteúdo antigo sem limpar nada.
+class GridPathfinder
+{
+public:
+    // Custo do caminho em células (passo reto = 1, diagonal = √2) ou um valor
+    // negativo se não houver caminho. A busca fica restrita ao retângulo
+    // [boundsMin, boundsMax] (inclusivo). `path` recebe as células, do início ao fim.
+    float findPath(const NavGrid& grid, const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>* path,
+                   const glm::ivec2& boundsMin = glm::ivec2(0), const glm::ivec2& boundsMax = glm::ivec2(INT_MAX));
+
+    size_t lastExpandedCount() const { return expanded; } // Nós fechados na última busca
+
+    // Heurística octil entre duas células (admissível para os custos acima)
+    static float octile(const glm::ivec2& a, const glm::ivec2& b);
+
+private:
+    struct Node {
+        float g = 0.0f;
+        int parent = -1;
+        uint32_t visit = 0;              // Busca em que o nó foi aberto
+        bool closed = false;
+    };
+    struct OpenEntry {
+        float f;
+        int index;
+    };
+
+    std::vector<Node> pool;
+    std::vector<OpenEntry> open;
+    uint32_t currentVisit = 0;
+    size_t expanded = 0;
+};
@@ -0,0 +1,473 @@
+#include "HierarchicalPathfinder.h"
+#include "JobSystem.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+    const float DIAGONAL_COST = 1.41421356f;
+    const int DIRECTIONS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    // Trechos livres mais longos que isso ganham duas entradas (uma em cada ponta)
+    const int MAX_SINGLE_ENTRANCE = 6;
+    const uint8_t NO_PARENT = 0xFF;
+
+    bool openGreater(const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; }
+}
+
+// ============================================================================
+// CONSTRUÇÃO DO GRAFO ABSTRATO
+// ============================================================================
+void HierarchicalPathfinder::clear()
+{
+    grid = nullptr;
+    clustersX = clustersZ = 0;
+    nodeCells.clear();
+    nodeCluster.clear();
+    edgeStart.clear();
+    edges.clear();
+    edgePathStart.clear();
+    edgePaths.clear();
+    landmarkDistances.clear();
+    clusterNodeStart.clear();
+    clusterNodes.clear();
+    searchNodes.clear();
+    routeCells.clear();
+    routeNodes.clear();
+}
+
+void HierarchicalPathfinder::build(const NavGrid& navGrid, int size, JobSystem* jobs)
+{
+    clear();
+    grid = &navGrid;
+    clusterSize = std::max(4, size);
+    clustersX = (navGrid.width() + clusterSize - 1) / clusterSize;
+    clustersZ = (navGrid.height() + clusterSize - 1) / clusterSize;
+
+    // Entradas nas bordas entre clusters vizinhos
+    std::unordered_map<int, int> nodeOfCell;
+    std::vector<std::pair<int, int>> crossings;
+    auto nodeFor = [&](const glm::ivec2& c) {
+        auto inserted = nodeOfCell.emplace(navGrid.index(c), static_cast<int>(nodeCells.size()));
+        if (inserted.second) {
+            nodeCells.push_back(c);
+            nodeCluster.push_back(clusterOf(c));
+        }
+        return inserted.first->second;
+    };
+    // Percorre uma borda: `a(i)` e `b(i)` são as células vizinhas dos dois lados
+    auto scanBorder = [&](int length, auto a, auto b) {
+        int segmentStart = -1;
+        for (int i = 0; i <= length; ++i) {
+            bool open = i < length && navGrid.walkable(a(i)) && navGrid.walkable(b(i));
+            if (open && segmentStart < 0) segmentStart = i;
+            if (open || segmentStart < 0) continue;
+            int segmentLength = i - segmentStart;
+            if (segmentLength < MAX_SINGLE_ENTRANCE) {
+                int mid = segmentStart + segmentLength / 2;
+                crossings.emplace_back(nodeFor(a(mid)), nodeFor(b(mid)));
+            } else {
+                crossings.emplace_back(nodeFor(a(segmentStart)), nodeFor(b(segmentStart)));
+                crossings.emplace_back(nodeFor(a(i - 1)), nodeFor(b(i - 1)));
+            }
+            segmentStart = -1;
+        }
+    };
+    for (int cz = 0; cz < clustersZ; ++cz) {
+        for (int cx = 0; cx < clustersX; ++cx) {
+            const int x0 = cx * clusterSize, z0 = cz * clusterSize;
+            const int width = std::min(clusterSize, navGrid.width() - x0);
+            const int height = std::min(clusterSize, navGrid.height() - z0);
+            if (cx + 1 < clustersX) {
+                const int border = x0 + clusterSize - 1;
+                scanBorder(height, [&](int i) { return glm::ivec2(border, z0 + i); },
+                                   [&](int i) { return glm::ivec2(border + 1, z0 + i); });
+            }
+            if (cz + 1 < clustersZ) {
+                const int border = z0 + clusterSize - 1;
+                scanBorder(width, [&](int i) { return glm::ivec2(x0 + i, border); },
+                                  [&](int i) { return glm::ivec2(x0 + i, border + 1); });
+            }
+        }
+    }
+
+    // Nós de cada cluster em CSR
+    const int clusterCount = clustersX * clustersZ;
+    clusterNodeStart.assign(clusterCount + 1, 0);
+    for (int cluster : nodeCluster) ++clusterNodeStart[cluster + 1];
+    for (int c = 0; c < clusterCount; ++c) clusterNodeStart[c + 1] += clusterNodeStart[c];
+    clusterNodes.resize(nodeCells.size());
+    std::vector<uint32_t> cursor(clusterNodeStart.begin(), clusterNodeStart.end() - 1);
+    for (size_t n = 0; n < nodeCells.size(); ++n) clusterNodes[cursor[nodeCluster[n]]++] = static_cast<int>(n);
+
+    // Arestas internas: um Dijkstra limitado ao cluster a partir de cada nó,
+    // clusters independentes em paralelo. As direções do caminho de cada aresta
+    // ficam guardadas para o refinamento
+    std::vector<std::vector<Edge>> nodeEdges(nodeCells.size());
+    std::vector<std::vector<uint8_t>> nodePaths(nodeCells.size());
+    std::vector<std::vector<uint32_t>> nodePathEnds(nodeCells.size());
+    auto buildClusters = [&](size_t begin, size_t end) {
+        std::vector<float> distances;
+        std::vector<uint8_t> parents, reversed;
+        for (size_t c = begin; c < end; ++c) {
+            const int cluster = static_cast<int>(c);
+            for (uint32_t i = clusterNodeStart[c]; i < clusterNodeStart[c + 1]; ++i) {
+                const int from = clusterNodes[i];
+                clusterDistances(nodeCells[from], cluster, distances, parents);
+                for (uint32_t j = clusterNodeStart[c]; j < clusterNodeStart[c + 1]; ++j) {
+                    const int to = clusterNodes[j];
+                    int local = localIndex(nodeCells[to], cluster);
+                    const float cost = distances[local];
+                    if (to == from || cost < 0.0f) continue;
+                    nodeEdges[from].push_back({to, cost});
+                    reversed.clear();
+                    glm::ivec2 cell = nodeCells[to];
+                    for (uint8_t d = parents[local]; d != NO_PARENT; d = parents[local]) {
+                        reversed.push_back(d);
+                        cell -= glm::ivec2(DIRECTIONS[d][0], DIRECTIONS[d][1]);
+                        local = localIndex(cell, cluster);
+                    }
+                    nodePaths[from].insert(nodePaths[from].end(), reversed.rbegin(), reversed.rend());
+                    nodePathEnds[from].push_back(static_cast<uint32_t>(nodePaths[from].size()));
+                }
+            }
+        }
+    };
+    if (jobs) jobs->parallelFor(clusterCount, 16, buildClusters);
+    else buildClusters(0, clusterCount);
+
+    // Travessias entre clusters: um passo reto nos dois sentidos
+    for (const auto& crossing : crossings) {
+        nodeEdges[crossing.first].push_back({crossing.second, 1.0f});
+        nodePathEnds[crossing.first].push_back(static_cast<uint32_t>(nodePaths[crossing.first].size()));
+        nodeEdges[crossing.second].push_back({crossing.first, 1.0f});
+        nodePathEnds[crossing.second].push_back(static_cast<uint32_t>(nodePaths[crossing.second].size()));
+    }
+
+    edgeStart.assign(nodeCells.size() + 1, 0);
+    for (size_t n = 0; n < nodeCells.size(); ++n) edgeStart[n + 1] = edgeStart[n] + static_cast<uint32_t>(nodeEdges[n].size());
+    edges.reserve(edgeStart.back());
+    edgePathStart.reserve(edgeStart.back() + 1);
+    edgePathStart.push_back(0);
+    for (size_t n = 0; n < nodeCells.size(); ++n) {
+        const uint32_t base = static_cast<uint32_t>(edgePaths.size());
+        edges.insert(edges.end(), nodeEdges[n].begin(), nodeEdges[n].end());
+        edgePaths.insert(edgePaths.end(), nodePaths[n].begin(), nodePaths[n].end());
+        for (uint32_t pathEnd : nodePathEnds[n]) edgePathStart.push_back(base + pathEnd);
+    }
+    searchNodes.assign(nodeCells.size() + 2, SearchNode());
+    currentVisit = 0;
+    buildLandmarks();
+}
+
+// Marcos espalhados pelo ponto mais distante: cada novo marco é o nó mais
+// longe de todos os anteriores (e um nó de outra componente conexa, se houver)
+void HierarchicalPathfinder::buildLandmarks()
+{
+    const size_t nodeTotal = nodeCells.size();
+    landmarkDistances.assign(nodeTotal * LANDMARKS, -1.0f);
+    if (nodeTotal == 0) return;
+    std::vector<float> distances, nearest(nodeTotal, std::numeric_limits<float>::max());
+    abstractDistances(0, distances);
+    int landmark = static_cast<int>(std::max_element(distances.begin(), distances.end()) - distances.begin());
+    for (int k = 0; k < LANDMARKS; ++k) {
+        abstractDistances(landmark, distances);
+        for (size_t n = 0; n < nodeTotal; ++n) {
+            landmarkDistances[n * LANDMARKS + k] = distances[n];
+            if (distances[n] >= 0.0f) nearest[n] = std::min(nearest[n], distances[n]);
+        }
+        landmark = static_cast<int>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+    }
+}
+
+void HierarchicalPathfinder::abstractDistances(int source, std::vector<float>& distances) const
+{
+    distances.assign(nodeCells.size(), -1.0f);
+    std::vector<std::pair<float, int>> heap;
+    std::vector<uint8_t> closed(nodeCells.size(), 0);
+    distances[source] = 0.0f;
+    heap.emplace_back(0.0f, source);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), openGreater);
+        const auto [cost, node] = heap.back();
+        heap.pop_back();
+        if (closed[node]) continue;
+        closed[node] = 1;
+        for (uint32_t e = edgeStart[node]; e < edgeStart[node + 1]; ++e) {
+            const int next = edges[e].to;
+            const float g = cost + edges[e].cost;
+            if (closed[next] || (distances[next] >= 0.0f && distances[next] <= g)) continue;
+            distances[next] = g;
+            heap.emplace_back(g, next);
+            std::push_heap(heap.begin(), heap.end(), openGreater);
+        }
+    }
+}
+
+size_t HierarchicalPathfinder::memoryBytes() const
+{
+    return nodeCells.capacity() * sizeof(glm::ivec2) + nodeCluster.capacity() * sizeof(int) +
+           edgeStart.capacity() * sizeof(uint32_t) + edges.capacity() * sizeof(Edge) +
+           edgePathStart.capacity() * sizeof(uint32_t) + edgePaths.capacity() +
+           landmarkDistances.capacity() * sizeof(float) + searchNodes.capacity() * sizeof(SearchNode);
+}
+
+glm::ivec2 HierarchicalPathfinder::clusterMin(int cluster) const
+{
+    return glm::ivec2(cluster % clustersX, cluster / clustersX) * clusterSize;
+}
+
+glm::ivec2 HierarchicalPathfinder::clusterMax(int cluster) const
+{
+    return glm::min(clusterMin(cluster) + clusterSize - 1, glm::ivec2(grid->width() - 1, grid->height() - 1));
+}
+
+int HierarchicalPathfinder::localIndex(const glm::ivec2& cell, int cluster) const
+{
+    const glm::ivec2 lo = clusterMin(cluster);
+    return (cell.y - lo.y) * (clusterMax(cluster).x - lo.x + 1) + (cell.x - lo.x);
+}
+
+void HierarchicalPathfinder::clusterDistances(const glm::ivec2& start, int cluster, std::vector<float>& distances,
+                                              std::vector<uint8_t>& parents, const glm::ivec2* extra) const
+{
+    const glm::ivec2 lo = clusterMin(cluster), hi = clusterMax(cluster);
+    const int localWidth = hi.x - lo.x + 1, localHeight = hi.y - lo.y + 1;
+    distances.assign(static_cast<size_t>(localWidth) * localHeight, -1.0f);
+    parents.assign(distances.size(), NO_PARENT);
+
+    thread_local std::vector<std::pair<float, int>> heap;
+    thread_local std::vector<uint8_t> closed, target;
+    heap.clear();
+    closed.assign(distances.size(), 0);
+
+    // Células que a busca precisa fechar: ao fechar a última, o resto não importa
+    target.assign(distances.size(), 0);
+    int remaining = 0;
+    for (uint32_t i = clusterNodeStart[cluster]; i < clusterNodeStart[cluster + 1]; ++i) {
+        uint8_t& mark = target[localIndex(nodeCells[clusterNodes[i]], cluster)];
+        remaining += mark == 0;
+        mark = 1;
+    }
+    if (extra && clusterOf(*extra) == cluster) {
+        uint8_t& mark = target[localIndex(*extra, cluster)];
+        remaining += mark == 0;
+        mark = 1;
+    }
+
+    const int startLocal = (start.y - lo.y) * localWidth + (start.x - lo.x);
+    distances[startLocal] = 0.0f;
+    heap.emplace_back(0.0f, startLocal);
+    while (!heap.empty() && remaining > 0) {
+        std::pop_heap(heap.begin(), heap.end(), openGreater);
+        const auto [cost, local] = heap.back();
+        heap.pop_back();
+        if (closed[local]) continue;
+        closed[local] = 1;
+        remaining -= target[local];
+
+        const int x = lo.x + local % localWidth, z = lo.y + local / localWidth;
+        for (int d = 0; d < 8; ++d) {
+            const int nx = x + DIRECTIONS[d][0], nz = z + DIRECTIONS[d][1];
+            if (nx < lo.x || nz < lo.y || nx > hi.x || nz > hi.y || !grid->walkable(nx, nz)) continue;
+            const bool diagonal = d >= 4;
+            if (diagonal && (!grid->walkable(nx, z) || !grid->walkable(x, nz))) continue;
+            const int next = (nz - lo.y) * localWidth + (nx - lo.x);
+            const float g = cost + (diagonal ? DIAGONAL_COST : 1.0f);
+            if (closed[next] || (distances[next] >= 0.0f && distances[next] <= g)) continue;
+            distances[next] = g;
+            parents[next] = static_cast<uint8_t>(d);
+            heap.emplace_back(g, next);
+            std::push_heap(heap.begin(), heap.end(), openGreater);
+        }
+    }
+    // Abertas e não fechadas têm custo provisório: só as fechadas valem
+    for (size_t i = 0; i < distances.size(); ++i) {
+        if (!closed[i]) distances[i] = -1.0f;
+    }
+}
+
+void HierarchicalPathfinder::linkToCluster(const glm::ivec2& cell, std::vector<Edge>& links, std::vector<float>& distances,
+                                           std::vector<uint8_t>& parents, const glm::ivec2* extra) const
+{
+    const int cluster = clusterOf(cell);
+    clusterDistances(cell, cluster, distances, parents, extra);
+    links.clear();
+    for (uint32_t i = clusterNodeStart[cluster]; i < clusterNodeStart[cluster + 1]; ++i) {
+        const int node = clusterNodes[i];
+        const float cost = distances[localIndex(nodeCells[node], cluster)];
+        if (cost >= 0.0f) links.push_back({node, cost});
+    }
+}
+
+void HierarchicalPathfinder::appendFromParents(const glm::ivec2& from, const glm::ivec2& to, const std::vector<uint8_t>& parents,
+                                               std::vector<glm::ivec2>& path) const
+{
+    const int cluster = clusterOf(from);
+    const size_t begin = path.size();
+    for (glm::ivec2 cell = to; cell != from;) {
+        path.push_back(cell);
+        const uint8_t d = parents[localIndex(cell, cluster)];
+        cell -= glm::ivec2(DIRECTIONS[d][0], DIRECTIONS[d][1]);
+    }
+    std::reverse(path.begin() + begin, path.end());
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+float HierarchicalPathfinder::findPath(const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>& waypoints)
+{
+    waypoints.clear();
+    routeCells.clear();
+    routeNodes.clear();
+    if (!grid || !grid->walkable(start) || !grid->walkable(goal)) return -1.0f;
+
+    // Mesmo cluster: a distância local já é um candidato (sem sair do cluster)
+    const int startCluster = clusterOf(start), goalCluster = clusterOf(goal);
+    float direct = -1.0f;
+    linkToCluster(start, startLinks, startDistances, startParents, &goal);
+    if (startCluster == goalCluster) direct = startDistances[localIndex(goal, startCluster)];
+    linkToCluster(goal, goalLinks, goalDistances, goalParents);
+
+    // Distância de cada marco até o fim, pelas entradas do cluster do fim
+    const int nodeTotal = static_cast<int>(nodeCells.size());
+    float goalLandmarks[LANDMARKS];
+    for (int k = 0; k < LANDMARKS; ++k) {
+        goalLandmarks[k] = -1.0f;
+        for (const Edge& link : goalLinks) {
+            const float d = landmarkDistances[link.to * LANDMARKS + k];
+            if (d >= 0.0f && (goalLandmarks[k] < 0.0f || d + link.cost < goalLandmarks[k])) goalLandmarks[k] = d + link.cost;
+        }
+    }
+    // Octil e desigualdade triangular com cada marco; infinito se o nó e o fim
+    // estão em componentes diferentes (um marco alcança só um dos dois)
+    auto heuristic = [&](int node) {
+        if (node >= nodeTotal) return node == nodeTotal ? GridPathfinder::octile(start, goal) : 0.0f;
+        float h = GridPathfinder::octile(nodeCells[node], goal);
+        const float* distances = &landmarkDistances[node * LANDMARKS];
+        for (int k = 0; k < LANDMARKS; ++k) {
+            if ((distances[k] < 0.0f) != (goalLandmarks[k] < 0.0f)) return std::numeric_limits<float>::infinity();
+            if (distances[k] >= 0.0f) h = std::max(h, std::abs(distances[k] - goalLandmarks[k]));
+        }
+        return h;
+    };
+
+    // A* no grafo abstrato, com o início e o fim como dois nós temporários
+    const int startNode = nodeTotal, goalNode = nodeTotal + 1;
+    if (++currentVisit == 0) {
+        for (SearchNode& node : searchNodes) node.visit = 0;
+        currentVisit = 1;
+    }
+    auto cellOf = [&](int node) { return node == startNode ? start : node == goalNode ? goal : nodeCells[node]; };
+    auto relax = [&](int from, int to, float cost) {
+        const float g = searchNodes[from].g + cost;
+        SearchNode& target = searchNodes[to];
+        if (target.visit == currentVisit && (target.closed || target.g <= g)) return;
+        const float h = heuristic(to);
+        if (h == std::numeric_limits<float>::infinity()) return;
+        target = {g, from, currentVisit, false};
+        open.emplace_back(g + h, to);
+        std::push_heap(open.begin(), open.end(), openGreater);
+    };
+
+    open.clear();
+    searchNodes[startNode] = {0.0f, -1, currentVisit, false};
+    open.emplace_back(heuristic(startNode), startNode);
+    float best = -1.0f;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), openGreater);
+        const auto [f, current] = open.back();
+        open.pop_back();
+        SearchNode& node = searchNodes[current];
+        if (node.closed) continue;
+        node.closed = true;
+        if (direct >= 0.0f && f >= direct) break;    // O caminho local já é melhor
+        if (current == goalNode) { best = node.g; break; }
+
+        if (current == startNode) {
+            for (const Edge& link : startLinks) relax(current, link.to, link.cost);
+            continue;
+        }
+        for (uint32_t e = edgeStart[current]; e < edgeStart[current + 1]; ++e) relax(current, edges[e].to, edges[e].cost);
+        if (nodeCluster[current] == goalCluster) {
+            for (const Edge& link : goalLinks) {
+                if (link.to == current) relax(current, goalNode, link.cost);
+            }
+        }
+    }
+
+    routeStart = start;
+    routeGoal = goal;
+    if (direct >= 0.0f && (best < 0.0f || direct <= best)) {
+        waypoints = {start, goal};
+        routeNodes = {startNode, goalNode};
+        routeCells = waypoints;
+        return direct;
+    }
+    if (best < 0.0f) return -1.0f;
+    for (int node = goalNode; node >= 0; node = searchNodes[node].parent) {
+        const glm::ivec2 cell = cellOf(node);
+        if (waypoints.empty() || waypoints.back() != cell) {
+            waypoints.push_back(cell);
+            routeNodes.push_back(node);
+        }
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    std::reverse(routeNodes.begin(), routeNodes.end());
+    routeCells = waypoints;
+    return best;
+}
+
+bool HierarchicalPathfinder::refine(const std::vector<glm::ivec2>& waypoints, std::vector<glm::ivec2>& path)
+{
+    path.clear();
+    if (waypoints.empty() || !grid) return false;
+    path.push_back(waypoints.front());
+
+    // Caminho da última consulta: cada trecho já está guardado (arestas
+    // internas) ou nas direções dos Dijkstras do início e do fim
+    if (!routeNodes.empty() && waypoints == routeCells) {
+        const int startNode = static_cast<int>(nodeCells.size()), goalNode = startNode + 1;
+        for (size_t i = 0; i + 1 < routeNodes.size(); ++i) {
+            const int a = routeNodes[i], b = routeNodes[i + 1];
+            const glm::ivec2 from = waypoints[i], to = waypoints[i + 1];
+            if (clusterOf(from) != clusterOf(to)) {
+                path.push_back(to);         // Travessia: células vizinhas em clusters diferentes
+            } else if (a == startNode) {
+                appendFromParents(routeStart, to, startParents, path);
+            } else if (b == goalNode) {
+                // Dijkstra a partir do fim: o trecho sai invertido
+                const size_t begin = path.size();
+                appendFromParents(routeGoal, from, goalParents, path);
+                if (path.size() > begin) path.pop_back();
+                std::reverse(path.begin() + begin, path.end());
+                path.push_back(routeGoal);
+            } else {
+                uint32_t e = edgeStart[a];
+                while (e < edgeStart[a + 1] && edges[e].to != b) ++e;
+                if (e == edgeStart[a + 1]) return false;
+                glm::ivec2 cell = from;
+                for (uint32_t step = edgePathStart[e]; step < edgePathStart[e + 1]; ++step) {
+                    cell += glm::ivec2(DIRECTIONS[edgePaths[step]][0], DIRECTIONS[edgePaths[step]][1]);
+                    path.push_back(cell);
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<glm::ivec2> segment;
+    for (size_t i = 0; i + 1 < waypoints.size(); ++i) {
+        const glm::ivec2 a = waypoints[i], b = waypoints[i + 1];
+        const int cluster = clusterOf(a);
+        if (cluster != clusterOf(b)) {
+            path.push_back(b);              // Travessia: células vizinhas em clusters diferentes
+            continue;
+        }
+        if (localSearch.findPath(*grid, a, b, &segment, clusterMin(cluster), clusterMax(cluster)) < 0.0f) return false;
+        path.insert(path.end(), segment.begin() + 1, segment.end());
+    }
+    return true;
+}
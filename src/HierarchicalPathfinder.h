@@ -0,0 +1,108 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "GridPathfinder.h"
+
+class NavGrid;
+class JobSystem;
+
+// ============================================================================
+// HPA*: BUSCA HIERÁRQUICA
+// ============================================================================
+// A grade é dividida em clusters quadrados. Em cada borda entre dois clusters,
+// os trechos livres viram "entradas" (um par de células vizinhas, uma de cada
+// lado); as células das entradas são os nós de um grafo abstrato, ligados
+// pelos custos exatos dentro do cluster, calculados uma vez no build junto
+// com as células de cada ligação. Uma consulta liga o início e o fim às
+// entradas dos seus clusters (Dijkstra local que para ao fechar a última
+// entrada) e faz um A* no grafo abstrato guiado por marcos (ALT): distâncias
+// exatas de LANDMARKS nós a todos os outros, que num labirinto apertam muito
+// mais que a octil. O refinamento só copia os trechos guardados.
+class HierarchicalPathfinder
+{
+public:
+    // Guarda uma referência à grade, que deve continuar viva e inalterada
+    void build(const NavGrid& grid, int clusterSize, JobSystem* jobs = nullptr);
+    void clear();
+
+    // Caminho abstrato: início, células de entrada e fim. Retorna o custo em
+    // células ou um valor negativo se não houver caminho.
+    float findPath(const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>& waypoints);
+    // Expande os waypoints em células. Os da última findPath saem dos trechos
+    // guardados; outros, de um A* restrito ao cluster de cada trecho
+    bool refine(const std::vector<glm::ivec2>& waypoints, std::vector<glm::ivec2>& path);
+
+    bool empty() const { return grid == nullptr; }
+    size_t nodeCount() const { return nodeCells.size(); }
+    size_t edgeCount() const { return edges.size(); }
+    size_t memoryBytes() const;
+
+    static constexpr int LANDMARKS = 8;
+    int clusterOf(const glm::ivec2& c) const { return (c.y / clusterSize) * clustersX + c.x / clusterSize; }
+
+private:
+    struct Edge {
+        int to;
+        float cost;
+    };
+    struct SearchNode {
+        float g = 0.0f;
+        int parent = -1;
+        uint32_t visit = 0;
+        bool closed = false;
+    };
+
+    // Dijkstra limitado ao cluster a partir de `start`, até fechar todas as
+    // entradas do cluster (e `extra`, se dentro dele). `distances` é indexado
+    // pela posição local da célula (negativo = não alcançada) e `parents` guarda
+    // a direção que chegou a cada célula (NO_PARENT no início)
+    void clusterDistances(const glm::ivec2& start, int cluster, std::vector<float>& distances,
+                          std::vector<uint8_t>& parents, const glm::ivec2* extra = nullptr) const;
+    glm::ivec2 clusterMin(int cluster) const;
+    glm::ivec2 clusterMax(int cluster) const;
+    int localIndex(const glm::ivec2& cell, int cluster) const;
+    // Custo de `cell` até cada nó do cluster (links temporários da consulta)
+    void linkToCluster(const glm::ivec2& cell, std::vector<Edge>& links, std::vector<float>& distances,
+                       std::vector<uint8_t>& parents, const glm::ivec2* extra = nullptr) const;
+    // Células de `from` até `to` (exclusive `from`) pelas direções de um Dijkstra local
+    void appendFromParents(const glm::ivec2& from, const glm::ivec2& to, const std::vector<uint8_t>& parents,
+                           std::vector<glm::ivec2>& path) const;
+    // Dijkstra no grafo abstrato (negativo = inalcançável)
+    void abstractDistances(int source, std::vector<float>& distances) const;
+    void buildLandmarks();
+
+    const NavGrid* grid = nullptr;
+    int clusterSize = 16;
+    int clustersX = 0, clustersZ = 0;
+
+    // Grafo abstrato em CSR
+    std::vector<glm::ivec2> nodeCells;
+    std::vector<int> nodeCluster;
+    std::vector<uint32_t> edgeStart;     // edges[edgeStart[n], edgeStart[n + 1]) saem do nó n
+    std::vector<Edge> edges;
+    // Direções (índices em DIRECTIONS) das células de cada aresta interna, de
+    // `edgePathStart[e]` a `edgePathStart[e + 1]`; travessias ficam vazias
+    std::vector<uint32_t> edgePathStart;
+    std::vector<uint8_t> edgePaths;
+    std::vector<float> landmarkDistances; // Nó * LANDMARKS + marco; negativo = inalcançável
+    std::vector<uint32_t> clusterNodeStart;
+    std::vector<int> clusterNodes;       // Nós de cada cluster, também em CSR
+
+    // Memória reaproveitada entre consultas
+    std::vector<SearchNode> searchNodes;
+    std::vector<Edge> startLinks, goalLinks;
+    std::vector<float> startDistances, goalDistances;
+    std::vector<std::pair<float, int>> open;
+    uint32_t currentVisit = 0;
+    GridPathfinder localSearch;
+
+    // Última findPath, para o refinamento sem busca: nós do caminho (início e
+    // fim como nodeCount() e nodeCount() + 1) e as direções dos Dijkstras locais
+    std::vector<glm::ivec2> routeCells;
+    std::vector<int> routeNodes;
+    glm::ivec2 routeStart = glm::ivec2(-1), routeGoal = glm::ivec2(-1);
+    std::vector<uint8_t> startParents, goalParents;
+};
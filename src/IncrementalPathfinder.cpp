@@ -0,0 +1,299 @@
+#include "IncrementalPathfinder.h"
+#include "FlowField.h"
+#include "GridPathfinder.h"
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const float INF = std::numeric_limits<float>::infinity();
+    const float DIAGONAL_COST = 1.41421356f;
+    const int DIRECTIONS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    // Vizinhos caminháveis com o custo do passo (mesmas regras do A*: sem cortar quinas).
+    // O grafo é simétrico, então sucessores e predecessores são os mesmos.
+    template <typename Visit>
+    void forEachNeighbor(const NavGrid& grid, int index, Visit&& visit)
+    {
+        const glm::ivec2 cell = grid.coords(index);
+        for (int d = 0; d < 8; ++d) {
+            const int nx = cell.x + DIRECTIONS[d][0], nz = cell.y + DIRECTIONS[d][1];
+            if (!grid.walkable(nx, nz)) continue;
+            const bool diagonal = d >= 4;
+            if (diagonal && (!grid.walkable(nx, cell.y) || !grid.walkable(cell.x, nz))) continue;
+            visit(nz * grid.width() + nx, diagonal ? DIAGONAL_COST : 1.0f);
+        }
+    }
+
+    struct EntryGreater {                // Heap mínima por chave
+        template <typename Entry>
+        bool operator()(const Entry& a, const Entry& b) const { return b.key < a.key; }
+    };
+
+    // Ler o relógio a cada passo custaria quase tanto quanto o passo
+    const int CLOCK_CHECK_INTERVAL = 8;
+    // O desvio procura o caminho antigo só perto do começo dele
+    const size_t ROUTE_WINDOW = 32;
+}
+
+// Marcos pelo ponto mais distante: cada novo marco é a célula mais longe de
+// todos os anteriores (ou de outra componente conexa, se houver)
+void IncrementalPathfinder::buildLandmarks(const NavGrid& navGrid, JobSystem* jobs)
+{
+    const int cellCount = navGrid.width() * navGrid.height();
+    landmarkGrid = &navGrid;
+    landmarkDistances.assign(static_cast<size_t>(cellCount) * LANDMARKS, -1.0f);
+    std::vector<float> nearest(cellCount, -1.0f);
+    int landmark = -1;
+    for (int i = 0; i < cellCount; ++i) {
+        if (!navGrid.walkable(navGrid.coords(i))) continue;
+        nearest[i] = std::numeric_limits<float>::max();
+        if (landmark < 0) landmark = i;
+    }
+    if (landmark < 0) return;
+
+    FlowField field;
+    field.build(navGrid, {navGrid.coords(landmark)}, jobs);
+    for (int i = 0; i < cellCount; ++i) {
+        if (field.distance(navGrid.coords(i)) > field.distance(navGrid.coords(landmark))) landmark = i;
+    }
+    for (int k = 0; k < LANDMARKS; ++k) {
+        field.build(navGrid, {navGrid.coords(landmark)}, jobs);
+        for (int i = 0; i < cellCount; ++i) {
+            const float d = field.distance(navGrid.coords(i));
+            landmarkDistances[static_cast<size_t>(i) * LANDMARKS + k] = d;
+            if (d >= 0.0f) nearest[i] = std::min(nearest[i], d);
+        }
+        landmark = static_cast<int>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+    }
+}
+
+void IncrementalPathfinder::reset(const NavGrid& navGrid, const std::vector<glm::ivec2>& goals)
+{
+    grid = &navGrid;
+    goalCells = goals;
+    if (landmarkGrid != &navGrid) {      // Marcos de outra grade não valem aqui
+        landmarkGrid = nullptr;
+        landmarkDistances.clear();
+    }
+    const size_t cellCount = static_cast<size_t>(navGrid.width()) * navGrid.height();
+    if (nodes.size() != cellCount) {
+        nodes.assign(cellCount, Node());
+        currentVisit = 0;
+    }
+    if (++currentVisit == 0) {
+        for (Node& n : nodes) n.visit = 0;
+        currentVisit = 1;
+    }
+    open.clear();
+    route.clear();
+    detour.clear();
+    start = glm::ivec2(-1);              // Os alvos entram na fila no primeiro update(), com o início conhecido
+    km = 0.0f;
+    expanded = 0;
+}
+
+IncrementalPathfinder::Node& IncrementalPathfinder::node(int index)
+{
+    Node& n = nodes[index];
+    if (n.visit != currentVisit) {
+        n.g = n.rhs = INF;
+        n.visit = currentVisit;
+        n.open = n.goal = false;
+    }
+    return n;
+}
+
+float IncrementalPathfinder::gOf(int index) const
+{
+    return nodes[index].visit == currentVisit ? nodes[index].g : INF;
+}
+
+float IncrementalPathfinder::distance() const
+{
+    return grid && grid->walkable(start) ? gOf(grid->index(start)) : INF;
+}
+
+float IncrementalPathfinder::heuristic(int a, int b) const
+{
+    // Cada termo é uma pseudométrica, e o máximo delas também: as chaves
+    // antigas continuam limites inferiores depois de km += h(início antigo, novo)
+    float h = GridPathfinder::octile(grid->coords(a), grid->coords(b));
+    if (landmarkDistances.empty()) return h;
+    const float* da = &landmarkDistances[static_cast<size_t>(a) * LANDMARKS];
+    const float* db = &landmarkDistances[static_cast<size_t>(b) * LANDMARKS];
+    for (int k = 0; k < LANDMARKS; ++k) {
+        if (da[k] >= 0.0f && db[k] >= 0.0f) h = std::max(h, std::abs(da[k] - db[k]));
+    }
+    return h;
+}
+
+IncrementalPathfinder::Key IncrementalPathfinder::calculateKey(int index)
+{
+    const Node& n = node(index);
+    const float m = std::min(n.g, n.rhs);
+    return {m + heuristic(index, grid->index(start)) + km, m};
+}
+
+void IncrementalPathfinder::push(int index, const Key& key)
+{
+    Node& n = node(index);
+    if (n.open && n.key == key) return;  // Já está na fila com essa chave
+    n.key = key;
+    n.open = true;
+    open.push_back({key, index});
+    std::push_heap(open.begin(), open.end(), EntryGreater());
+}
+
+void IncrementalPathfinder::updateVertex(int index)
+{
+    Node& n = node(index);
+    if (!n.goal) {
+        float best = INF;
+        forEachNeighbor(*grid, index, [&](int neighbor, float cost) { best = std::min(best, cost + gOf(neighbor)); });
+        n.rhs = best;
+    }
+    refresh(index);
+}
+
+void IncrementalPathfinder::refresh(int index)
+{
+    Node& n = node(index);
+    if (n.g != n.rhs) push(index, calculateKey(index));
+    else n.open = false;                 // Consistente: a entrada que sobrar na fila fica velha
+}
+
+bool IncrementalPathfinder::popStale()
+{
+    while (!open.empty()) {
+        const OpenEntry& top = open.front();
+        const Node& n = nodes[top.index];
+        if (n.visit == currentVisit && n.open && n.key == top.key) return true;
+        std::pop_heap(open.begin(), open.end(), EntryGreater());
+        open.pop_back();
+    }
+    return false;
+}
+
+bool IncrementalPathfinder::update(const glm::ivec2& newStart, Clock::time_point deadline)
+{
+    expanded = 0;
+    if (!grid || !grid->walkable(newStart)) return false;
+
+    if (start.x < 0) {
+        start = newStart;
+        for (const glm::ivec2& goal : goalCells) {
+            if (!grid->walkable(goal)) continue;
+            const int index = grid->index(goal);
+            Node& n = node(index);
+            n.goal = true;
+            n.rhs = 0.0f;
+            push(index, calculateKey(index));
+        }
+    } else if (newStart != start) {
+        // As chaves na fila foram calculadas com o início antigo: em vez de
+        // recalculá-las, `km` soma o quanto a heurística pode ter diminuído
+        km += heuristic(grid->index(start), grid->index(newStart));
+        start = newStart;
+    }
+
+    const int startIndex = grid->index(start);
+    for (int steps = 0; popStale(); ++steps) {
+        const Key top = open.front().key;
+        const Node& s = node(startIndex);
+        if (!(top < calculateKey(startIndex)) && s.rhs == s.g) break;
+        if (steps % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) return false;  // Orçamento do tick esgotado
+
+        std::pop_heap(open.begin(), open.end(), EntryGreater());
+        const int u = open.back().index;
+        open.pop_back();
+        Node& n = node(u);
+        n.open = false;
+        const Key current = calculateKey(u);
+        if (top < current) {             // Chave desatualizada pelo km: volta para a fila
+            push(u, current);
+            continue;
+        }
+        ++expanded;
+        if (n.g > n.rhs) {
+            // g só diminuiu: basta oferecer o novo custo aos vizinhos, sem
+            // refazer o mínimo sobre os 8 vizinhos de cada um
+            n.g = n.rhs;
+            forEachNeighbor(*grid, u, [&](int neighbor, float cost) {
+                Node& m = node(neighbor);
+                if (!m.goal && n.g + cost < m.rhs) m.rhs = n.g + cost;
+                refresh(neighbor);
+            });
+        } else {
+            n.g = INF;
+            updateVertex(u);
+            forEachNeighbor(*grid, u, [&](int neighbor, float) { updateVertex(neighbor); });
+        }
+    }
+    return extendRoute(deadline);
+}
+
+int IncrementalPathfinder::descend(const glm::ivec2& cell) const
+{
+    int next = -1;
+    float best = INF;
+    forEachNeighbor(*grid, grid->index(cell), [&](int neighbor, float cost) {
+        const float total = cost + gOf(neighbor);
+        if (total < best) { best = total; next = neighbor; }
+    });
+    return next;
+}
+
+bool IncrementalPathfinder::extendRoute(Clock::time_point deadline)
+{
+    auto isGoal = [&](const glm::ivec2& cell) {
+        const Node& n = nodes[grid->index(cell)];
+        return n.visit == currentVisit && n.goal;
+    };
+    if (gOf(grid->index(start)) == INF) {
+        route.clear();
+        detour.clear();
+        return true;
+    }
+
+    // O início andou: desce dele até uma célula do começo do caminho antigo
+    if (route.empty()) route.push_back(start);
+    if (route.front() != start) {
+        if (detour.empty() || detour.front() != start) detour.assign(1, start);
+        for (int steps = 0;; ++steps) {
+            const size_t window = std::min(route.size(), ROUTE_WINDOW);
+            const auto join = std::find(route.begin(), route.begin() + window, detour.back());
+            if (join != route.begin() + window) {
+                route.erase(route.begin(), join);
+                route.insert(route.begin(), detour.begin(), detour.end() - 1);
+                break;
+            }
+            if (isGoal(detour.back())) {
+                route.swap(detour);
+                break;
+            }
+            if (steps % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) return false;
+            const int next = descend(detour.back());
+            if (next < 0) {
+                route.clear();
+                detour.clear();
+                return true;
+            }
+            detour.push_back(grid->coords(next));
+        }
+        detour.clear();
+    }
+
+    // Estende o fim até um alvo; o g cai a cada passo, então sempre termina
+    for (int steps = 0; !isGoal(route.back()); ++steps) {
+        if (steps % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) return false;
+        const int next = descend(route.back());
+        if (next < 0) {
+            route.clear();
+            return true;
+        }
+        route.push_back(grid->coords(next));
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+class NavGrid;
+class JobSystem;
+
+// ============================================================================
+// D* LITE: CAMINHO INCREMENTAL ATÉ O ALVO MAIS PRÓXIMO
+// ============================================================================
+// Busca de trás para frente, a partir de todos os alvos ao mesmo tempo, até a
+// célula de início. Quando o início se move, o trabalho já feito continua
+// valendo: só as células cuja chave ficou desatualizada são reexpandidas (o
+// deslocamento `km` corrige a heurística sem refazer a fila). Trocar os alvos
+// exige um reset, que é O(1) graças ao carimbo de busca nos nós.
+//
+// A heurística é a octil ou, com marcos, a desigualdade triangular com as
+// distâncias exatas de LANDMARKS células a todas as outras (ALT). Os marcos não
+// dependem dos alvos, então são calculados uma vez por grade; num labirinto
+// eles cortam a busca para perto do corredor que leva ao início.
+class IncrementalPathfinder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int LANDMARKS = 4;
+
+    // Distâncias dos marcos (pontos mais distantes entre si), uma vez por grade
+    void buildLandmarks(const NavGrid& grid, JobSystem* jobs = nullptr);
+    // Recomeça com um novo conjunto de alvos; a grade deve continuar viva e inalterada
+    void reset(const NavGrid& grid, const std::vector<glm::ivec2>& goals);
+    // Move o início, repara a busca e estende o caminho até `deadline`. Retorna
+    // true quando path() vai do início até um alvo; senão, o trabalho continua
+    // de onde parou na próxima chamada.
+    bool update(const glm::ivec2& start, Clock::time_point deadline);
+    // Do início até o alvo mais próximo (vazio sem caminho); só após update() == true
+    const std::vector<glm::ivec2>& path() const { return route; }
+
+    bool empty() const { return grid == nullptr; }
+    const std::vector<glm::ivec2>& goals() const { return goalCells; }
+    float distance() const;                                 // Custo do início ao alvo mais próximo (infinito sem caminho)
+    size_t lastExpandedCount() const { return expanded; }   // Nós expandidos na última chamada
+
+private:
+    struct Key {
+        float primary, secondary;
+        bool operator<(const Key& o) const { return primary < o.primary || (primary == o.primary && secondary < o.secondary); }
+        bool operator==(const Key& o) const { return primary == o.primary && secondary == o.secondary; }
+        bool operator!=(const Key& o) const { return !(*this == o); }
+    };
+    struct Node {
+        float g, rhs;
+        Key key;                         // Chave da entrada válida na fila (se `open`)
+        uint32_t visit = 0;              // Busca em que o nó foi tocado
+        bool open = false;
+        bool goal = false;
+    };
+    struct OpenEntry {
+        Key key;
+        int index;
+    };
+
+    Node& node(int index);                      // Inicializa o nó na primeira vez em que é tocado
+    float gOf(int index) const;
+    float heuristic(int a, int b) const;        // Octil e marcos; satisfaz a desigualdade triangular
+    Key calculateKey(int index);
+    void updateVertex(int index);               // Recalcula rhs pelos vizinhos
+    void refresh(int index);                    // Entra ou sai da fila conforme g == rhs
+    void push(int index, const Key& key);
+    bool popStale();                            // Descarta entradas velhas do topo; false se a fila esvaziou
+    int descend(const glm::ivec2& cell) const;  // Vizinho no gradiente de custo (-1 se não houver)
+    bool extendRoute(Clock::time_point deadline);
+
+    const NavGrid* grid = nullptr;
+    std::vector<glm::ivec2> goalCells;
+    std::vector<Node> nodes;
+    std::vector<OpenEntry> open;
+    const NavGrid* landmarkGrid = nullptr;
+    std::vector<float> landmarkDistances;       // Célula * LANDMARKS + marco; negativo = inalcançável
+    uint32_t currentVisit = 0;
+    glm::ivec2 start = glm::ivec2(-1);
+    float km = 0.0f;
+    size_t expanded = 0;
+
+    // Com o grafo fixo, as células de um caminho já extraído têm g exato e não
+    // mudam mais: quando o início anda, só o desvio até reencontrar o caminho
+    // é novo, e um caminho longo pode ser extraído em vários ticks
+    std::vector<glm::ivec2> route;              // Do início em direção ao alvo; completo quando termina num alvo
+    std::vector<glm::ivec2> detour;             // Descida do início atual até reencontrar `route`
+};
@@ -0,0 +1,87 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <memory>
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    for (unsigned int i = 0; i < workerCount; ++i) workers.emplace_back(&JobSystem::workerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+JobSystem& JobSystem::shared()
+{
+    static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+void JobSystem::workerLoop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+bool JobSystem::runOne()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || workers.empty()) { body(0, count); return; }
+
+    // Os pedaços são distribuídos por um contador atômico: cada tarefa enfileirada
+    // (e a própria thread chamadora) pega o próximo até acabar o intervalo
+    struct Batch {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+    auto batch = std::make_shared<Batch>();
+    auto drain = [batch, chunks, count, grain, &body] {
+        for (size_t c = batch->next.fetch_add(1); c < chunks; c = batch->next.fetch_add(1)) {
+            body(c * grain, std::min(count, (c + 1) * grain));
+            batch->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    size_t helpers = std::min(chunks - 1, workers.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < helpers; ++i) tasks.emplace_back(drain);
+    }
+    wake.notify_all();
+
+    drain();
+    // Enquanto outros terminam seus pedaços, ajuda com qualquer tarefa pendente
+    while (batch->done.load(std::memory_order_acquire) < chunks) {
+        if (!runOne()) std::this_thread::yield();
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// SISTEMA DE TAREFAS
+// ============================================================================
+// Pool fixo de threads para trabalho paralelo de dados (bakes no carregamento,
+// simulação de agentes, benchmarks). A thread que chama parallelFor também
+// executa pedaços do intervalo enquanto espera, então chamadas aninhadas não
+// travam o pool.
+class JobSystem
+{
+public:
+    explicit JobSystem(unsigned int workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Instância compartilhada, com uma thread por núcleo (menos a principal)
+    static JobSystem& shared();
+
+    // Executa body(begin, end) sobre [0, count) em blocos de até `grain` itens
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    unsigned int threadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+private:
+    void workerLoop();
+    bool runOne(); // Executa uma tarefa pendente, se houver
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
@@ -0,0 +1,34 @@
+#include "LightAssignment.h"
+#include <algorithm>
+#include <cmath>
+
+float lightCutoffRadius(const PointLight& light)
+{
+    const float peak = light.intensity * std::max(light.color.x, std::max(light.color.y, light.color.z));
+    // q d² + l d + (c - peak / corte) = 0, raiz positiva
+    const float c = light.constant - peak / LIGHT_CUTOFF;
+    if (c >= 0.0f) return 0.0f;        // Fraca demais até no centro
+    if (light.quadratic <= 0.0f) return light.linear > 0.0f ? -c / light.linear : 1e30f;
+    return (-light.linear + std::sqrt(light.linear * light.linear - 4.0f * light.quadratic * c)) / (2.0f * light.quadratic);
+}
+
+int assignLights(const std::vector<PointLight>& lights, const glm::vec3& lo, const glm::vec3& hi, int indices[MAX_OBJECT_LIGHTS])
+{
+    float strength[MAX_OBJECT_LIGHTS];
+    int count = 0;
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const PointLight& light = lights[i];
+        const glm::vec3 closest = glm::clamp(light.position, lo, hi);
+        const float d = glm::length(light.position - closest);
+        if (d >= light.radius) continue;
+        const float s = light.intensity / (light.constant + light.linear * d + light.quadratic * d * d);
+        // Inserção ordenada na lista curta; a mais fraca sai quando não cabe
+        int slot = count < MAX_OBJECT_LIGHTS ? count++ : MAX_OBJECT_LIGHTS;
+        while (slot > 0 && strength[slot - 1] < s) {
+            if (slot < MAX_OBJECT_LIGHTS) { strength[slot] = strength[slot - 1]; indices[slot] = indices[slot - 1]; }
+            --slot;
+        }
+        if (slot < MAX_OBJECT_LIGHTS) { strength[slot] = s; indices[slot] = static_cast<int>(i); }
+    }
+    return count;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// ============================================================================
+// LUZES POR OBJETO
+// ============================================================================
+// Cada luz pontual acesa ganha um raio de corte tirado da própria atenuação
+// (onde a contribuição cai abaixo de LIGHT_CUTOFF); cada draw recebe só a
+// lista curta das luzes que alcançam a sua caixa. O custo do fragmento passa
+// a depender de quantas luzes há por perto, não de quantas existem na cena.
+// O shader apaga a luz suavemente até o raio, então o corte não aparece.
+
+struct PointLight {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 color = glm::vec3(1.0f);
+    float intensity = 0.0f;
+    float constant = 1.0f, linear = 0.0f, quadratic = 0.0f;
+    float radius = 0.0f;               // Preenchido por lightCutoffRadius
+};
+
+constexpr int MAX_SCENE_LIGHTS = 16;   // Mesmos valores de shader.frag
+constexpr int MAX_OBJECT_LIGHTS = 4;
+constexpr float LIGHT_CUTOFF = 0.05f;  // Fração da luz branca considerada apagada
+
+// Distância em que intensidade * cor / (c + l d + q d²) chega a LIGHT_CUTOFF
+float lightCutoffRadius(const PointLight& light);
+
+// Luzes que alcançam a caixa [lo, hi], das mais fortes no ponto mais próximo da
+// caixa para as mais fracas; devolve quantas (no máximo MAX_OBJECT_LIGHTS)
+int assignLights(const std::vector<PointLight>& lights, const glm::vec3& lo, const glm::vec3& hi, int indices[MAX_OBJECT_LIGHTS]);
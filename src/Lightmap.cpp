@@ -0,0 +1,298 @@
+#include "Lightmap.h"
+#include "BakedScene.h"
+#include "JobSystem.h"
+#include "MeshBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const int PADDING = 1;                 // Texels em volta de cada carta (filtro bilinear)
+    const float SURFACE_OFFSET = 0.01f;    // Afasta a origem dos raios da superfície
+    const float PI = 3.14159265358979f;
+
+    bool samePoint(const glm::vec3& a, const glm::vec3& b)
+    {
+        return std::abs(a.x - b.x) < 1e-4f && std::abs(a.y - b.y) < 1e-4f && std::abs(a.z - b.z) < 1e-4f;
+    }
+
+    // Dois vértices em comum = aresta em comum
+    bool shareEdge(const glm::vec3* a, const glm::vec3* b)
+    {
+        int shared = 0;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) shared += samePoint(a[i], b[j]);
+        return shared >= 2;
+    }
+
+    // Gerador pequeno por texel: o resultado não depende de quantas threads assam
+    struct Random {
+        uint32_t state;
+        explicit Random(uint32_t seed) : state(seed * 747796405u + 2891336453u) {}
+        float next()
+        {
+            state = state * 747796405u + 2891336453u;
+            uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+            return static_cast<float>((word >> 22u) ^ word) * (1.0f / 4294967296.0f);
+        }
+    };
+
+    // Direção com densidade proporcional ao cosseno em volta de `n`
+    glm::vec3 cosineSample(const glm::vec3& n, Random& random)
+    {
+        const glm::vec3 helper = std::abs(n.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        const glm::vec3 t = glm::normalize(glm::cross(helper, n)), b = glm::cross(n, t);
+        const float phi = 2.0f * PI * random.next(), r2 = random.next(), r = std::sqrt(r2);
+        return glm::normalize(t * (r * std::cos(phi)) + b * (r * std::sin(phi)) + n * std::sqrt(std::max(0.0f, 1.0f - r2)));
+    }
+
+    void encodeRgbm(const glm::vec3& light, uint8_t* out)
+    {
+        const glm::vec3 scaled = glm::clamp(light / Lightmap::RGBM_RANGE, glm::vec3(0.0f), glm::vec3(1.0f));
+        float m = std::max(std::max(scaled.x, scaled.y), std::max(scaled.z, 1e-6f));
+        m = std::ceil(m * 255.0f) / 255.0f;
+        const glm::vec3 rgb = scaled / m;
+        out[0] = static_cast<uint8_t>(std::lround(glm::clamp(rgb.x, 0.0f, 1.0f) * 255.0f));
+        out[1] = static_cast<uint8_t>(std::lround(glm::clamp(rgb.y, 0.0f, 1.0f) * 255.0f));
+        out[2] = static_cast<uint8_t>(std::lround(glm::clamp(rgb.z, 0.0f, 1.0f) * 255.0f));
+        out[3] = static_cast<uint8_t>(std::lround(m * 255.0f));
+    }
+}
+
+bool LightmapSettings::operator==(const LightmapSettings& other) const
+{
+    return texelsPerMeter == other.texelsPerMeter && maxAtlasSize == other.maxAtlasSize && samples == other.samples &&
+           bounces == other.bounces && sunDirection == other.sunDirection && sunColor == other.sunColor &&
+           skyColor == other.skyColor && albedo == other.albedo;
+}
+
+bool Lightmap::unwrap(const std::vector<glm::vec3>& triangles, const LightmapSettings& settings)
+{
+    charts.clear();
+    rgbm.clear();
+    vertexUVs.assign(triangles.size(), glm::vec2(0.0f));
+    const size_t triangleCount = triangles.size() / 3;
+    std::vector<int> triangleChart(triangleCount);
+
+    // Cartas: triângulos seguidos, coplanares e vizinhos
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3* tri = &triangles[t * 3];
+        glm::vec3 n = glm::cross(tri[1] - tri[0], tri[2] - tri[0]);
+        n = glm::length(n) > 1e-12f ? glm::normalize(n) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const float d = glm::dot(n, tri[0]);
+        const bool join = !charts.empty() && glm::dot(n, charts.back().normal) > 0.999f &&
+                          std::abs(d - charts.back().planeDistance) < 1e-3f && shareEdge(tri, tri - 3);
+        if (!join) {
+            Chart chart;
+            chart.normal = n;
+            chart.planeDistance = d;
+            const glm::vec3 helper = std::abs(n.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+            chart.axisU = glm::normalize(glm::cross(helper, n));
+            chart.axisV = glm::cross(n, chart.axisU);
+            chart.min = glm::vec2(std::numeric_limits<float>::max());
+            chart.max = glm::vec2(std::numeric_limits<float>::lowest());
+            charts.push_back(chart);
+        }
+        Chart& chart = charts.back();
+        for (int i = 0; i < 3; ++i) {
+            const glm::vec2 s(glm::dot(tri[i], chart.axisU), glm::dot(tri[i], chart.axisV));
+            chart.min = glm::min(chart.min, s);
+            chart.max = glm::max(chart.max, s);
+        }
+        triangleChart[t] = static_cast<int>(charts.size()) - 1;
+    }
+
+    // Cada carta leva pelo menos (1 + 2 * PADDING)² texels, qualquer que seja a
+    // densidade: se nem isso cabe no limite, não há atlas
+    auto fail = [this]() {
+        charts.clear();
+        texelChart.clear();
+        vertexUVs.clear();
+        atlasWidth = atlasHeight = 0;
+        density = 0.0f;
+        return false;
+    };
+    const double minChartArea = double(1 + 2 * PADDING) * (1 + 2 * PADDING);
+    if (charts.size() * minChartArea > double(settings.maxAtlasSize) * settings.maxAtlasSize) return fail();
+
+    // Empacotamento em prateleiras, das cartas mais altas para as mais baixas;
+    // se o atlas passar do limite, a densidade cai e tudo é refeito
+    std::vector<int> order(charts.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    density = settings.texelsPerMeter;
+    for (;;) {
+        double area = 0.0;
+        int widest = 1;
+        for (Chart& chart : charts) {
+            const glm::ivec2 texels = glm::max(glm::ivec2(glm::ceil((chart.max - chart.min) * density)), glm::ivec2(1));
+            chart.size = texels + 2 * PADDING;
+            area += double(chart.size.x) * chart.size.y;
+            widest = std::max(widest, chart.size.x);
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return charts[a].size.y > charts[b].size.y; });
+        atlasWidth = (std::max(widest, static_cast<int>(std::ceil(std::sqrt(area) * 1.05))) + 3) & ~3;
+        glm::ivec2 cursor(0);
+        int shelfHeight = 0;
+        for (int index : order) {
+            Chart& chart = charts[index];
+            if (cursor.x + chart.size.x > atlasWidth) { cursor = glm::ivec2(0, cursor.y + shelfHeight); shelfHeight = 0; }
+            chart.origin = cursor;
+            cursor.x += chart.size.x;
+            shelfHeight = std::max(shelfHeight, chart.size.y);
+        }
+        atlasHeight = (cursor.y + shelfHeight + 3) & ~3;
+        if (atlasWidth <= settings.maxAtlasSize && atlasHeight <= settings.maxAtlasSize) break;
+        if (density < 1e-3f) return fail();
+        density *= 0.8f;
+    }
+
+    texelChart.assign(static_cast<size_t>(atlasWidth) * atlasHeight, -1);
+    for (size_t c = 0; c < charts.size(); ++c) {
+        const Chart& chart = charts[c];
+        for (int y = 0; y < chart.size.y; ++y)
+            std::fill_n(&texelChart[static_cast<size_t>(chart.origin.y + y) * atlasWidth + chart.origin.x], chart.size.x, static_cast<int>(c));
+    }
+    const glm::vec2 atlasSize(static_cast<float>(atlasWidth), static_cast<float>(atlasHeight));
+    for (size_t v = 0; v < triangles.size(); ++v) {
+        const Chart& chart = charts[triangleChart[v / 3]];
+        const glm::vec2 s(glm::dot(triangles[v], chart.axisU), glm::dot(triangles[v], chart.axisV));
+        vertexUVs[v] = (glm::vec2(chart.origin + PADDING) + (s - chart.min) * density) / atlasSize;
+    }
+    return true;
+}
+
+bool Lightmap::texelSurface(int x, int y, glm::vec3& position, glm::vec3& normal) const
+{
+    const int chartIndex = texelChart[static_cast<size_t>(y) * atlasWidth + x];
+    if (chartIndex < 0) return false;
+    const Chart& chart = charts[chartIndex];
+    const glm::vec2 local = (glm::vec2(static_cast<float>(x), static_cast<float>(y)) + 0.5f - glm::vec2(chart.origin + PADDING)) / density;
+    const glm::vec2 inset = glm::min(glm::vec2(0.5f / density), (chart.max - chart.min) * 0.5f);
+    const glm::vec2 s = glm::clamp(chart.min + local, chart.min + inset, chart.max - inset);
+    position = chart.normal * chart.planeDistance + chart.axisU * s.x + chart.axisV * s.y;
+    normal = chart.normal;
+    return true;
+}
+
+void Lightmap::bake(const MeshBVH& occluders, const LightmapSettings& settings, JobSystem* jobs)
+{
+    rgbm.assign(static_cast<size_t>(atlasWidth) * atlasHeight * 4, 0);
+    bakedWith = settings;
+    const glm::vec3 toSun = glm::normalize(-settings.sunDirection);
+    const float far = glm::length(occluders.boundsMax() - occluders.boundsMin()) + 1.0f;
+    const int samples = std::max(settings.samples, 1);
+
+    // Irradiância do sol: cosseno e raio de sombra
+    auto direct = [&](const glm::vec3& p, const glm::vec3& n) {
+        const float cosine = glm::dot(n, toSun);
+        if (cosine <= 0.0f || occluders.occluded(p, toSun, far)) return glm::vec3(0.0f);
+        return settings.sunColor * cosine;
+    };
+
+    auto bakeRows = [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            for (int x = 0; x < atlasWidth; ++x) {
+                const size_t texel = y * atlasWidth + x;
+                glm::vec3 p, n;
+                if (!texelSurface(x, static_cast<int>(y), p, n)) continue;
+                p = p + n * SURFACE_OFFSET;
+
+                // Indireto: caminhos com amostragem por cosseno; cada ponto atingido
+                // devolve albedo/π da luz direta que recebe, e o caminho segue
+                Random random(static_cast<uint32_t>(texel));
+                glm::vec3 gathered(0.0f);
+                for (int i = 0; i < samples; ++i) {
+                    glm::vec3 origin = p, normal = n, throughput(1.0f);
+                    for (int bounce = 0; bounce < settings.bounces; ++bounce) {
+                        const glm::vec3 dir = cosineSample(normal, random);
+                        float distance = far;
+                        if (!occluders.raycast(origin, dir, distance, normal)) {
+                            gathered += throughput * settings.skyColor / PI;
+                            break;
+                        }
+                        origin = origin + dir * distance + normal * SURFACE_OFFSET;
+                        gathered += throughput * settings.albedo / PI * direct(origin, normal);
+                        throughput *= settings.albedo;
+                    }
+                }
+                const glm::vec3 light = direct(p, n) + gathered * (PI / samples);
+                encodeRgbm(light, &rgbm[texel * 4]);
+            }
+        }
+    };
+    if (jobs) jobs->parallelFor(static_cast<size_t>(atlasHeight), 4, bakeRows);
+    else bakeRows(0, static_cast<size_t>(atlasHeight));
+}
+
+void Lightmap::serialize(std::vector<char>& out) const
+{
+    ByteWriter writer;
+    writer.write(bakedWith);
+    writer.write(atlasWidth);
+    writer.write(atlasHeight);
+    writer.writeArray(rgbm);
+    out = std::move(writer.data);
+}
+
+bool Lightmap::deserialize(const std::vector<char>& in)
+{
+    ByteReader reader(in);
+    int width = 0, height = 0;
+    bool ok = reader.read(bakedWith) && reader.read(width) && reader.read(height) && reader.readArray(rgbm);
+    // O atlas guardado só serve para o mesmo desdobramento
+    if (!ok || width != atlasWidth || height != atlasHeight || rgbm.size() != static_cast<size_t>(width) * height * 4) {
+        rgbm.clear();
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// OCLUSÃO AMBIENTE
+// ============================================================================
+void AmbientOcclusion::bake(const Lightmap& atlas, const MeshBVH& occluders, const OcclusionSettings& settings, JobSystem* jobs)
+{
+    atlasWidth = atlas.width();
+    atlasHeight = atlas.height();
+    values.assign(static_cast<size_t>(atlasWidth) * atlasHeight, 255);
+    bakedWith = settings;
+    const int samples = std::max(settings.samples, 1);
+
+    // Só raios de sombra (qualquer acerto serve), curtos: bem mais barato que o lightmap
+    auto bakeRows = [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            for (int x = 0; x < atlasWidth; ++x) {
+                glm::vec3 p, n;
+                if (!atlas.texelSurface(x, static_cast<int>(y), p, n)) continue;
+                p = p + n * SURFACE_OFFSET;
+                Random random(static_cast<uint32_t>(y * atlasWidth + x));
+                int open = 0;
+                for (int i = 0; i < samples; ++i) open += !occluders.occluded(p, cosineSample(n, random), settings.radius);
+                values[y * atlasWidth + x] = static_cast<uint8_t>((open * 255 + samples / 2) / samples);
+            }
+        }
+    };
+    if (jobs) jobs->parallelFor(static_cast<size_t>(atlasHeight), 4, bakeRows);
+    else bakeRows(0, static_cast<size_t>(atlasHeight));
+}
+
+void AmbientOcclusion::serialize(std::vector<char>& out) const
+{
+    ByteWriter writer;
+    writer.write(bakedWith);
+    writer.write(atlasWidth);
+    writer.write(atlasHeight);
+    writer.writeArray(values);
+    out = std::move(writer.data);
+}
+
+bool AmbientOcclusion::deserialize(const std::vector<char>& in, const Lightmap& atlas)
+{
+    ByteReader reader(in);
+    bool ok = reader.read(bakedWith) && reader.read(atlasWidth) && reader.read(atlasHeight) && reader.readArray(values);
+    if (!ok || atlasWidth != atlas.width() || atlasHeight != atlas.height() || values.size() != static_cast<size_t>(atlasWidth) * atlasHeight) {
+        values.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+class MeshBVH;
+
+// ============================================================================
+// LIGHTMAP DA GEOMETRIA ESTÁTICA
+// ============================================================================
+// Paredes e piso não se mexem: a luz do sol (com sombra) e a luz indireta que
+// quica entre eles são calculadas uma vez, por path tracing na CPU sobre a BVH
+// da cena, e guardadas num atlas. Em tempo de execução o shader só lê uma
+// amostra do atlas no lugar do modelo de iluminação.
+//
+// O desdobramento é por cartas planas: triângulos seguidos no mesmo plano e
+// com uma aresta em comum (as faces das caixas e os quads do piso) viram um
+// retângulo do atlas, empacotado em prateleiras.
+//
+// A oclusão ambiente (AmbientOcclusion) usa o mesmo desdobramento: é a
+// alternativa barata ao lightmap, um byte por texel que só escurece a luz
+// ambiente do modelo de iluminação normal.
+
+struct LightmapSettings {
+    float texelsPerMeter = 2.0f;       // Densidade pedida (diminui se o atlas não couber)
+    int maxAtlasSize = 2048;
+    int samples = 32;                  // Caminhos indiretos por texel
+    int bounces = 2;                   // Quiques de cada caminho
+    glm::vec3 sunDirection = glm::vec3(-0.5f, -1.0f, -0.5f); // A mesma luz direcional do shader
+    glm::vec3 sunColor = glm::vec3(0.8f);
+    glm::vec3 skyColor = glm::vec3(0.3f, 0.32f, 0.38f);      // Irradiância de uma face voltada para o céu aberto
+    glm::vec3 albedo = glm::vec3(0.6f, 0.5f, 0.4f);           // objectColor da cena
+
+    bool operator==(const LightmapSettings& other) const;
+};
+
+class Lightmap
+{
+public:
+    // Faixa do RGBM: luz = rgb * a * RGBM_RANGE (mesmo valor em shader.frag)
+    static constexpr float RGBM_RANGE = 4.0f;
+
+    // `triangles` tem 3 vértices por triângulo; sai uma UV por vértice, na mesma ordem.
+    // false (e atlas vazio) se as cartas não couberem em maxAtlasSize nem com a
+    // densidade mínima: cada carta ocupa pelo menos um texel mais a margem
+    bool unwrap(const std::vector<glm::vec3>& triangles, const LightmapSettings& settings);
+    // Ponto da superfície e normal no centro do texel (x, y); false fora das cartas.
+    // O ponto fica preso meio texel para dentro da carta: a margem repete a borda
+    // e os cantos não entram nas paredes vizinhas
+    bool texelSurface(int x, int y, glm::vec3& position, glm::vec3& normal) const;
+    // Ilumina todos os texels do atlas; com `jobs`, as linhas são repartidas entre as threads
+    void bake(const MeshBVH& occluders, const LightmapSettings& settings, JobSystem* jobs = nullptr);
+
+    bool empty() const { return rgbm.empty(); }
+    int width() const { return atlasWidth; }
+    int height() const { return atlasHeight; }
+    float texelsPerMeter() const { return density; }
+    size_t chartCount() const { return charts.size(); }
+    const std::vector<glm::vec2>& uvs() const { return vertexUVs; }
+    const std::vector<uint8_t>& texels() const { return rgbm; } // RGBA8 (RGBM), linha a linha
+    size_t memoryBytes() const { return rgbm.capacity() + vertexUVs.capacity() * sizeof(glm::vec2); }
+
+    // Conservação no arquivo de dados pré-calculados (BakedScene); o desdobramento
+    // não é guardado, é refeito (é determinístico e barato) antes de deserialize
+    void serialize(std::vector<char>& out) const;
+    bool deserialize(const std::vector<char>& in);
+    bool matches(const LightmapSettings& settings) const { return !rgbm.empty() && bakedWith == settings; }
+
+private:
+    struct Chart {
+        glm::vec3 normal, axisU, axisV;
+        float planeDistance;
+        glm::vec2 min, max;            // Retângulo no plano (metros)
+        glm::ivec2 origin, size;       // Retângulo no atlas (texels, com a margem)
+    };
+
+    std::vector<Chart> charts;
+    std::vector<int> texelChart;       // Carta de cada texel (-1 = vazio)
+    std::vector<glm::vec2> vertexUVs;
+    std::vector<uint8_t> rgbm;
+    int atlasWidth = 0, atlasHeight = 0;
+    float density = 0.0f;
+    LightmapSettings bakedWith;
+};
+
+struct OcclusionSettings {
+    int samples = 24;                  // Raios por texel
+    float radius = 1.0f;               // Alcance dos raios (metros): só a geometria próxima escurece
+
+    bool operator==(const OcclusionSettings& other) const
+    {
+        return samples == other.samples && radius == other.radius;
+    }
+};
+
+// Fração do hemisfério (ponderada pelo cosseno) livre até `radius`, por texel do
+// atlas de um Lightmap já desdobrado: 255 = nada em volta, 0 = fechado
+class AmbientOcclusion
+{
+public:
+    void bake(const Lightmap& atlas, const MeshBVH& occluders, const OcclusionSettings& settings, JobSystem* jobs = nullptr);
+
+    bool empty() const { return values.empty(); }
+    int width() const { return atlasWidth; }
+    int height() const { return atlasHeight; }
+    const std::vector<uint8_t>& texels() const { return values; } // R8, linha a linha
+    size_t memoryBytes() const { return values.capacity(); }
+
+    // Como no Lightmap: só vale para o mesmo desdobramento de `atlas`
+    void serialize(std::vector<char>& out) const;
+    bool deserialize(const std::vector<char>& in, const Lightmap& atlas);
+    bool matches(const OcclusionSettings& settings) const { return !values.empty() && bakedWith == settings; }
+
+private:
+    std::vector<uint8_t> values;
+    int atlasWidth = 0, atlasHeight = 0;
+    OcclusionSettings bakedWith;
+};
@@ -0,0 +1,157 @@
+// ============================================================================
+// GERAÇÃO E SOLUÇÃO DE LABIRINTOS EM LOTE (sem janela nem contexto OpenGL)
+// ============================================================================
+// Gera labirintos de vários tamanhos e sementes em paralelo, resolve cada um do
+// início ao portal com BFS, A* e BFS bit-paralela e confere que as três acham
+// a mesma distância. Mede a vazão (labirintos/s, células/s) e a memória por
+// célula do layout e de cada busca.
+#include "JobSystem.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    struct Options {
+        std::vector<int> sizes = {32, 64, 128, 256, 512};
+        int seeds = 32;
+        unsigned int threads = 0;      // 0 = pool compartilhado (um por núcleo)
+        std::vector<MazeAlgorithm> algorithms = {MazeAlgorithm::Backtracker, MazeAlgorithm::Wilson, MazeAlgorithm::Kruskal};
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+                options.sizes.clear();
+                std::stringstream list(argv[++i]);
+                for (std::string item; std::getline(list, item, ',');) {
+                    const int size = std::atoi(item.c_str());
+                    if (size < 2 || size > 65535) return false;
+                    options.sizes.push_back(size);
+                }
+                if (options.sizes.empty()) return false;
+            } else if (std::strcmp(argv[i], "--seeds") == 0 && hasValue) {
+                options.seeds = std::atoi(argv[++i]);
+                if (options.seeds < 1) return false;
+            } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+                const int threads = std::atoi(argv[++i]);
+                if (threads < 1) return false;
+                options.threads = static_cast<unsigned int>(threads);
+            } else if (std::strcmp(argv[i], "--algorithm") == 0 && hasValue) {
+                MazeAlgorithm algorithm;
+                const char* name = argv[++i];
+                if (std::strcmp(name, "all") == 0) continue;
+                if (!parseMazeAlgorithm(name, algorithm)) return false;
+                options.algorithms = {algorithm};
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Resultado de uma semente; os tempos são de CPU da thread que a processou
+    struct SeedResult {
+        double generateSeconds = 0.0;
+        double solveSeconds[3] = {};
+        size_t solveBytes[3] = {};
+        size_t layoutBytes = 0;
+        int length = 0;
+        bool agree = true;
+    };
+
+    const char* const SOLVER_NAMES[3] = {"BFS", "A*", "BFS bits"};
+
+    void runBatch(JobSystem& jobs, MazeAlgorithm algorithm, int size, int seeds)
+    {
+        std::vector<SeedResult> results(static_cast<size_t>(seeds));
+        const auto start = Clock::now();
+        jobs.parallelFor(results.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                SeedResult& r = results[i];
+                auto phase = Clock::now();
+                const MazeLayout maze = generateMaze(size, size, algorithm, static_cast<uint32_t>(i + 1));
+                r.generateSeconds = secondsSince(phase);
+                r.layoutBytes = maze.walls.capacity() + maze.chestCells.capacity() * sizeof(glm::ivec2);
+
+                MazeSolution (*const solvers[3])(const MazeLayout&, const glm::ivec2&, const glm::ivec2&) = {
+                    solveMazeBfs, solveMazeAStar, solveMazeBitBfs};
+                for (int s = 0; s < 3; ++s) {
+                    phase = Clock::now();
+                    const MazeSolution solution = solvers[s](maze, maze.startCell, maze.portalCell);
+                    r.solveSeconds[s] = secondsSince(phase);
+                    r.solveBytes[s] = solution.memoryBytes;
+                    if (s == 0) r.length = solution.length;
+                    else r.agree &= solution.length == r.length;
+                }
+                r.agree &= r.length > 0;
+            }
+        });
+        const double wall = secondsSince(start);
+
+        const double cells = double(size) * size;
+        double generate = 0.0, solve[3] = {}, solveBytes[3] = {}, layoutBytes = 0.0, length = 0.0;
+        int mismatches = 0;
+        for (const SeedResult& r : results) {
+            generate += r.generateSeconds;
+            layoutBytes += r.layoutBytes;
+            length += r.length;
+            mismatches += !r.agree;
+            for (int s = 0; s < 3; ++s) { solve[s] += r.solveSeconds[s]; solveBytes[s] += r.solveBytes[s]; }
+        }
+        const double n = seeds;
+        std::cout << std::setw(12) << mazeAlgorithmName(algorithm) << std::setw(7) << size
+                  << std::setw(11) << std::fixed << std::setprecision(1) << n / wall
+                  << std::setw(11) << std::setprecision(2) << n * cells / wall / 1e6
+                  << std::setw(10) << std::setprecision(3) << generate / n * 1e3;
+        for (int s = 0; s < 3; ++s) std::cout << std::setw(10) << solve[s] / n * 1e3;
+        std::cout << std::setw(10) << std::setprecision(2) << layoutBytes / n / cells;
+        for (int s = 0; s < 3; ++s) std::cout << std::setw(9) << solveBytes[s] / n / cells;
+        std::cout << std::setw(10) << std::setprecision(0) << length / n
+                  << std::setw(6) << mismatches << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Uso: " << argv[0] << " [--sizes 32,128,512] [--seeds N] [--threads N] "
+                  << "[--algorithm backtracker|wilson|kruskal|all]" << std::endl;
+        return 1;
+    }
+    std::unique_ptr<JobSystem> ownPool;
+    if (options.threads > 0) ownPool = std::make_unique<JobSystem>(options.threads - 1);
+    JobSystem& jobs = ownPool ? *ownPool : JobSystem::shared();
+
+    std::cout << "=== LABIRINTOS EM LOTE: GERAÇÃO + " << SOLVER_NAMES[0] << " / " << SOLVER_NAMES[1] << " / " << SOLVER_NAMES[2]
+              << " (" << options.seeds << " sementes por tamanho, " << jobs.threadCount() << " threads) ===" << std::endl;
+    std::cout << "tempos em ms por labirinto (CPU de uma thread); memória em bytes por célula" << std::endl;
+    std::cout << std::setw(12) << "algoritmo" << std::setw(7) << "lado" << std::setw(11) << "lab./s"
+              << std::setw(11) << "Mcél./s" << std::setw(10) << "gerar";
+    for (const char* name : SOLVER_NAMES) std::cout << std::setw(10) << name;
+    std::cout << std::setw(10) << "B/layout";
+    for (const char* name : SOLVER_NAMES) std::cout << std::setw(9) << name;
+    std::cout << std::setw(10) << "caminho" << std::setw(6) << "erros" << std::endl;
+
+    for (MazeAlgorithm algorithm : options.algorithms) {
+        for (int size : options.sizes) runBatch(jobs, algorithm, size, options.seeds);
+    }
+    return 0;
+}
@@ -0,0 +1,292 @@
+#include "MazeGenerator.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+
+namespace {
+    // Direções: 0 = leste, 1 = oeste, 2 = sul, 3 = norte
+    const int DX[4] = {1, -1, 0, 0};
+    const int DZ[4] = {0, 0, 1, -1};
+
+    struct Carver {
+        MazeLayout& maze;
+        bool valid(int x, int z, int d) const
+        {
+            const int nx = x + DX[d], nz = z + DZ[d];
+            return nx >= 0 && nz >= 0 && nx < maze.width && nz < maze.height;
+        }
+        // Remove a parede entre `cell` e o vizinho na direção `d`
+        void carve(int cell, int d) const
+        {
+            switch (d) {
+            case 0: maze.walls[cell] &= ~MazeLayout::WALL_EAST; break;
+            case 1: maze.walls[cell - 1] &= ~MazeLayout::WALL_EAST; break;
+            case 2: maze.walls[cell] &= ~MazeLayout::WALL_SOUTH; break;
+            default: maze.walls[cell - maze.width] &= ~MazeLayout::WALL_SOUTH; break;
+            }
+        }
+        int neighbor(int cell, int d) const { return cell + DX[d] + DZ[d] * maze.width; }
+    };
+
+    void backtracker(MazeLayout& maze, std::mt19937& rng)
+    {
+        const Carver carver{maze};
+        std::vector<uint8_t> visited(maze.walls.size(), 0);
+        std::vector<int> stack = {0};
+        visited[0] = 1;
+        while (!stack.empty()) {
+            const int current = stack.back();
+            const int x = current % maze.width, z = current / maze.width;
+            int options[4], count = 0;
+            for (int d = 0; d < 4; ++d) {
+                if (carver.valid(x, z, d) && !visited[carver.neighbor(current, d)]) options[count++] = d;
+            }
+            if (count == 0) { stack.pop_back(); continue; }
+            const int d = options[rng() % count];
+            const int next = carver.neighbor(current, d);
+            carver.carve(current, d);
+            visited[next] = 1;
+            stack.push_back(next);
+        }
+    }
+
+    void wilson(MazeLayout& maze, std::mt19937& rng)
+    {
+        // Passeio aleatório até a árvore; a última direção tomada em cada célula
+        // apaga os laços sozinha, então o caminho refeito já é sem laço
+        const Carver carver{maze};
+        const int cellCount = static_cast<int>(maze.walls.size());
+        std::vector<uint8_t> inTree(cellCount, 0), walkDirection(cellCount, 0);
+        inTree[rng() % cellCount] = 1;
+        for (int origin = 0; origin < cellCount; ++origin) {
+            int current = origin;
+            while (!inTree[current]) {
+                const int x = current % maze.width, z = current / maze.width;
+                int d;
+                do { d = static_cast<int>(rng() & 3u); } while (!carver.valid(x, z, d));
+                walkDirection[current] = static_cast<uint8_t>(d);
+                current = carver.neighbor(current, d);
+            }
+            for (current = origin; !inTree[current]; current = carver.neighbor(current, walkDirection[current])) {
+                carver.carve(current, walkDirection[current]);
+                inTree[current] = 1;
+            }
+        }
+    }
+
+    int findRoot(std::vector<int>& parent, int i)
+    {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];     // Compressão pela metade
+            i = parent[i];
+        }
+        return i;
+    }
+
+    void kruskal(MazeLayout& maze, std::mt19937& rng)
+    {
+        // Aresta = (célula << 1) | (1 se for a parede sul)
+        std::vector<uint32_t> edges;
+        edges.reserve(maze.walls.size() * 2);
+        for (int z = 0; z < maze.height; ++z) {
+            for (int x = 0; x < maze.width; ++x) {
+                const uint32_t cell = static_cast<uint32_t>(z * maze.width + x);
+                if (x + 1 < maze.width) edges.push_back(cell << 1);
+                if (z + 1 < maze.height) edges.push_back((cell << 1) | 1u);
+            }
+        }
+        std::shuffle(edges.begin(), edges.end(), rng);
+
+        std::vector<int> parent(maze.walls.size()), size(maze.walls.size(), 1);
+        std::iota(parent.begin(), parent.end(), 0);
+        for (uint32_t edge : edges) {
+            const int cell = static_cast<int>(edge >> 1);
+            const bool south = edge & 1u;
+            int a = findRoot(parent, cell), b = findRoot(parent, south ? cell + maze.width : cell + 1);
+            if (a == b) continue;
+            if (size[a] < size[b]) std::swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+            maze.walls[cell] &= south ? ~MazeLayout::WALL_SOUTH : ~MazeLayout::WALL_EAST;
+        }
+    }
+
+    // Portal na célula mais distante do início; baús em becos sem saída sorteados
+    void placeObjectives(MazeLayout& maze, std::mt19937& rng, int chestCount)
+    {
+        const Carver carver{maze};
+        const int cellCount = static_cast<int>(maze.walls.size());
+        auto open = [&](int cell, int d) {
+            const int x = cell % maze.width, z = cell / maze.width;
+            if (!carver.valid(x, z, d)) return false;
+            switch (d) {
+            case 0: return !maze.wallEast(x, z);
+            case 1: return !maze.wallEast(x - 1, z);
+            case 2: return !maze.wallSouth(x, z);
+            default: return !maze.wallSouth(x, z - 1);
+            }
+        };
+
+        std::vector<int> distance(cellCount, -1), queue;
+        queue.reserve(cellCount);
+        const int start = maze.startCell.y * maze.width + maze.startCell.x;
+        distance[start] = 0;
+        queue.push_back(start);
+        int farthest = start;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const int cell = queue[head];
+            if (distance[cell] > distance[farthest]) farthest = cell;
+            for (int d = 0; d < 4; ++d) {
+                if (!open(cell, d)) continue;
+                const int next = carver.neighbor(cell, d);
+                if (distance[next] >= 0) continue;
+                distance[next] = distance[cell] + 1;
+                queue.push_back(next);
+            }
+        }
+        maze.portalCell = glm::ivec2(farthest % maze.width, farthest / maze.width);
+
+        std::vector<int> deadEnds;
+        for (int cell = 0; cell < cellCount; ++cell) {
+            if (cell == start || cell == farthest) continue;
+            int exits = 0;
+            for (int d = 0; d < 4; ++d) exits += open(cell, d) ? 1 : 0;
+            if (exits == 1) deadEnds.push_back(cell);
+        }
+        // Sorteio parcial (Fisher-Yates só nas primeiras posições)
+        const int picks = std::min(chestCount, static_cast<int>(deadEnds.size()));
+        for (int i = 0; i < picks; ++i) {
+            std::swap(deadEnds[i], deadEnds[i + rng() % (deadEnds.size() - i)]);
+            maze.chestCells.push_back(glm::ivec2(deadEnds[i] % maze.width, deadEnds[i] / maze.width));
+        }
+    }
+}
+
+bool parseMazeAlgorithm(const char* name, MazeAlgorithm& algorithm)
+{
+    if (std::strcmp(name, "backtracker") == 0) algorithm = MazeAlgorithm::Backtracker;
+    else if (std::strcmp(name, "wilson") == 0) algorithm = MazeAlgorithm::Wilson;
+    else if (std::strcmp(name, "kruskal") == 0) algorithm = MazeAlgorithm::Kruskal;
+    else return false;
+    return true;
+}
+
+const char* mazeAlgorithmName(MazeAlgorithm algorithm)
+{
+    switch (algorithm) {
+    case MazeAlgorithm::Wilson: return "wilson";
+    case MazeAlgorithm::Kruskal: return "kruskal";
+    default: return "backtracker";
+    }
+}
+
+MazeLayout generateMaze(int width, int height, MazeAlgorithm algorithm, uint32_t seed, int chestCount)
+{
+    MazeLayout maze;
+    maze.width = std::max(1, width);
+    maze.height = std::max(1, height);
+    maze.walls.assign(static_cast<size_t>(maze.width) * maze.height, MazeLayout::WALL_EAST | MazeLayout::WALL_SOUTH);
+    std::mt19937 rng(seed);
+    switch (algorithm) {
+    case MazeAlgorithm::Backtracker: backtracker(maze, rng); break;
+    case MazeAlgorithm::Wilson: wilson(maze, rng); break;
+    case MazeAlgorithm::Kruskal: kruskal(maze, rng); break;
+    }
+    placeObjectives(maze, rng, chestCount);
+    return maze;
+}
+
+void appendBox(std::vector<glm::vec3>& out, const glm::vec3& lo, const glm::vec3& hi)
+{
+    glm::vec3 c[8];
+    for (int i = 0; i < 8; ++i) c[i] = glm::vec3(i & 1 ? hi.x : lo.x, i & 2 ? hi.y : lo.y, i & 4 ? hi.z : lo.z);
+    // Faces em sentido anti-horário vistas de fora: a normal do triângulo aponta para fora
+    const int faces[6][4] = {{0, 4, 6, 2}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 2, 3, 1}, {4, 5, 7, 6}};
+    for (const auto& f : faces) {
+        out.insert(out.end(), {c[f[0]], c[f[1]], c[f[2]], c[f[0]], c[f[2]], c[f[3]]});
+    }
+}
+
+void buildMazeBlock(const MazeLayout& maze, float cellSize, const glm::ivec2& first, const glm::ivec2& last,
+                    std::vector<glm::vec3>& walls, std::vector<glm::vec3>& floor)
+{
+    const float thickness = 0.2f, height = 3.0f;
+    const int x0 = first.x, z0 = first.y, x1 = last.x, z1 = last.y;
+
+    // Paredes leste: trechos contíguos ao longo de z viram uma caixa
+    for (int x = x0; x < x1; ++x) {
+        for (int z = z0; z < z1;) {
+            if (!maze.wallEast(x, z)) { ++z; continue; }
+            int runEnd = z;
+            while (runEnd < z1 && maze.wallEast(x, runEnd)) ++runEnd;
+            appendBox(walls, glm::vec3((x + 1) * cellSize - thickness, 0.0f, z * cellSize),
+                      glm::vec3((x + 1) * cellSize, height, runEnd * cellSize));
+            z = runEnd;
+        }
+    }
+    // Paredes sul: trechos contíguos ao longo de x
+    for (int z = z0; z < z1; ++z) {
+        for (int x = x0; x < x1;) {
+            if (!maze.wallSouth(x, z)) { ++x; continue; }
+            int runEnd = x;
+            while (runEnd < x1 && maze.wallSouth(runEnd, z)) ++runEnd;
+            appendBox(walls, glm::vec3(x * cellSize, 0.0f, (z + 1) * cellSize - thickness),
+                      glm::vec3(runEnd * cellSize, height, (z + 1) * cellSize));
+            x = runEnd;
+        }
+    }
+    // Bordas oeste e norte do labirinto
+    if (x0 == 0) appendBox(walls, glm::vec3(0.0f, 0.0f, z0 * cellSize), glm::vec3(thickness, height, z1 * cellSize));
+    if (z0 == 0) appendBox(walls, glm::vec3(x0 * cellSize, 0.0f, 0.0f), glm::vec3(x1 * cellSize, height, thickness));
+
+    const glm::vec3 p0(x0 * cellSize, 0.0f, z0 * cellSize), p2(x1 * cellSize, 0.0f, z1 * cellSize);
+    const glm::vec3 p1(p0.x, 0.0f, p2.z), p3(p2.x, 0.0f, p0.z);
+    floor.insert(floor.end(), {p0, p1, p2, p0, p2, p3});  // Voltado para cima
+}
+
+void buildMazeGeometry(const MazeLayout& maze, float cellSize, MazeGeometry& out, int blockSize, JobSystem* jobs)
+{
+    const int blocksX = (maze.width + blockSize - 1) / blockSize;
+    const int blocksZ = (maze.height + blockSize - 1) / blockSize;
+    out.wallBlocks.assign(static_cast<size_t>(blocksX) * blocksZ, {});
+    out.floorBlocks.assign(out.wallBlocks.size(), {});
+
+    auto buildBlocks = [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const glm::ivec2 first(static_cast<int>(b % blocksX) * blockSize, static_cast<int>(b / blocksX) * blockSize);
+            const glm::ivec2 last = glm::min(first + blockSize, glm::ivec2(maze.width, maze.height));
+            buildMazeBlock(maze, cellSize, first, last, out.wallBlocks[b], out.floorBlocks[b]);
+        }
+    };
+    if (jobs) jobs->parallelFor(out.wallBlocks.size(), 4, buildBlocks);
+    else buildBlocks(0, out.wallBlocks.size());
+
+    buildMazeObjectives(maze, cellSize, out);
+}
+
+void buildMazeObjectives(const MazeLayout& maze, float cellSize, MazeGeometry& out)
+{
+    // Baús (base e tampa) e portal, centrados nas suas células
+    out.chests.clear();
+    for (const glm::ivec2& cell : maze.chestCells) {
+        const glm::vec3 center = mazeCellCenter(cell, cellSize);
+        MazeGeometry::ChestParts chest;
+        appendBox(chest.base, center + glm::vec3(-0.4f, 0.0f, -0.3f), center + glm::vec3(0.4f, 0.5f, 0.3f));
+        appendBox(chest.lid, center + glm::vec3(-0.4f, 0.5f, -0.3f), center + glm::vec3(0.4f, 0.7f, 0.3f));
+        out.chests.push_back(std::move(chest));
+    }
+    out.portal.clear();
+    const glm::vec3 portalCenter = mazeCellCenter(maze.portalCell, cellSize);
+    appendBox(out.portal, portalCenter + glm::vec3(-0.6f, 0.0f, -0.1f), portalCenter + glm::vec3(0.6f, 2.4f, 0.1f));
+}
+
+void interleaveFaceNormals(const std::vector<glm::vec3>& triangles, std::vector<float>& out)
+{
+    out.reserve(out.size() + triangles.size() * 6);
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        const glm::vec3 n = glm::normalize(glm::cross(triangles[i + 1] - triangles[i], triangles[i + 2] - triangles[i]));
+        for (size_t k = i; k < i + 3; ++k) out.insert(out.end(), {triangles[k].x, triangles[k].y, triangles[k].z, n.x, n.y, n.z});
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// ============================================================================
+// GERADOR DE LABIRINTOS
+// ============================================================================
+// Labirintos perfeitos (um único caminho entre duas células quaisquer) gerados
+// a partir de uma semente, sem passar por arquivo OBJ: o layout em células
+// vira direto a geometria que o jogo usa (paredes, piso, baús e portal).
+
+enum class MazeAlgorithm {
+    Backtracker,                       // Busca em profundidade: corredores longos
+    Wilson,                            // Passeios aleatórios sem laço: árvore uniforme
+    Kruskal                            // Arestas embaralhadas + união-busca: muitos becos curtos
+};
+
+// Aceita "backtracker", "wilson" e "kruskal"
+bool parseMazeAlgorithm(const char* name, MazeAlgorithm& algorithm);
+const char* mazeAlgorithmName(MazeAlgorithm algorithm);
+
+// Layout em células; cada célula guarda as paredes das suas bordas leste e
+// sul (as bordas oeste e norte do labirinto são sempre fechadas)
+struct MazeLayout {
+    static constexpr uint8_t WALL_EAST = 1;
+    static constexpr uint8_t WALL_SOUTH = 2;
+
+    int width = 0, height = 0;
+    std::vector<uint8_t> walls;
+    glm::ivec2 startCell = glm::ivec2(0);
+    glm::ivec2 portalCell = glm::ivec2(0);     // Célula mais distante do início
+    std::vector<glm::ivec2> chestCells;        // Becos sem saída sorteados
+
+    bool wallEast(int x, int z) const { return walls[static_cast<size_t>(z) * width + x] & WALL_EAST; }
+    bool wallSouth(int x, int z) const { return walls[static_cast<size_t>(z) * width + x] & WALL_SOUTH; }
+};
+
+// Triângulos prontos para o motor (3 vértices por triângulo, como os do OBJ)
+struct MazeGeometry {
+    struct ChestParts {
+        std::vector<glm::vec3> base, lid;
+    };
+    std::vector<std::vector<glm::vec3>> wallBlocks;  // Um collider por bloco de células
+    std::vector<std::vector<glm::vec3>> floorBlocks; // Um quad de piso por bloco
+    std::vector<ChestParts> chests;
+    std::vector<glm::vec3> portal;
+};
+
+MazeLayout generateMaze(int width, int height, MazeAlgorithm algorithm, uint32_t seed, int chestCount = 3);
+
+// Paredes e piso das células [first, last): blocos vizinhos se encaixam sem sobreposição
+void buildMazeBlock(const MazeLayout& maze, float cellSize, const glm::ivec2& first, const glm::ivec2& last,
+                    std::vector<glm::vec3>& walls, std::vector<glm::vec3>& floor);
+
+// Paredes contíguas viram uma caixa só; os blocos são independentes e saem em paralelo
+void buildMazeGeometry(const MazeLayout& maze, float cellSize, MazeGeometry& out, int blockSize = 16, JobSystem* jobs = nullptr);
+// Só os baús e o portal (o resto pode vir de buildMazeBlock, por partes)
+void buildMazeObjectives(const MazeLayout& maze, float cellSize, MazeGeometry& out);
+
+// Centro da célula no chão (y = 0)
+inline glm::vec3 mazeCellCenter(const glm::ivec2& c, float cellSize)
+{
+    return glm::vec3((c.x + 0.5f) * cellSize, 0.0f, (c.y + 0.5f) * cellSize);
+}
+
+// Caixa alinhada aos eixos como 12 triângulos (mesma forma das paredes exportadas do Blender)
+void appendBox(std::vector<glm::vec3>& out, const glm::vec3& lo, const glm::vec3& hi);
+
+// Geometria gerada não traz normais: posição + normal da face, como os VBOs da cena
+void interleaveFaceNormals(const std::vector<glm::vec3>& triangles, std::vector<float>& out);
@@ -0,0 +1,171 @@
+#include "MazeSolver.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    // Vizinhos abertos da célula `cell` (x, z já decompostos)
+    template <typename Visit>
+    void forEachOpen(const MazeLayout& maze, int cell, Visit&& visit)
+    {
+        const int x = cell % maze.width, z = cell / maze.width;
+        if (x + 1 < maze.width && !maze.wallEast(x, z)) visit(cell + 1);
+        if (x > 0 && !maze.wallEast(x - 1, z)) visit(cell - 1);
+        if (z + 1 < maze.height && !maze.wallSouth(x, z)) visit(cell + maze.width);
+        if (z > 0 && !maze.wallSouth(x, z - 1)) visit(cell - maze.width);
+    }
+
+    bool inside(const MazeLayout& maze, const glm::ivec2& c)
+    {
+        return c.x >= 0 && c.y >= 0 && c.x < maze.width && c.y < maze.height;
+    }
+}
+
+MazeSolution solveMazeBfs(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal)
+{
+    MazeSolution result;
+    if (!inside(maze, start) || !inside(maze, goal)) return result;
+    const int cellCount = maze.width * maze.height;
+    const int source = start.y * maze.width + start.x, target = goal.y * maze.width + goal.x;
+    std::vector<int> distance(cellCount, -1), queue;
+    queue.reserve(cellCount);
+    distance[source] = 0;
+    queue.push_back(source);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int cell = queue[head];
+        if (cell == target) break;
+        forEachOpen(maze, cell, [&](int next) {
+            if (distance[next] >= 0) return;
+            distance[next] = distance[cell] + 1;
+            queue.push_back(next);
+        });
+    }
+    result.length = distance[target];
+    result.visited = queue.size();
+    result.memoryBytes = distance.capacity() * sizeof(int) + queue.capacity() * sizeof(int);
+    return result;
+}
+
+MazeSolution solveMazeAStar(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal)
+{
+    MazeSolution result;
+    if (!inside(maze, start) || !inside(maze, goal)) return result;
+    const int cellCount = maze.width * maze.height;
+    const int source = start.y * maze.width + start.x, target = goal.y * maze.width + goal.x;
+    auto heuristic = [&](int cell) { return std::abs(cell % maze.width - goal.x) + std::abs(cell / maze.width - goal.y); };
+
+    // Entrada da fila: f no alto, célula embaixo (uma comparação de 64 bits)
+    std::vector<int> g(cellCount, -1);
+    std::vector<uint64_t> open;
+    auto push = [&](int cell) {
+        open.push_back((static_cast<uint64_t>(g[cell] + heuristic(cell)) << 32) | static_cast<uint32_t>(cell));
+        std::push_heap(open.begin(), open.end(), std::greater<uint64_t>());
+    };
+    g[source] = 0;
+    push(source);
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<uint64_t>());
+        const uint64_t entry = open.back();
+        open.pop_back();
+        const int cell = static_cast<int>(entry & 0xffffffffu);
+        if (static_cast<int>(entry >> 32) != g[cell] + heuristic(cell)) continue;  // Entrada velha
+        ++result.visited;
+        if (cell == target) break;
+        forEachOpen(maze, cell, [&](int next) {
+            if (g[next] >= 0 && g[next] <= g[cell] + 1) return;
+            g[next] = g[cell] + 1;
+            push(next);
+        });
+    }
+    result.length = g[target];
+    result.memoryBytes = g.capacity() * sizeof(int) + open.capacity() * sizeof(uint64_t);
+    return result;
+}
+
+MazeSolution solveMazeBitBfs(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal)
+{
+    MazeSolution result;
+    if (!inside(maze, start) || !inside(maze, goal)) return result;
+    const int words = (maze.width + 63) / 64;
+    const size_t rowBits = static_cast<size_t>(words) * maze.height;
+
+    // Máscaras por linha: bit x de `east` = passagem entre x e x + 1; de `south` = entre z e z + 1
+    std::vector<uint64_t> east(rowBits, 0), south(rowBits, 0);
+    for (int z = 0; z < maze.height; ++z) {
+        for (int x = 0; x < maze.width; ++x) {
+            const uint64_t bit = uint64_t(1) << (x & 63);
+            if (x + 1 < maze.width && !maze.wallEast(x, z)) east[z * words + (x >> 6)] |= bit;
+            if (z + 1 < maze.height && !maze.wallSouth(x, z)) south[z * words + (x >> 6)] |= bit;
+        }
+    }
+
+    std::vector<uint64_t> visited(rowBits, 0), frontier(rowBits, 0), next(rowBits, 0);
+    std::vector<uint8_t> rowQueued(maze.height, 0);
+    std::vector<int> activeRows, nextRows;
+    auto markRow = [&](int z) {
+        if (!rowQueued[z]) { rowQueued[z] = 1; nextRows.push_back(z); }
+    };
+
+    frontier[start.y * words + (start.x >> 6)] = uint64_t(1) << (start.x & 63);
+    visited = frontier;
+    activeRows.push_back(start.y);
+    const uint64_t goalBit = uint64_t(1) << (goal.x & 63);
+    const size_t goalWord = static_cast<size_t>(goal.y) * words + (goal.x >> 6);
+
+    for (int level = 0; !activeRows.empty(); ++level) {
+        if (visited[goalWord] & goalBit) { result.length = level; break; }
+        // Expande todas as linhas da frente de uma vez, 64 células por palavra
+        for (int z : activeRows) {
+            const uint64_t* f = &frontier[static_cast<size_t>(z) * words];
+            const uint64_t* e = &east[static_cast<size_t>(z) * words];
+            uint64_t* n = &next[static_cast<size_t>(z) * words];
+            bool any = false;
+            for (int w = 0; w < words; ++w) {
+                // Para leste: bit x vai a x + 1 se a passagem x existe (com o vai-um entre palavras)
+                uint64_t toEast = (f[w] & e[w]) << 1;
+                if (w > 0) toEast |= (f[w - 1] & e[w - 1]) >> 63;
+                // Para oeste: bit x + 1 vai a x se a passagem x existe
+                uint64_t toWest = (f[w] >> 1) & e[w];
+                if (w + 1 < words) toWest |= (f[w + 1] << 63) & e[w];
+                n[w] |= toEast | toWest;
+                any |= (toEast | toWest) != 0;
+            }
+            if (any) markRow(z);
+            if (z + 1 < maze.height) {
+                uint64_t* below = &next[static_cast<size_t>(z + 1) * words];
+                const uint64_t* s = &south[static_cast<size_t>(z) * words];
+                bool moved = false;
+                for (int w = 0; w < words; ++w) { below[w] |= f[w] & s[w]; moved |= (f[w] & s[w]) != 0; }
+                if (moved) markRow(z + 1);
+            }
+            if (z > 0) {
+                uint64_t* above = &next[static_cast<size_t>(z - 1) * words];
+                const uint64_t* s = &south[static_cast<size_t>(z - 1) * words];
+                bool moved = false;
+                for (int w = 0; w < words; ++w) { above[w] |= f[w] & s[w]; moved |= (f[w] & s[w]) != 0; }
+                if (moved) markRow(z - 1);
+            }
+        }
+        // A nova frente é o que ainda não foi visitado; linhas antigas são zeradas
+        for (int z : activeRows) std::fill_n(&frontier[static_cast<size_t>(z) * words], words, 0);
+        activeRows.clear();
+        for (int z : nextRows) {
+            rowQueued[z] = 0;
+            bool any = false;
+            for (int w = 0; w < words; ++w) {
+                const size_t i = static_cast<size_t>(z) * words + w;
+                frontier[i] = next[i] & ~visited[i];
+                visited[i] |= frontier[i];
+                next[i] = 0;
+                any |= frontier[i] != 0;
+            }
+            if (any) activeRows.push_back(z);
+        }
+        nextRows.clear();
+    }
+    for (uint64_t word : visited) result.visited += static_cast<size_t>(__builtin_popcountll(word));
+    result.memoryBytes = (east.capacity() + south.capacity() + visited.capacity() + frontier.capacity() + next.capacity()) * sizeof(uint64_t)
+                       + rowQueued.capacity() + (activeRows.capacity() + nextRows.capacity()) * sizeof(int);
+    return result;
+}
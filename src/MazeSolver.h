@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+#include "MazeGenerator.h"
+
+// ============================================================================
+// SOLUÇÃO DE LABIRINTOS EM CÉLULAS
+// ============================================================================
+// Menor caminho entre duas células do layout (passos entre células vizinhas
+// sem parede). Três estratégias para comparar custo e memória na geração em
+// lote: BFS clássica, A* com distância de Manhattan e BFS bit-paralela, em que
+// cada linha do labirinto é um conjunto de bits e uma frente inteira avança
+// com deslocamentos e máscaras de 64 células por vez.
+
+struct MazeSolution {
+    int length = -1;                   // Passos do início ao fim (-1 = sem caminho)
+    size_t visited = 0;                // Células alcançadas/expandidas
+    size_t memoryBytes = 0;            // Memória de trabalho da busca
+};
+
+MazeSolution solveMazeBfs(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal);
+MazeSolution solveMazeAStar(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal);
+// Só a distância (sem o caminho): cada nível da BFS custa O(linhas ativas x largura / 64)
+MazeSolution solveMazeBitBfs(const MazeLayout& maze, const glm::ivec2& start, const glm::ivec2& goal);
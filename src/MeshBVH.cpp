@@ -0,0 +1,395 @@
+#include "MeshBVH.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const unsigned int MAX_LEAF_TRIANGLES = 4;
+    // A pilha de percurso guarda no máximo profundidade + 1 nós: a construção
+    // não passa de MAX_DEPTH (abaixo dele a folha fica maior) e nada é descartado
+    const int TRAVERSAL_STACK_SIZE = 64;
+    const unsigned int MAX_DEPTH = TRAVERSAL_STACK_SIZE - 1;
+
+    // Menor raiz de a*t^2 + b*t + c = 0 dentro de (0, maxRoot)
+    bool lowestRoot(float a, float b, float c, float maxRoot, float& root)
+    {
+        float det = b * b - 4.0f * a * c;
+        if (det < 0.0f || std::abs(a) < 1e-12f) return false;
+        float sqrtDet = std::sqrt(det);
+        float r1 = (-b - sqrtDet) / (2.0f * a);
+        float r2 = (-b + sqrtDet) / (2.0f * a);
+        if (r1 > r2) std::swap(r1, r2);
+        if (r1 > 0.0f && r1 < maxRoot) { root = r1; return true; }
+        if (r2 > 0.0f && r2 < maxRoot) { root = r2; return true; }
+        return false;
+    }
+
+    // Segmento start -> start + delta contra a caixa expandida pelo raio, até tMax
+    bool segmentHitsBox(const glm::vec3& start, const glm::vec3& delta, const glm::vec3& lo, const glm::vec3& hi, float tMax)
+    {
+        float tEnter = 0.0f, tExit = tMax;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (std::abs(delta[axis]) < 1e-9f) {
+                if (start[axis] < lo[axis] || start[axis] > hi[axis]) return false;
+                continue;
+            }
+            float inv = 1.0f / delta[axis];
+            float t0 = (lo[axis] - start[axis]) * inv;
+            float t1 = (hi[axis] - start[axis]) * inv;
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            if (tEnter > tExit) return false;
+        }
+        return true;
+    }
+
+    // Raio com direção invertida já calculada: distância de entrada na caixa, se antes de tMax
+    bool rayEntersBox(const glm::vec3& origin, const glm::vec3& invDir, const glm::vec3& lo, const glm::vec3& hi, float tMax, float& tEnter)
+    {
+        float tx0 = (lo.x - origin.x) * invDir.x, tx1 = (hi.x - origin.x) * invDir.x;
+        float ty0 = (lo.y - origin.y) * invDir.y, ty1 = (hi.y - origin.y) * invDir.y;
+        float tz0 = (lo.z - origin.z) * invDir.z, tz1 = (hi.z - origin.z) * invDir.z;
+        if (tx0 > tx1) std::swap(tx0, tx1);
+        if (ty0 > ty1) std::swap(ty0, ty1);
+        if (tz0 > tz1) std::swap(tz0, tz1);
+        tEnter = std::max(std::max(tx0, ty0), std::max(tz0, 0.0f));
+        return tEnter <= std::min(std::min(tx1, ty1), std::min(tz1, tMax));
+    }
+
+    bool sweepAgainstVertex(const glm::vec3& start, const glm::vec3& delta, float radius, const glm::vec3& p, SweepHit& hit)
+    {
+        float a = glm::dot(delta, delta);
+        float b = 2.0f * glm::dot(delta, start - p);
+        glm::vec3 toStart = p - start;
+        float c = glm::dot(toStart, toStart) - radius * radius;
+        float t;
+        if (!lowestRoot(a, b, c, hit.t, t)) return false;
+        hit.t = t;
+        hit.point = p;
+        return true;
+    }
+
+    bool sweepAgainstEdge(const glm::vec3& start, const glm::vec3& delta, float radius, const glm::vec3& p1, const glm::vec3& p2, SweepHit& hit)
+    {
+        // Trabalha no plano perpendicular à aresta (a distância até a reta não
+        // depende da componente ao longo dela), o que evita cancelamento numérico
+        glm::vec3 edge = p2 - p1;
+        float edgeLength = glm::length(edge);
+        if (edgeLength < 1e-9f) return false;
+        glm::vec3 axis = edge / edgeLength;
+        glm::vec3 base = start - p1;
+        glm::vec3 basePerp = base - axis * glm::dot(axis, base);
+        glm::vec3 deltaPerp = delta - axis * glm::dot(axis, delta);
+        float a = glm::dot(deltaPerp, deltaPerp);
+        float b = 2.0f * glm::dot(deltaPerp, basePerp);
+        float c = glm::dot(basePerp, basePerp) - radius * radius;
+        float t;
+        if (!lowestRoot(a, b, c, hit.t, t)) return false;
+        float f = glm::dot(axis, base + delta * t) / edgeLength;
+        if (f < 0.0f || f > 1.0f) return false;
+        hit.t = t;
+        hit.point = p1 + f * edge;
+        return true;
+    }
+}
+
+// ============================================================================
+// TESTES GEOMÉTRICOS
+// ============================================================================
+glm::vec3 inverseDirection(const glm::vec3& dir)
+{
+    // Eixo parado vira um número enorme e finito: a caixa é aceita ou recusada
+    // pelo sinal, sem divisão por zero nem 0 * inf = NaN com a origem no plano
+    auto inverse = [](float d) { return std::abs(d) > 1e-12f ? 1.0f / d : std::copysign(1e30f, d); };
+    return glm::vec3(inverse(dir.x), inverse(dir.y), inverse(dir.z));
+}
+
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    // Regiões de Voronoi do triângulo (Ericson, Real-Time Collision Detection)
+    glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+bool rayTriangle(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& distance)
+{
+    // Möller–Trumbore, sem descartar faces de costas
+    glm::vec3 e1 = b - a, e2 = c - a;
+    glm::vec3 p = glm::cross(dir, e2);
+    float det = glm::dot(e1, p);
+    if (std::abs(det) < 1e-10f) return false;
+    float invDet = 1.0f / det;
+    glm::vec3 s = origin - a;
+    float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+    glm::vec3 q = glm::cross(s, e1);
+    float v = glm::dot(dir, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    float t = glm::dot(e2, q) * invDet;
+    if (t < 0.0f || t >= distance) return false;
+    distance = t;
+    return true;
+}
+
+bool sweepSphereTriangle(const glm::vec3& start, const glm::vec3& delta, float radius,
+                         const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, SweepHit& hit)
+{
+    glm::vec3 n = glm::cross(b - a, c - a);
+    float area = glm::length(n);
+    if (area < 1e-12f) return false;
+    n /= area;
+
+    // Esfera já encostada no triângulo: contato imediato, a menos que o
+    // movimento a afaste dele (permite sair de uma parede)
+    glm::vec3 closest = closestPointOnTriangle(start, a, b, c);
+    glm::vec3 away = start - closest;
+    float distSq = glm::dot(away, away);
+    if (distSq < radius * radius) {
+        if (hit.t <= 0.0f || glm::dot(delta, away) >= 0.0f) return false;
+        hit.t = 0.0f;
+        hit.point = closest;
+        hit.normal = distSq > 1e-12f ? away / std::sqrt(distSq) : n;
+        return true;
+    }
+
+    // Paredes são consideradas dos dois lados
+    float planeDist = glm::dot(n, start - a);
+    if (planeDist < 0.0f) { n = -n; planeDist = -planeDist; }
+
+    // Contato com o interior da face: é sempre o primeiro, se existir
+    float normalSpeed = glm::dot(n, delta);
+    if (normalSpeed < 0.0f && planeDist >= radius) {
+        float t = (planeDist - radius) / -normalSpeed;
+        if (t < hit.t) {
+            glm::vec3 planePoint = start + delta * t - n * radius;
+            glm::vec3 onTriangle = closestPointOnTriangle(planePoint, a, b, c);
+            glm::vec3 diff = planePoint - onTriangle;
+            if (glm::dot(diff, diff) < 1e-8f) {
+                hit.t = t;
+                hit.point = planePoint;
+                hit.normal = n;
+                return true;
+            }
+        }
+    }
+
+    // Caso contrário, o contato (se houver) é com um vértice ou uma aresta
+    SweepHit feature = hit;
+    bool found = false;
+    found |= sweepAgainstVertex(start, delta, radius, a, feature);
+    found |= sweepAgainstVertex(start, delta, radius, b, feature);
+    found |= sweepAgainstVertex(start, delta, radius, c, feature);
+    found |= sweepAgainstEdge(start, delta, radius, a, b, feature);
+    found |= sweepAgainstEdge(start, delta, radius, b, c, feature);
+    found |= sweepAgainstEdge(start, delta, radius, c, a, feature);
+    if (!found) return false;
+    hit.t = feature.t;
+    hit.point = feature.point;
+    hit.normal = glm::normalize(start + delta * feature.t - feature.point);
+    return true;
+}
+
+// ============================================================================
+// CONSTRUÇÃO DA BVH
+// ============================================================================
+void MeshBVH::build(const std::vector<glm::vec3>& positions)
+{
+    nodes.clear();
+    triangles.clear();
+    size_t count = positions.size() / 3;
+    if (count == 0) return;
+
+    triangles.reserve(count);
+    std::vector<glm::vec3> centroids;
+    centroids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        triangles.push_back({positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]});
+        centroids.push_back((positions[3 * i] + positions[3 * i + 1] + positions[3 * i + 2]) / 3.0f);
+    }
+
+    nodes.reserve(2 * count);
+    nodes.push_back({glm::vec3(0.0f), 0, glm::vec3(0.0f), static_cast<unsigned int>(count)});
+    updateBounds(0);
+    treeDepth = 0;
+    subdivide(0, centroids, 0);
+    assert(treeDepth <= MAX_DEPTH);
+    nodes.shrink_to_fit();
+}
+
+void MeshBVH::updateBounds(unsigned int nodeIndex)
+{
+    Node& node = nodes[nodeIndex];
+    node.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    node.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (unsigned int i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+        const Triangle& tri = triangles[i];
+        node.boundsMin = glm::min(node.boundsMin, glm::min(tri.v0, glm::min(tri.v1, tri.v2)));
+        node.boundsMax = glm::max(node.boundsMax, glm::max(tri.v0, glm::max(tri.v1, tri.v2)));
+    }
+}
+
+void MeshBVH::subdivide(unsigned int nodeIndex, std::vector<glm::vec3>& centroids, unsigned int depth)
+{
+    treeDepth = std::max(treeDepth, depth);
+    unsigned int first = nodes[nodeIndex].leftFirst;
+    unsigned int count = nodes[nodeIndex].count;
+    if (count <= MAX_LEAF_TRIANGLES || depth >= MAX_DEPTH) return;
+
+    // Divide no meio do eixo mais longo dos centróides
+    glm::vec3 lo(std::numeric_limits<float>::max()), hi(std::numeric_limits<float>::lowest());
+    for (unsigned int i = first; i < first + count; ++i) {
+        lo = glm::min(lo, centroids[i]);
+        hi = glm::max(hi, centroids[i]);
+    }
+    glm::vec3 extent = hi - lo;
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+    float split = lo[axis] + extent[axis] * 0.5f;
+
+    unsigned int i = first, j = first + count - 1;
+    while (i <= j && j != ~0u) {
+        if (centroids[i][axis] < split) { ++i; }
+        else { std::swap(centroids[i], centroids[j]); std::swap(triangles[i], triangles[j]); --j; }
+    }
+    unsigned int leftCount = i - first;
+    // Centróides coincidentes: divide pela metade da lista
+    if (leftCount == 0 || leftCount == count) leftCount = count / 2;
+
+    unsigned int leftIndex = static_cast<unsigned int>(nodes.size());
+    nodes.push_back({glm::vec3(0.0f), first, glm::vec3(0.0f), leftCount});
+    nodes.push_back({glm::vec3(0.0f), first + leftCount, glm::vec3(0.0f), count - leftCount});
+    nodes[nodeIndex].leftFirst = leftIndex;
+    nodes[nodeIndex].count = 0;
+    updateBounds(leftIndex);
+    updateBounds(leftIndex + 1);
+    subdivide(leftIndex, centroids, depth + 1);
+    subdivide(leftIndex + 1, centroids, depth + 1);
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+bool MeshBVH::sweepSphere(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit, QueryBudget& budget) const
+{
+    if (nodes.empty()) return false;
+    const glm::vec3 pad(radius);
+    unsigned int stack[TRAVERSAL_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    bool found = false;
+
+    while (top > 0) {
+        // Sem orçamento o contato mais próximo pode estar numa parte não visitada
+        if (budget.exhausted()) { hit.truncated = true; return found; }
+        budget.nodeVisits++;
+        const Node& node = nodes[stack[--top]];
+        if (!segmentHitsBox(start, delta, node.boundsMin - pad, node.boundsMax + pad, hit.t)) continue;
+        if (node.count == 0) {
+            assert(top + 2 <= TRAVERSAL_STACK_SIZE);
+            stack[top++] = node.leftFirst;
+            stack[top++] = node.leftFirst + 1;
+            continue;
+        }
+        for (unsigned int i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+            if (budget.exhausted()) { hit.truncated = true; return found; }
+            budget.triangleTests++;
+            const Triangle& tri = triangles[i];
+            found |= sweepSphereTriangle(start, delta, radius, tri.v0, tri.v1, tri.v2, hit);
+        }
+    }
+    return found;
+}
+
+bool MeshBVH::raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance) const
+{
+    glm::vec3 normal;
+    return raycast(origin, dir, distance, normal);
+}
+
+bool MeshBVH::raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance, glm::vec3& normal) const
+{
+    if (nodes.empty()) return false;
+    const glm::vec3 invDir = inverseDirection(dir);
+    unsigned int stack[TRAVERSAL_STACK_SIZE];
+    int top = 0;
+    float tEnter = 0.0f;
+    if (!rayEntersBox(origin, invDir, nodes[0].boundsMin, nodes[0].boundsMax, distance, tEnter)) return false;
+    stack[top++] = 0;
+    const Triangle* closest = nullptr;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (node.count == 0) {
+            // Filho mais próximo primeiro: o acerto encurta o raio e poda o outro
+            float tLeft = 0.0f, tRight = 0.0f;
+            const Node& left = nodes[node.leftFirst];
+            const Node& right = nodes[node.leftFirst + 1];
+            const bool hitLeft = rayEntersBox(origin, invDir, left.boundsMin, left.boundsMax, distance, tLeft);
+            const bool hitRight = rayEntersBox(origin, invDir, right.boundsMin, right.boundsMax, distance, tRight);
+            assert(top + 2 <= TRAVERSAL_STACK_SIZE);
+            if (hitLeft && hitRight) {
+                const bool leftFirst = tLeft <= tRight;
+                stack[top++] = leftFirst ? node.leftFirst + 1 : node.leftFirst;
+                stack[top++] = leftFirst ? node.leftFirst : node.leftFirst + 1;
+            } else if (hitLeft || hitRight) {
+                stack[top++] = hitLeft ? node.leftFirst : node.leftFirst + 1;
+            }
+            continue;
+        }
+        // A caixa pode ter ficado além do acerto encontrado depois de empilhada
+        if (!rayEntersBox(origin, invDir, node.boundsMin, node.boundsMax, distance, tEnter)) continue;
+        for (unsigned int i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+            const Triangle& tri = triangles[i];
+            if (rayTriangle(origin, dir, tri.v0, tri.v1, tri.v2, distance)) closest = &tri;
+        }
+    }
+    if (!closest) return false;
+    normal = glm::normalize(glm::cross(closest->v1 - closest->v0, closest->v2 - closest->v0));
+    if (glm::dot(normal, dir) > 0.0f) normal = -normal;
+    return true;
+}
+
+bool MeshBVH::occluded(const glm::vec3& origin, const glm::vec3& dir, float distance) const
+{
+    if (nodes.empty()) return false;
+    const glm::vec3 invDir = inverseDirection(dir);
+    unsigned int stack[TRAVERSAL_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    float tEnter = 0.0f;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!rayEntersBox(origin, invDir, node.boundsMin, node.boundsMax, distance, tEnter)) continue;
+        if (node.count == 0) {
+            assert(top + 2 <= TRAVERSAL_STACK_SIZE);
+            stack[top++] = node.leftFirst;
+            stack[top++] = node.leftFirst + 1;
+            continue;
+        }
+        for (unsigned int i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+            const Triangle& tri = triangles[i];
+            float t = distance;
+            if (rayTriangle(origin, dir, tri.v0, tri.v1, tri.v2, t)) return true;
+        }
+    }
+    return false;
+}
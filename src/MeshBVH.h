@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+// ============================================================================
+// BVH DE TRIÂNGULOS
+// ============================================================================
+// Hierarquia de volumes (AABBs) sobre os triângulos de uma malha, construída uma
+// vez no carregamento. Responde consultas de esfera varrida (sweep) com o ponto
+// e a normal de contato, usadas para deslizar o jogador ao longo das paredes.
+
+// Resultado de uma varredura: fração do deslocamento até o primeiro contato
+struct SweepHit {
+    float t = 1.0f;                       // 0 = já encostado, 1 = sem contato
+    glm::vec3 normal = glm::vec3(0.0f);   // Normal de contato (aponta para a esfera)
+    glm::vec3 point = glm::vec3(0.0f);    // Ponto de contato no triângulo
+    bool truncated = false;               // Orçamento esgotado: pode haver contato anterior não testado
+};
+
+// Limite de trabalho compartilhado entre as malhas de uma mesma consulta. Ao
+// esgotá-lo a varredura para e marca o resultado como incompleto; quem chama
+// decide o que fazer (CollisionWorld::slide cai no campo de distância)
+struct QueryBudget {
+    int triangleTests = 0;
+    int maxTriangleTests = 512;
+    int nodeVisits = 0;
+    int maxNodeVisits = 2048;
+    bool exhausted() const { return triangleTests >= maxTriangleTests || nodeVisits >= maxNodeVisits; }
+};
+
+class MeshBVH
+{
+public:
+    // `positions` contém 3 vértices por triângulo, já em coordenadas do mundo
+    void build(const std::vector<glm::vec3>& positions);
+
+    // Esfera de raio `radius` indo de `start` até `start + delta`. Só substitui
+    // `hit` se encontrar um contato anterior ao já registrado nele; com o
+    // orçamento esgotado para no meio e liga `hit.truncated`.
+    bool sweepSphere(const glm::vec3& start, const glm::vec3& delta, float radius, SweepHit& hit, QueryBudget& budget) const;
+
+    // Raio origin + dir * t (dir normalizado); reduz `distance` se acertar antes dela
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance) const;
+    // Idem, com a normal geométrica do triângulo atingido (virada contra o raio)
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float& distance, glm::vec3& normal) const;
+    // Algum triângulo antes de `distance`? Para no primeiro encontrado (raios de sombra)
+    bool occluded(const glm::vec3& origin, const glm::vec3& dir, float distance) const;
+
+    bool empty() const { return nodes.empty(); }
+    size_t triangleCount() const { return triangles.size(); }
+    size_t memoryBytes() const { return nodes.capacity() * sizeof(Node) + triangles.capacity() * sizeof(Triangle); }
+    glm::vec3 boundsMin() const { return nodes.empty() ? glm::vec3(0.0f) : nodes[0].boundsMin; }
+    glm::vec3 boundsMax() const { return nodes.empty() ? glm::vec3(0.0f) : nodes[0].boundsMax; }
+
+private:
+    struct Triangle { glm::vec3 v0, v1, v2; };
+    struct Node {
+        glm::vec3 boundsMin;
+        unsigned int leftFirst;   // Nó interno: filho esquerdo; folha: primeiro triângulo
+        glm::vec3 boundsMax;
+        unsigned int count;       // 0 = nó interno
+    };
+
+    void subdivide(unsigned int nodeIndex, std::vector<glm::vec3>& centroids, unsigned int depth);
+    void updateBounds(unsigned int nodeIndex);
+
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+    unsigned int treeDepth = 0;   // Profundidade da folha mais funda (raiz = 0)
+};
+
+// Testes geométricos reutilizados fora da BVH
+// Inverso da direção de um raio para os testes de caixa, seguro em eixos parados
+glm::vec3 inverseDirection(const glm::vec3& dir);
+glm::vec3 closestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+bool rayTriangle(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& distance);
+bool sweepSphereTriangle(const glm::vec3& start, const glm::vec3& delta, float radius,
+                         const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, SweepHit& hit);
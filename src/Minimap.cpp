@@ -0,0 +1,219 @@
+#include "Minimap.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    const float VIEW_METERS = 48.0f;   // Lado do mundo mostrado no quadro
+    const float SCREEN_FRACTION = 0.3f, SCREEN_MARGIN = 20.0f;
+}
+
+Minimap::Minimap(Shader& mapShader, Shader& markerShader, int width, int height, const glm::vec2& origin, float cellSize,
+                 const std::vector<uint8_t>& cells, int revealRadius)
+    : MapShader(mapShader), MarkerShader(markerShader), cols(width), rows(height), radius(std::max(revealRadius, 1)),
+      gridOrigin(origin), cell(cellSize), cellBits(cells), fog(cells.size(), 0)
+{
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // Planta: inteiros, lidos com texelFetch (filtro NEAREST é obrigatório)
+    glGenTextures(1, &layoutTexture);
+    glBindTexture(GL_TEXTURE_2D, layoutTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, cols, rows, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, cellBits.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // Névoa: toda fechada; daqui em diante só sobem retângulos
+    glGenTextures(1, &fogTexture);
+    glBindTexture(GL_TEXTURE_2D, fogTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, cols, rows, 0, GL_RED, GL_UNSIGNED_BYTE, fog.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // O quadro sai do gl_VertexID; o perfil core só exige um VAO ligado
+    glGenVertexArrays(1, &mapVAO);
+
+    glGenVertexArrays(1, &markerVAO);
+    glGenBuffers(1, &markerVBO);
+    glBindVertexArray(markerVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, markerVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    markerCapacity = 3 * 5;            // Só a seta do jogador até setObjectives
+    glBufferData(GL_ARRAY_BUFFER, markerCapacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindVertexArray(0);
+}
+
+Minimap::~Minimap()
+{
+    glDeleteTextures(1, &layoutTexture);
+    glDeleteTextures(1, &fogTexture);
+    glDeleteVertexArrays(1, &mapVAO);
+    glDeleteBuffers(1, &markerVBO);
+    glDeleteVertexArrays(1, &markerVAO);
+}
+
+bool Minimap::fits(int width, int height)
+{
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    return width > 0 && height > 0 && width <= maxSize && height <= maxSize;
+}
+
+void Minimap::setObjectives(const std::vector<glm::vec3>& chestPositions, const glm::vec3& portalPosition)
+{
+    chests = chestPositions;
+    portal = portalPosition;
+    hasPortal = true;
+    // Um quadrado (6 vértices) por baú, um losango para o portal e uma seta para o jogador
+    markerCapacity = (chests.size() * 6 + 6 + 3) * 5;
+    glBindBuffer(GL_ARRAY_BUFFER, markerVBO);
+    glBufferData(GL_ARRAY_BUFFER, markerCapacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+glm::ivec2 Minimap::cellAt(const glm::vec3& pos) const
+{
+    return glm::ivec2(glm::floor((glm::vec2(pos.x, pos.z) - gridOrigin) / cell));
+}
+
+bool Minimap::seen(const glm::vec3& pos) const
+{
+    const glm::ivec2 c = cellAt(pos);
+    return inside(c) && fog[index(c)] != 0;
+}
+
+void Minimap::update(const glm::vec3& cameraPos)
+{
+    const glm::ivec2 center = cellAt(cameraPos);
+    if (center == lastCell) return;
+    lastCell = center;
+    if (!inside(center)) return;
+
+    // Busca em largura pelas passagens abertas, dentro do círculo de visão.
+    // Células bloqueadas são vistas, mas a visão não passa por elas.
+    const int side = 2 * radius + 1;
+    visited.assign(static_cast<size_t>(side) * side, 0);
+    queue.clear();
+    glm::ivec2 dirtyMin(INT_MAX), dirtyMax(INT_MIN);
+    auto see = [&](const glm::ivec2& c) {
+        const glm::ivec2 d = c - center;
+        if (!inside(c) || d.x * d.x + d.y * d.y > radius * radius) return;
+        uint8_t& mark = visited[static_cast<size_t>(d.y + radius) * side + (d.x + radius)];
+        if (mark) return;
+        mark = 1;
+        uint8_t& value = fog[index(c)];
+        if (!value) {
+            value = 255;
+            ++revealed;
+            dirtyMin = glm::min(dirtyMin, c);
+            dirtyMax = glm::max(dirtyMax, c);
+        }
+        if (!(cellBits[index(c)] & SOLID) || c == center) queue.push_back(c);
+    };
+    see(center);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const glm::ivec2 c = queue[head];
+        if (c.x + 1 < cols && !(cellBits[index(c)] & WALL_EAST)) see(c + glm::ivec2(1, 0));
+        if (c.x > 0 && !(cellBits[index(c - glm::ivec2(1, 0))] & WALL_EAST)) see(c - glm::ivec2(1, 0));
+        if (c.y + 1 < rows && !(cellBits[index(c)] & WALL_SOUTH)) see(c + glm::ivec2(0, 1));
+        if (c.y > 0 && !(cellBits[index(c - glm::ivec2(0, 1))] & WALL_SOUTH)) see(c - glm::ivec2(0, 1));
+    }
+    if (dirtyMax.x < dirtyMin.x) return;
+
+    // Só o retângulo que mudou (no máximo o círculo de visão) vai para a GPU
+    const glm::ivec2 size = dirtyMax - dirtyMin + 1;
+    upload.resize(static_cast<size_t>(size.x) * size.y);
+    for (int z = 0; z < size.y; ++z) {
+        const uint8_t* row = &fog[index(glm::ivec2(dirtyMin.x, dirtyMin.y + z))];
+        std::copy(row, row + size.x, upload.begin() + static_cast<size_t>(z) * size.x);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, fogTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, dirtyMin.x, dirtyMin.y, size.x, size.y, GL_RED, GL_UNSIGNED_BYTE, upload.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    uploaded += upload.size();
+}
+
+void Minimap::draw(const glm::vec3& cameraPos, const glm::vec3& cameraFront, const std::vector<uint8_t>& chestsOpen,
+                   bool portalActive, float screenWidth, float screenHeight)
+{
+    const float size = std::min(screenWidth, screenHeight) * SCREEN_FRACTION;
+    const glm::vec2 corner(screenWidth - size - SCREEN_MARGIN, screenHeight - size - SCREEN_MARGIN);
+    const glm::mat4 projection = glm::ortho(0.0f, screenWidth, 0.0f, screenHeight);
+    const float span = VIEW_METERS / cell;
+    const glm::vec2 center = (glm::vec2(cameraPos.x, cameraPos.z) - gridOrigin) / cell;
+
+    // ===== QUADRO: PLANTA + NÉVOA =====
+    MapShader.use();
+    MapShader.setMat4("projection", projection);
+    MapShader.setVec4("rect", glm::vec4(corner.x, corner.y, size, size));
+    MapShader.setVec2("viewCenter", center);
+    MapShader.setFloat("viewSpan", span);
+    MapShader.setFloat("wallWidth", std::max(1.5f * span / size, 0.08f)); // Pelo menos um pixel e meio
+    MapShader.setFloat("frameWidth", 2.0f / size);
+    MapShader.setInt("layoutCells", 0);
+    MapShader.setInt("fog", 1);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, layoutTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, fogTexture);
+    glBindVertexArray(mapVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // ===== MARCADORES =====
+    // Mundo -> pixels, com o norte (-z) para cima; marcadores fora do quadro ficam de fora
+    auto toScreen = [&](const glm::vec3& p) {
+        const glm::vec2 uv = ((glm::vec2(p.x, p.z) - gridOrigin) / cell - center) / span;
+        return corner + glm::vec2(uv.x + 0.5f, 0.5f - uv.y) * size;
+    };
+    const float markerSize = std::max(size * 0.02f, 3.0f);
+    auto visible = [&](const glm::vec2& p) {
+        return p.x - markerSize >= corner.x && p.y - markerSize >= corner.y &&
+               p.x + markerSize <= corner.x + size && p.y + markerSize <= corner.y + size;
+    };
+    auto vertex = [&](const glm::vec2& p, const glm::vec3& color) {
+        markerVertices.insert(markerVertices.end(), {p.x, p.y, color.x, color.y, color.z});
+    };
+    auto quad = [&](const glm::vec2& c, const glm::vec2& a, const glm::vec2& b, const glm::vec3& color) {
+        vertex(c - a, color); vertex(c + b, color); vertex(c + a, color);
+        vertex(c - a, color); vertex(c + a, color); vertex(c - b, color);
+    };
+    markerVertices.clear();
+    for (size_t i = 0; i < chests.size(); ++i) {
+        const glm::vec2 p = toScreen(chests[i]);
+        if (!seen(chests[i]) || !visible(p)) continue;
+        const bool open = i < chestsOpen.size() && chestsOpen[i];
+        quad(p, glm::vec2(-markerSize, -markerSize), glm::vec2(markerSize, -markerSize),
+             open ? glm::vec3(0.45f, 0.35f, 0.2f) : glm::vec3(1.0f, 0.8f, 0.2f));
+    }
+    if (hasPortal && seen(portal) && visible(toScreen(portal))) {
+        quad(toScreen(portal), glm::vec2(0.0f, markerSize * 1.3f), glm::vec2(markerSize * 1.3f, 0.0f),
+             portalActive ? glm::vec3(0.3f, 1.0f, 0.6f) : glm::vec3(0.45f, 0.35f, 0.65f));
+    }
+    // Jogador: seta no centro, apontando para onde a câmera olha
+    glm::vec2 forward(cameraFront.x, -cameraFront.z);
+    forward = glm::length(forward) > 1e-4f ? glm::normalize(forward) : glm::vec2(0.0f, 1.0f);
+    const glm::vec2 sideways(forward.y, -forward.x), player = corner + glm::vec2(size * 0.5f);
+    const glm::vec3 playerColor(1.0f, 0.3f, 0.25f);
+    vertex(player + forward * markerSize * 1.8f, playerColor);
+    vertex(player - forward * markerSize + sideways * markerSize, playerColor);
+    vertex(player - forward * markerSize - sideways * markerSize, playerColor);
+
+    const size_t floats = std::min(markerVertices.size(), markerCapacity);
+    MarkerShader.use();
+    MarkerShader.setMat4("projection", projection);
+    glBindBuffer(GL_ARRAY_BUFFER, markerVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, floats * sizeof(float), markerVertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(markerVAO);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<int>(floats / 5));
+    glBindVertexArray(0);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Shader.h"
+
+// ============================================================================
+// MINIMAPA COM NÉVOA DE GUERRA
+// ============================================================================
+// A planta fica numa textura de inteiros com um byte por célula (os mesmos
+// bits de parede do MazeLayout), enviada uma única vez; o shader desenha as
+// paredes a partir dela, sem rasterizar o labirinto de novo. A névoa é outra
+// textura de um byte por célula: só o retângulo das células recém-vistas em
+// volta da câmera sobe com glTexSubImage2D. Dois draws por quadro: o quadro
+// do mapa e os marcadores (baús, portal e jogador) num único VBO.
+class Minimap
+{
+public:
+    static constexpr uint8_t WALL_EAST = 1;    // Mesmos valores de MazeLayout::WALL_EAST/WALL_SOUTH
+    static constexpr uint8_t WALL_SOUTH = 2;
+    static constexpr uint8_t SOLID = 4;        // Célula inteira bloqueada (grade de navegação do OBJ)
+
+    // `cells` tem width x height bytes; a célula (x, z) começa em origin + (x, z) * cellSize.
+    // `revealRadius` é o alcance da visão, em células
+    Minimap(Shader& mapShader, Shader& markerShader, int width, int height, const glm::vec2& origin, float cellSize,
+            const std::vector<uint8_t>& cells, int revealRadius);
+    ~Minimap();
+
+    Minimap(const Minimap&) = delete;
+    Minimap& operator=(const Minimap&) = delete;
+
+    // Cabe numa textura deste driver?
+    static bool fits(int width, int height);
+
+    void setObjectives(const std::vector<glm::vec3>& chestPositions, const glm::vec3& portalPosition);
+    // Revela o que é visto a partir da célula da câmera (sem atravessar paredes) quando ela muda
+    void update(const glm::vec3& cameraPos);
+    // Canto superior direito da tela; `chestsOpen` tem um byte por baú de setObjectives
+    void draw(const glm::vec3& cameraPos, const glm::vec3& cameraFront, const std::vector<uint8_t>& chestsOpen,
+              bool portalActive, float screenWidth, float screenHeight);
+
+    size_t revealedCells() const { return revealed; }
+    size_t uploadedBytes() const { return uploaded; }  // Total enviado à textura da névoa
+
+private:
+    bool inside(const glm::ivec2& c) const { return c.x >= 0 && c.y >= 0 && c.x < cols && c.y < rows; }
+    size_t index(const glm::ivec2& c) const { return static_cast<size_t>(c.y) * cols + c.x; }
+    glm::ivec2 cellAt(const glm::vec3& pos) const;
+    bool seen(const glm::vec3& pos) const;
+
+    Shader& MapShader;
+    Shader& MarkerShader;
+    GLuint layoutTexture = 0, fogTexture = 0;
+    GLuint mapVAO = 0, markerVAO = 0, markerVBO = 0;
+    size_t markerCapacity = 0;         // Floats alocados no VBO dos marcadores
+
+    int cols, rows, radius;
+    glm::vec2 gridOrigin;
+    float cell;
+    std::vector<uint8_t> cellBits;     // Cópia da planta (a busca de visão roda na CPU)
+    std::vector<uint8_t> fog;          // Cópia da névoa: 255 = vista
+    std::vector<uint8_t> visited, upload;
+    std::vector<glm::ivec2> queue;
+    std::vector<float> markerVertices; // x, y, r, g, b por vértice
+    std::vector<glm::vec3> chests;
+    glm::vec3 portal = glm::vec3(0.0f);
+    bool hasPortal = false;
+    glm::ivec2 lastCell = glm::ivec2(INT_MIN); // Nenhuma célula revelada ainda
+    size_t revealed = 0, uploaded = 0;
+};
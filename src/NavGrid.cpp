@@ -0,0 +1,133 @@
+#include "NavGrid.h"
+#include "BakedScene.h"
+#include "DistanceField.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int MAX_CELLS_PER_AXIS = 4096;
+
+    float cross2D(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+}
+
+void NavGrid::build(const std::vector<glm::vec3>& floorTriangles, const DistanceField& walls,
+                    const glm::vec2& boundsMin, const glm::vec2& boundsMax, float cellSize, float agentRadius)
+{
+    glm::vec2 extent = boundsMax - boundsMin;
+    requestedCell = cellSize;
+    cell = std::max({cellSize, extent.x / MAX_CELLS_PER_AXIS, extent.y / MAX_CELLS_PER_AXIS});
+    gridOrigin = boundsMin;
+    radius = agentRadius;
+    cols = std::max(1, static_cast<int>(std::ceil(extent.x / cell)));
+    rows = std::max(1, static_cast<int>(std::ceil(extent.y / cell)));
+
+    // Piso: centros de célula cobertos por alguma face horizontal (sem piso no OBJ, tudo conta)
+    std::vector<uint8_t> floor(static_cast<size_t>(cols) * rows, floorTriangles.empty() ? 1 : 0);
+    for (size_t t = 0; t + 2 < floorTriangles.size(); t += 3) {
+        const glm::vec3& a3 = floorTriangles[t];
+        const glm::vec3& b3 = floorTriangles[t + 1];
+        const glm::vec3& c3 = floorTriangles[t + 2];
+        glm::vec3 normal = glm::cross(b3 - a3, c3 - a3);
+        float normalLength = glm::length(normal);
+        if (normalLength <= 0.0f || std::abs(normal.y) < 0.7f * normalLength) continue;
+
+        glm::vec2 a(a3.x, a3.z), b(b3.x, b3.z), c(c3.x, c3.z);
+        float area = cross2D(b - a, c - a);
+        glm::vec2 lo = (glm::min(a, glm::min(b, c)) - gridOrigin) / cell;
+        glm::vec2 hi = (glm::max(a, glm::max(b, c)) - gridOrigin) / cell;
+        int x0 = std::max(0, static_cast<int>(std::floor(lo.x))), x1 = std::min(cols - 1, static_cast<int>(std::floor(hi.x)));
+        int z0 = std::max(0, static_cast<int>(std::floor(lo.y))), z1 = std::min(rows - 1, static_cast<int>(std::floor(hi.y)));
+        const float epsilon = 1e-4f * std::abs(area);
+        for (int z = z0; z <= z1; ++z) {
+            for (int x = x0; x <= x1; ++x) {
+                glm::vec2 p = gridOrigin + (glm::vec2(float(x), float(z)) + 0.5f) * cell;
+                // Mesmo lado das três arestas (vale para os dois sentidos de enrolamento)
+                float w0 = cross2D(b - a, p - a), w1 = cross2D(c - b, p - b), w2 = cross2D(a - c, p - c);
+                if (area < 0.0f) { w0 = -w0; w1 = -w1; w2 = -w2; }
+                if (w0 >= -epsilon && w1 >= -epsilon && w2 >= -epsilon) floor[static_cast<size_t>(z) * cols + x] = 1;
+            }
+        }
+    }
+
+    // Paredes: folga mínima do raio do agente, uma amostra do campo por célula
+    cells.assign(floor.size(), 0);
+    JobSystem::shared().parallelFor(rows, 64, [&](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; ++z) {
+            for (int x = 0; x < cols; ++x) {
+                size_t i = z * cols + x;
+                if (!floor[i]) continue;
+                glm::vec2 p = gridOrigin + (glm::vec2(float(x), float(z)) + 0.5f) * cell;
+                cells[i] = walls.empty() || walls.sample(p) >= agentRadius ? 1 : 0;
+            }
+        }
+    });
+}
+
+void NavGrid::assign(int width, int height, const glm::vec2& origin, float cellSize, std::vector<uint8_t> walkable)
+{
+    cols = width;
+    rows = height;
+    gridOrigin = origin;
+    cell = requestedCell = cellSize;
+    radius = 0.0f;
+    cells = std::move(walkable);
+    cells.resize(static_cast<size_t>(cols) * rows, 0);
+}
+
+glm::ivec2 NavGrid::cellAt(const glm::vec3& pos) const
+{
+    return glm::ivec2(static_cast<int>(std::floor((pos.x - gridOrigin.x) / cell)),
+                      static_cast<int>(std::floor((pos.z - gridOrigin.y) / cell)));
+}
+
+glm::vec3 NavGrid::cellCenter(const glm::ivec2& c, float y) const
+{
+    return glm::vec3(gridOrigin.x + (c.x + 0.5f) * cell, y, gridOrigin.y + (c.y + 0.5f) * cell);
+}
+
+glm::ivec2 NavGrid::nearestWalkable(const glm::ivec2& c, int maxRing) const
+{
+    if (walkable(c)) return c;
+    for (int ring = 1; ring <= maxRing; ++ring) {
+        for (int dz = -ring; dz <= ring; ++dz) {
+            for (int dx = -ring; dx <= ring; ++dx) {
+                if (std::max(std::abs(dx), std::abs(dz)) != ring) continue;
+                if (walkable(c.x + dx, c.y + dz)) return glm::ivec2(c.x + dx, c.y + dz);
+            }
+        }
+    }
+    return glm::ivec2(-1);
+}
+
+size_t NavGrid::walkableCount() const
+{
+    return static_cast<size_t>(std::count(cells.begin(), cells.end(), uint8_t(1)));
+}
+
+void NavGrid::serialize(std::vector<char>& out) const
+{
+    ByteWriter writer;
+    writer.write(gridOrigin);
+    writer.write(requestedCell);
+    writer.write(cell);
+    writer.write(radius);
+    writer.write(cols);
+    writer.write(rows);
+    writer.writeArray(cells);
+    out = std::move(writer.data);
+}
+
+bool NavGrid::deserialize(const std::vector<char>& in)
+{
+    ByteReader reader(in);
+    bool ok = reader.read(gridOrigin) && reader.read(requestedCell) && reader.read(cell) && reader.read(radius) &&
+              reader.read(cols) && reader.read(rows) && reader.readArray(cells);
+    if (!ok || cells.size() != static_cast<size_t>(cols) * rows) { cells.clear(); return false; }
+    return true;
+}
+
+bool NavGrid::matches(const glm::vec2& boundsMin, float cellSize, float agentRadius) const
+{
+    return !cells.empty() && gridOrigin == boundsMin && requestedCell == cellSize && radius == agentRadius;
+}
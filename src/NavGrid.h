@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class DistanceField;
+
+// ============================================================================
+// GRADE DE NAVEGAÇÃO
+// ============================================================================
+// Planta baixa discretizada em células caminháveis: uma célula é livre se há
+// piso ("Piso*") embaixo dela e se o seu centro está a pelo menos o raio do
+// agente de qualquer parede (consultando o campo de distância das paredes).
+// É a base do A* e do HPA*; fica guardada no arquivo de dados pré-calculados.
+class NavGrid
+{
+public:
+    // `floorTriangles` tem 3 vértices por triângulo; só as faces voltadas
+    // para cima contam como piso
+    void build(const std::vector<glm::vec3>& floorTriangles, const DistanceField& walls,
+               const glm::vec2& boundsMin, const glm::vec2& boundsMax, float cellSize, float agentRadius);
+    // Grade pronta (geradores de labirinto e benchmarks): 1 = caminhável
+    void assign(int width, int height, const glm::vec2& origin, float cellSize, std::vector<uint8_t> walkable);
+
+    bool empty() const { return cells.empty(); }
+    int width() const { return cols; }
+    int height() const { return rows; }
+    float cellSize() const { return cell; }
+    glm::vec2 origin() const { return gridOrigin; }
+
+    bool inside(const glm::ivec2& c) const { return c.x >= 0 && c.y >= 0 && c.x < cols && c.y < rows; }
+    bool walkable(int x, int z) const { return x >= 0 && z >= 0 && x < cols && z < rows && cells[static_cast<size_t>(z) * cols + x]; }
+    bool walkable(const glm::ivec2& c) const { return walkable(c.x, c.y); }
+    int index(const glm::ivec2& c) const { return c.y * cols + c.x; }
+    glm::ivec2 coords(int index) const { return glm::ivec2(index % cols, index / cols); }
+
+    // Conversão mundo <-> célula (x, z)
+    glm::ivec2 cellAt(const glm::vec3& pos) const;
+    glm::vec3 cellCenter(const glm::ivec2& c, float y) const;
+    // Célula caminhável mais próxima de `c` num raio de `maxRing` anéis, ou (-1, -1)
+    glm::ivec2 nearestWalkable(const glm::ivec2& c, int maxRing = 4) const;
+
+    size_t walkableCount() const;
+    const std::vector<uint8_t>& data() const { return cells; }
+
+    // Conservação no arquivo de dados pré-calculados (BakedScene)
+    void serialize(std::vector<char>& out) const;
+    bool deserialize(const std::vector<char>& in);
+    bool matches(const glm::vec2& boundsMin, float cellSize, float agentRadius) const;
+
+private:
+    glm::vec2 gridOrigin = glm::vec2(0.0f);
+    float cell = 0.5f;
+    float requestedCell = 0.5f;            // Tamanho pedido (pode crescer em mapas enormes)
+    float radius = 0.0f;
+    int cols = 0, rows = 0;
+    std::vector<uint8_t> cells;
+};
@@ -0,0 +1,133 @@
+#include "SceneQuery.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <utility>
+
+// ============================================================================
+// CADASTRO E MOVIMENTO
+// ============================================================================
+void SceneQuery::clear()
+{
+    tree.clear();
+    entries.clear();
+    freeHandles.clear();
+    liveCount = 0;
+    reinsertCount = 0;
+}
+
+int SceneQuery::add(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int tags, int userData)
+{
+    int handle;
+    if (freeHandles.empty()) {
+        handle = static_cast<int>(entries.size());
+        entries.emplace_back();
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    Entry& entry = entries[handle];
+    entry.boundsMin = boundsMin;
+    entry.boundsMax = boundsMax;
+    entry.tags = tags;
+    entry.userData = userData;
+    entry.proxy = tree.insert(boundsMin - margin, boundsMax + margin, handle);
+    ++liveCount;
+    return handle;
+}
+
+void SceneQuery::remove(int handle)
+{
+    Entry& entry = entries[handle];
+    tree.remove(entry.proxy);
+    entry = Entry();
+    freeHandles.push_back(handle);
+    --liveCount;
+}
+
+void SceneQuery::move(int handle, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    Entry& entry = entries[handle];
+    glm::vec3 displacement = (boundsMin + boundsMax - entry.boundsMin - entry.boundsMax) * 0.5f;
+    entry.boundsMin = boundsMin;
+    entry.boundsMax = boundsMax;
+
+    // Ainda dentro da caixa com margem: a árvore continua válida
+    if (glm::all(glm::greaterThanEqual(boundsMin, tree.boundsMin(entry.proxy))) &&
+        glm::all(glm::lessThanEqual(boundsMax, tree.boundsMax(entry.proxy)))) return;
+
+    // Estende a margem na direção do movimento, prevendo os próximos ticks
+    glm::vec3 fatMin = boundsMin - margin, fatMax = boundsMax + margin;
+    glm::vec3 predicted = displacement * 2.0f;
+    fatMin += glm::min(predicted, glm::vec3(0.0f));
+    fatMax += glm::max(predicted, glm::vec3(0.0f));
+    tree.update(entry.proxy, fatMin, fatMax);
+    ++reinsertCount;
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+void SceneQuery::queryRadius(const glm::vec3& center, float radius, unsigned int mask, std::vector<int>& out) const
+{
+    const float radiusSq = radius * radius;
+    tree.query(center - radius, center + radius, [&](int proxy) {
+        const Entry& entry = entries[tree.userData(proxy)];
+        if ((entry.tags & mask) && pointBoxDistanceSq(center, entry.boundsMin, entry.boundsMax) <= radiusSq)
+            out.push_back(entry.userData);
+    });
+}
+
+void SceneQuery::queryBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int mask, std::vector<int>& out) const
+{
+    tree.query(boundsMin, boundsMax, [&](int proxy) {
+        const Entry& entry = entries[tree.userData(proxy)];
+        if ((entry.tags & mask) && glm::all(glm::lessThanEqual(entry.boundsMin, boundsMax)) &&
+            glm::all(glm::greaterThanEqual(entry.boundsMax, boundsMin)))
+            out.push_back(entry.userData);
+    });
+}
+
+void SceneQuery::queryNearest(const glm::vec3& point, int k, unsigned int mask, float maxDistance, std::vector<int>& out) const
+{
+    if (k <= 0) return;
+    // Os k melhores até agora, ordenados; o limite encolhe quando a lista enche
+    std::vector<std::pair<float, int>> best;
+    best.reserve(k + 1);
+    tree.nearest(point, maxDistance * maxDistance, [&](int proxy, float& limitSq) {
+        const Entry& entry = entries[tree.userData(proxy)];
+        if (!(entry.tags & mask)) return;
+        float distanceSq = pointBoxDistanceSq(point, entry.boundsMin, entry.boundsMax);
+        if (distanceSq > limitSq) return;
+        auto it = std::upper_bound(best.begin(), best.end(), std::make_pair(distanceSq, entry.userData));
+        best.insert(it, std::make_pair(distanceSq, entry.userData));
+        if (static_cast<int>(best.size()) > k) best.pop_back();
+        if (static_cast<int>(best.size()) == k) limitSq = best.back().first;
+    });
+    for (const auto& item : best) out.push_back(item.second);
+}
+
+void SceneQuery::queryRadiusBatch(const std::vector<glm::vec3>& centers, float radius, unsigned int mask,
+                                  QueryBatch& out, JobSystem& jobs) const
+{
+    const size_t count = centers.size();
+    const size_t grain = 64;
+    out.offsets.assign(count + 1, 0);
+    out.userData.clear();
+    if (count == 0) return;
+
+    // Cada bloco escreve na própria lista; a junção final mantém a ordem das consultas
+    std::vector<std::vector<int>> chunks((count + grain - 1) / grain);
+    jobs.parallelFor(count, grain, [&](size_t begin, size_t end) {
+        std::vector<int>& hits = chunks[begin / grain];
+        hits.clear();
+        for (size_t i = begin; i < end; ++i) {
+            size_t before = hits.size();
+            queryRadius(centers[i], radius, mask, hits);
+            out.offsets[i + 1] = static_cast<unsigned int>(hits.size() - before);
+        }
+    });
+
+    for (size_t i = 0; i < count; ++i) out.offsets[i + 1] += out.offsets[i];
+    out.userData.reserve(out.offsets[count]);
+    for (const auto& hits : chunks) out.userData.insert(out.userData.end(), hits.begin(), hits.end());
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "AabbTree.h"
+
+class JobSystem;
+
+// ============================================================================
+// CONSULTAS ESPACIAIS DA CENA
+// ============================================================================
+// Serviço de proximidade para objetos marcados com tags (baús, portal, gatilhos
+// futuros). As caixas ficam numa árvore dinâmica de AABBs com margem ("fat
+// AABB"): mover um objeto dentro da margem não mexe na árvore, então objetos
+// que se movem a cada tick custam quase nada. Os resultados são os `userData`
+// informados no cadastro.
+
+// Tags combináveis em máscara; o jogo define o que cada bit significa
+namespace QueryTag {
+    constexpr unsigned int Chest   = 1u << 0;
+    constexpr unsigned int Portal  = 1u << 1;
+    constexpr unsigned int Trigger = 1u << 2;
+    constexpr unsigned int Agent   = 1u << 3;
+    constexpr unsigned int All     = ~0u;
+}
+
+// Resultados de várias consultas num só buffer: os da consulta i ficam em
+// userData[offsets[i], offsets[i + 1])
+struct QueryBatch {
+    std::vector<unsigned int> offsets;
+    std::vector<int> userData;
+
+    size_t queryCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    const int* begin(size_t query) const { return userData.data() + offsets[query]; }
+    const int* end(size_t query) const { return userData.data() + offsets[query + 1]; }
+};
+
+class SceneQuery
+{
+public:
+    explicit SceneQuery(float margin = 0.2f) : margin(margin) {}
+
+    void clear();
+
+    // Cadastra um objeto; retorna um identificador estável até a remoção
+    int add(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int tags, int userData);
+    void remove(int handle);
+    // Atualiza a caixa; só reinsere na árvore quando ela sai da margem
+    void move(int handle, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    unsigned int tags(int handle) const { return entries[handle].tags; }
+    int userData(int handle) const { return entries[handle].userData; }
+    glm::vec3 boundsMin(int handle) const { return entries[handle].boundsMin; }
+    glm::vec3 boundsMax(int handle) const { return entries[handle].boundsMax; }
+    size_t size() const { return liveCount; }
+    size_t reinsertions() const { return reinsertCount; } // Vezes que move() mexeu na árvore
+
+    // Objetos cuja caixa intersecta a esfera / a caixa, filtrados pela máscara
+    void queryRadius(const glm::vec3& center, float radius, unsigned int mask, std::vector<int>& out) const;
+    void queryBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int mask, std::vector<int>& out) const;
+    // Até k objetos mais próximos de `point` (distância até a caixa), do mais perto ao mais longe
+    void queryNearest(const glm::vec3& point, int k, unsigned int mask, float maxDistance, std::vector<int>& out) const;
+
+    // Raio contra as caixas; narrow(userData, melhorAtual) faz o teste exato
+    // como em AabbTree::raycast. Retorna o userData acertado ou -1.
+    template <typename NarrowPhase>
+    int raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, unsigned int mask,
+                NarrowPhase&& narrow, float* hitDistance = nullptr) const;
+
+    // Uma consulta de raio por centro (ex.: gatilhos de centenas de agentes por
+    // tick), repartidas entre as threads do JobSystem
+    void queryRadiusBatch(const std::vector<glm::vec3>& centers, float radius, unsigned int mask,
+                          QueryBatch& out, JobSystem& jobs) const;
+
+private:
+    struct Entry {
+        glm::vec3 boundsMin, boundsMax;   // Caixa exata
+        int proxy = AabbTree::NULL_NODE;  // Folha na árvore (caixa com margem)
+        unsigned int tags = 0;
+        int userData = -1;
+    };
+
+    AabbTree tree;                        // userData da árvore = handle
+    std::vector<Entry> entries;
+    std::vector<int> freeHandles;
+    size_t liveCount = 0;
+    size_t reinsertCount = 0;
+    float margin;
+};
+
+template <typename NarrowPhase>
+int SceneQuery::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, unsigned int mask,
+                        NarrowPhase&& narrow, float* hitDistance) const
+{
+    const glm::vec3 invDir = inverseDirection(dir);
+    int handle = tree.raycast(origin, dir, maxDistance, [&](int candidate, float best) {
+        const Entry& entry = entries[candidate];
+        if (!(entry.tags & mask)) return -1.0f;
+        // A caixa da árvore tem margem: confere a exata antes da fase estreita
+        if (rayBoxDistance(origin, invDir, entry.boundsMin, entry.boundsMax, best) < 0.0f) return -1.0f;
+        return narrow(entry.userData, best);
+    }, hitDistance);
+    return handle < 0 ? -1 : entries[handle].userData;
+}
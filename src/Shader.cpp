@@ -1,47 +1,232 @@
 #include "Shader.h"
+#include "JobSystem.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try {
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-        vShaderFile.close();
-        fShaderFile.close();
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-    } catch (std::ifstream::failure& e) {
-        std::cout << "ERRO::SHADER::FICHEIRO_NAO_LIDO: " << e.what() << std::endl;
+// GL_KHR_parallel_shader_compile (mesmo valor na GL_ARB_parallel_shader_compile);
+// o glad do projeto foi gerado sem a extensão
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace {
+    std::string readFile(const char* path)
+    {
+        std::ifstream file;
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try {
+            file.open(path);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            return stream.str();
+        } catch (std::ifstream::failure& e) {
+            std::cout << "ERRO::SHADER::FICHEIRO_NAO_LIDO: " << path << " " << e.what() << std::endl;
+            return std::string();
+        }
+    }
+
+    // Os #defines precisam vir depois de #version (primeira linha do arquivo)
+    std::string injectDefines(const std::string& code, const std::string& defines)
+    {
+        if (defines.empty()) return code;
+        const size_t version = code.find("#version");
+        const size_t lineEnd = version == std::string::npos ? std::string::npos : code.find('\n', version);
+        if (lineEnd == std::string::npos) return defines + code;
+        return code.substr(0, lineEnd + 1) + defines + code.substr(lineEnd + 1);
     }
+
+    void checkErrors(unsigned int object, bool program, const char* stage)
+    {
+        int success = 0;
+        char infoLog[1024];
+        if (program) glGetProgramiv(object, GL_LINK_STATUS, &success);
+        else glGetShaderiv(object, GL_COMPILE_STATUS, &success);
+        if (success) return;
+        if (program) glGetProgramInfoLog(object, sizeof(infoLog), NULL, infoLog);
+        else glGetShaderInfoLog(object, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERRO::SHADER::" << stage << "\n" << infoLog << std::endl;
+    }
+}
+
+std::string ShaderFeatures::defines() const
+{
+    std::string out;
+    if (textured) out += "#define TEXTURED\n";
+    if (pbr) out += "#define PBR\n";
+    if (normalMapped) out += "#define NORMAL_MAP\n";
+    out += "#define BAKED_LIGHTING " + std::to_string(bakedLighting) + "\n";
+    out += "#define LIGHT_COUNT " + std::to_string(lightCount) + "\n";
+    return out;
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines) {
+    compile(readFile(vertexPath), readFile(fragmentPath), defines);
+}
+
+Shader::~Shader()
+{
+    if (compiling()) {
+        glDeleteShader(vertexStage);
+        glDeleteShader(fragmentStage);
+    }
+    glDeleteProgram(ID);
+}
+
+std::unique_ptr<Shader> Shader::fromSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines)
+{
+    std::unique_ptr<Shader> shader(new Shader());
+    shader->compile(vertexCode, fragmentCode, defines);
+    return shader;
+}
+
+void Shader::compile(const std::string& vertexSource, const std::string& fragmentSource, const std::string& defines)
+{
+    submit(injectDefines(vertexSource, defines), injectDefines(fragmentSource, defines));
+    finish();
+}
+
+void Shader::submit(const std::string& vertexCode, const std::string& fragmentCode)
+{
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
-    unsigned int vertex, fragment;
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
+    vertexStage = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexStage, 1, &vShaderCode, NULL);
+    glCompileShader(vertexStage);
+    fragmentStage = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentStage, 1, &fShaderCode, NULL);
+    glCompileShader(fragmentStage);
     ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
+    glAttachShader(ID, vertexStage);
+    glAttachShader(ID, fragmentStage);
     glLinkProgram(ID);
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
 }
+
+void Shader::finish()
+{
+    if (!compiling()) return;
+    checkErrors(vertexStage, false, "VERTEX");
+    checkErrors(fragmentStage, false, "FRAGMENT");
+    checkErrors(ID, true, "PROGRAMA");
+    glDeleteShader(vertexStage);
+    glDeleteShader(fragmentStage);
+    vertexStage = fragmentStage = 0;
+}
+
 void Shader::use() { glUseProgram(ID); }
 void Shader::setInt(const std::string &name, int value) const { glUniform1i(glGetUniformLocation(ID, name.c_str()), value); }
 void Shader::setFloat(const std::string &name, float value) const { glUniform1f(glGetUniformLocation(ID, name.c_str()), value); }
+void Shader::setVec2(const std::string &name, const glm::vec2 &value) const { glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); }
 void Shader::setVec3(const std::string &name, const glm::vec3 &value) const { glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); }
+void Shader::setVec4(const std::string &name, const glm::vec4 &value) const { glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); }
+void Shader::setIVec4(const std::string &name, const glm::ivec4 &value) const { glUniform4i(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z, value.w); }
 void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const { glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]); }
+
+// ============================================================================
+// CACHE DE PROGRAMAS
+// ============================================================================
+ShaderCache::ShaderCache(JobSystem* jobs) : jobs(jobs)
+{
+    GLint extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+    for (GLint i = 0; i < extensions && !parallel; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        parallel = name && (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0 ||
+                            std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0);
+    }
+    // O número de threads do driver fica no padrão da extensão (o máximo da implementação)
+}
+
+ShaderCache::Program& ShaderCache::find(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features)
+{
+    std::string defines = features.defines();
+    const std::string key = vertexPath + "|" + fragmentPath + "|" + defines;
+    auto found = programs.find(key);
+    if (found == programs.end()) {
+        Program program;
+        program.shader.reset(new Shader());
+        program.vertexPath = vertexPath;
+        program.fragmentPath = fragmentPath;
+        program.defines = std::move(defines);
+        found = programs.emplace(key, std::move(program)).first;
+        queued.push_back(&found->second);
+    }
+    return found->second;
+}
+
+void ShaderCache::request(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features)
+{
+    find(vertexPath, fragmentPath, features);
+}
+
+void ShaderCache::submit()
+{
+    if (queued.empty()) return;
+    auto forEach = [this](size_t count, const std::function<void(size_t)>& body) {
+        if (!jobs) {
+            for (size_t i = 0; i < count; ++i) body(i);
+            return;
+        }
+        jobs->parallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) body(i);
+        });
+    };
+
+    // Arquivos ainda não lidos, um por tarefa
+    std::vector<std::string> paths;
+    for (const Program* program : queued) {
+        for (const std::string* path : {&program->vertexPath, &program->fragmentPath}) {
+            if (!sources.count(*path) && std::find(paths.begin(), paths.end(), *path) == paths.end()) paths.push_back(*path);
+        }
+    }
+    std::vector<std::string> texts(paths.size());
+    forEach(paths.size(), [&](size_t i) { texts[i] = readFile(paths[i].c_str()); });
+    for (size_t i = 0; i < paths.size(); ++i) sources.emplace(paths[i], std::move(texts[i]));
+
+    // Código final de cada programa, com os #defines da variante
+    const std::map<std::string, std::string>& files = sources;
+    std::vector<std::string> vertexCode(queued.size()), fragmentCode(queued.size());
+    forEach(queued.size(), [&](size_t i) {
+        vertexCode[i] = injectDefines(files.at(queued[i]->vertexPath), queued[i]->defines);
+        fragmentCode[i] = injectDefines(files.at(queued[i]->fragmentPath), queued[i]->defines);
+    });
+
+    // Tudo para o driver antes de qualquer consulta: uma consulta de estado
+    // no meio obrigaria a esperar a compilação anterior
+    for (size_t i = 0; i < queued.size(); ++i) queued[i]->shader->submit(vertexCode[i], fragmentCode[i]);
+    inFlight += queued.size();
+    queued.clear();
+}
+
+void ShaderCache::finish(Shader& shader)
+{
+    if (!shader.compiling()) return;
+    shader.finish();
+    --inFlight;
+}
+
+Shader& ShaderCache::get(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features)
+{
+    Program& program = find(vertexPath, fragmentPath, features);
+    if (program.shader->ID == 0) submit();
+    finish(*program.shader);           // Espera só por este programa
+    return *program.shader;
+}
+
+void ShaderCache::poll()
+{
+    submit();
+    // Sem a extensão qualquer consulta espera o driver: os pendentes ficam
+    // para o get() que precisar deles
+    if (!parallel || inFlight == 0) return;
+    for (auto& entry : programs) {
+        Shader& shader = *entry.second.shader;
+        if (!shader.compiling()) continue;
+        GLint done = GL_FALSE;
+        glGetProgramiv(shader.ID, GL_COMPLETION_STATUS_KHR, &done);
+        if (done) finish(shader);
+    }
+}
@@ -2,16 +2,104 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+
+class JobSystem;
+
+// Recursos de shader.frag escolhidos na compilação: cada combinação vira um
+// programa próprio (#defines no topo do código) e o que não é usado nem chega
+// a ser compilado, em vez de virar um desvio por fragmento
+struct ShaderFeatures {
+    bool textured = false;             // Albedo de diffuseTexture em vez de objectColor
+    bool pbr = false;                  // Cook-Torrance em vez de Phong
+    bool normalMapped = false;         // Normal de normalTexture (base tangente pelas derivadas)
+    int bakedLighting = 0;             // 0 = nenhuma, 1 = lightmap RGBM, 2 = oclusão ambiente
+    int lightCount = 0;                // Luzes de baú avaliadas por fragmento (pointLightIndices)
+
+    std::string defines() const;
+};
 
 class Shader
 {
 public:
     unsigned int ID;
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // `defines` entra logo depois da linha #version dos dois estágios
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines = "");
+    ~Shader();
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    static std::unique_ptr<Shader> fromSource(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines);
+
     void use();
     void setInt(const std::string &name, int value) const;
     void setFloat(const std::string &name, float value) const;
+    void setVec2(const std::string &name, const glm::vec2 &value) const;
     void setVec3(const std::string &name, const glm::vec3 &value) const;
+    void setVec4(const std::string &name, const glm::vec4 &value) const;
+    void setIVec4(const std::string &name, const glm::ivec4 &value) const;
     void setMat4(const std::string &name, const glm::mat4 &mat) const;
+
+private:
+    friend class ShaderCache;
+
+    Shader() : ID(0) {}
+    void compile(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines);
+    // Entrega o código ao driver (compila e liga) sem consultar o resultado
+    void submit(const std::string& vertexCode, const std::string& fragmentCode);
+    // Confere os logs e solta os estágios; bloqueia se o driver ainda compila
+    void finish();
+    bool compiling() const { return vertexStage != 0; }
+
+    unsigned int vertexStage = 0, fragmentStage = 0; // Vivos até finish()
+};
+
+// ============================================================================
+// CACHE DE PROGRAMAS
+// ============================================================================
+// Um programa por (vertex, fragment, variante), compilado uma única vez e
+// reaproveitado daí em diante; cada arquivo é lido do disco uma única vez.
+//
+// A compilação é assíncrona: request() só anota o pedido, e submit() lê os
+// arquivos e injeta os #defines de todos os pedidos em threads de trabalho e
+// entrega tudo ao driver de uma vez, sem nenhuma consulta de estado no meio.
+// Com GL_KHR_parallel_shader_compile (ou a versão ARB) o driver compila nas
+// suas próprias threads e poll() recolhe, sem bloquear, os que terminaram;
+// get() espera só pelo programa pedido.
+// Dono dos programas: deve ser criado e destruído com o contexto OpenGL vivo.
+class ShaderCache
+{
+public:
+    explicit ShaderCache(JobSystem* jobs = nullptr);
+
+    void request(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features = ShaderFeatures());
+    void submit();
+    // Programa pronto para uso (pedidos ainda na fila vão junto para o driver)
+    Shader& get(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features = ShaderFeatures());
+    // Uma vez por quadro: fecha os programas que o driver já terminou
+    void poll();
+
+    size_t programCount() const { return programs.size(); }
+    size_t compilingCount() const { return inFlight; }
+    bool parallelCompile() const { return parallel; }
+
+private:
+    struct Program {
+        std::unique_ptr<Shader> shader;
+        std::string vertexPath, fragmentPath, defines;
+    };
+
+    Program& find(const std::string& vertexPath, const std::string& fragmentPath, const ShaderFeatures& features);
+    void finish(Shader& shader);
+
+    JobSystem* jobs;
+    bool parallel = false;             // Driver com compilação paralela (estado consultável sem bloquear)
+    size_t inFlight = 0;               // Entregues ao driver e ainda não conferidos
+    std::map<std::string, std::string> sources;
+    std::map<std::string, Program> programs; // Chave: caminhos + defines
+    std::vector<Program*> queued;      // Pedidos ainda não entregues ao driver
 };
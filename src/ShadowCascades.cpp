@@ -0,0 +1,172 @@
+#include "ShadowCascades.h"
+#include <cmath>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    const float HALF_SIZES[ShadowCascades::CASCADES] = {8.0f, 24.0f, 64.0f}; // Metros do centro à borda
+    const float RECENTER_FRACTION = 0.25f;   // Deslocamento da câmera (fração do meio lado) que pede recentro
+    const float DEPTH_REACH = 40.0f;         // Além do quadrado, até onde um objeto ainda faz sombra nele
+}
+
+ShadowCascades::ShadowCascades(const glm::vec3& lightDirection, int resolution)
+    : toLight(glm::normalize(-lightDirection)), size(resolution)
+{
+    // Textura lida pelo shader: comparação de profundidade com filtro linear (PCF 2x2 do hardware)
+    glGenTextures(1, &liveTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, liveTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, size, size, CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Camadas estáticas: só são copiadas, nunca amostradas (renderbuffers bastam)
+    for (int c = 0; c < CASCADES; ++c) {
+        Cascade& cascade = cascades[c];
+        cascade.halfSize = HALF_SIZES[c];
+        glGenRenderbuffers(1, &cascade.staticDepth);
+        glBindRenderbuffer(GL_RENDERBUFFER, cascade.staticDepth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+
+        glGenFramebuffers(1, &cascade.staticFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, cascade.staticFBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, cascade.staticDepth);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+
+        glGenFramebuffers(1, &cascade.liveFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, cascade.liveFBO);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, liveTexture, 0, c);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+ShadowCascades::~ShadowCascades()
+{
+    for (Cascade& cascade : cascades) {
+        glDeleteFramebuffers(1, &cascade.staticFBO);
+        glDeleteFramebuffers(1, &cascade.liveFBO);
+        glDeleteRenderbuffers(1, &cascade.staticDepth);
+    }
+    glDeleteTextures(1, &liveTexture);
+}
+
+// Centro preso à grade de texels da cascata (no plano da luz): ao recentrar, a
+// geometria estática cai nos mesmos texels e a sombra não tremula
+void ShadowCascades::recenter(Cascade& cascade, const glm::vec3& cameraPos)
+{
+    const glm::vec3 up = std::abs(toLight.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    const glm::mat4 rotation = glm::lookAt(glm::vec3(0.0f), -toLight, up);
+    const float texel = 2.0f * cascade.halfSize / size;
+    glm::vec3 local = glm::vec3(rotation * glm::vec4(cameraPos, 1.0f));
+    local.x = std::floor(local.x / texel + 0.5f) * texel;
+    local.y = std::floor(local.y / texel + 0.5f) * texel;
+    cascade.center = glm::vec3(glm::inverse(rotation) * glm::vec4(local, 1.0f));
+    cascade.lightView = glm::translate(glm::mat4(1.0f), -local) * rotation;
+    const float h = cascade.halfSize, reach = h + DEPTH_REACH;
+    cascade.lightSpace = glm::ortho(-h, h, -h, h, -reach, reach) * cascade.lightView;
+}
+
+bool ShadowCascades::touches(const Cascade& cascade, const glm::vec4& sphere) const
+{
+    const glm::vec4 p = cascade.lightView * glm::vec4(sphere.x, sphere.y, sphere.z, 1.0f);
+    const float limit = cascade.halfSize + sphere.w;
+    return std::abs(p.x) <= limit && std::abs(p.y) <= limit;
+}
+
+bool ShadowCascades::overlaps(int cascade, const glm::vec3& lo, const glm::vec3& hi) const
+{
+    const glm::vec3 center = (lo + hi) * 0.5f;
+    return touches(cascades[cascade], glm::vec4(center.x, center.y, center.z, glm::length(hi - lo) * 0.5f));
+}
+
+void ShadowCascades::update(const glm::vec3& cameraPos, const std::vector<glm::vec4>& dynamicCasters,
+                            const DrawFunction& drawStatic, const DrawFunction& drawDynamic)
+{
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glViewport(0, 0, size, size);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);          // Viés proporcional à inclinação: sem acne nas paredes
+
+    auto renderStatic = [&](int c) {
+        Cascade& cascade = cascades[c];
+        glBindFramebuffer(GL_FRAMEBUFFER, cascade.staticFBO);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        drawStatic(c);
+        cascade.rendered = true;
+        cascade.stale = false;
+        cascade.liveStale = true;
+        ++staticDraws;
+    };
+
+    if (staticStale) {
+        for (Cascade& cascade : cascades) cascade.stale = true;
+        staticStale = false;
+    }
+    int pending = -1;
+    for (int c = 0; c < CASCADES; ++c) {
+        Cascade& cascade = cascades[c];
+        if (!cascade.rendered) {   // Primeiro quadro: não há camada antiga para usar
+            recenter(cascade, cameraPos);
+            renderStatic(c);
+        } else if (pending < 0 && glm::length(cameraPos - cascade.center) > RECENTER_FRACTION * cascade.halfSize) {
+            pending = c;               // As menores andam primeiro: são as que se esgotam antes
+        }
+    }
+    if (pending < 0) {
+        for (int c = 0; c < CASCADES && pending < 0; ++c) if (cascades[c].stale) pending = c;
+    }
+    if (pending >= 0) {
+        recenter(cascades[pending], cameraPos);
+        renderStatic(pending);
+    }
+
+    // Camada estática copiada e móveis por cima, só onde algo mudou
+    for (int c = 0; c < CASCADES; ++c) {
+        Cascade& cascade = cascades[c];
+        bool hasDynamic = false;
+        for (const glm::vec4& sphere : dynamicCasters) {
+            if (touches(cascade, sphere)) { hasDynamic = true; break; }
+        }
+        if (!cascade.liveStale && !hasDynamic && !cascade.hadDynamic) continue;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, cascade.staticFBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cascade.liveFBO);
+        glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        if (hasDynamic) {
+            glBindFramebuffer(GL_FRAMEBUFFER, cascade.liveFBO);
+            drawDynamic(c);
+        }
+        cascade.liveStale = false;
+        cascade.hadDynamic = hasDynamic;
+    }
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void ShadowCascades::bind(Shader& shader, int textureUnit) const
+{
+    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, liveTexture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setInt("shadowMap", textureUnit);
+    for (int c = 0; c < CASCADES; ++c) {
+        const std::string index = "[" + std::to_string(c) + "]";
+        shader.setMat4("lightSpace" + index, cascades[c].lightSpace);
+        shader.setFloat("shadowTexel" + index, 2.0f * cascades[c].halfSize / size);
+    }
+}
+
+size_t ShadowCascades::gpuBytes() const
+{
+    return size_t(2) * CASCADES * size * size * 4; // Camadas estáticas + textura lida, 24 bits (4 bytes na prática)
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <functional>
+#include <vector>
+#include "Shader.h"
+
+// ============================================================================
+// SOMBRAS DO SOL EM CASCATAS, COM CACHE DA GEOMETRIA ESTÁTICA
+// ============================================================================
+// Três quadrados ortográficos em volta da câmera, cada vez maiores. O que não
+// se mexe (paredes, piso, baús, portal) é desenhado numa camada de
+// profundidade própria de cada cascata só quando ela é recentrada; a cada
+// quadro essa camada é copiada (blit) para a textura lida pelo shader e só os
+// poucos objetos móveis (tampas, NPCs) são desenhados por cima, e só nas
+// cascatas que eles tocam. Cascata sem nada móvel nem mudança fica intacta.
+//
+// Uma cascata é recentrada quando a câmera se afasta um quarto do seu lado do
+// centro; no máximo uma por quadro, para espalhar o custo. Enquanto espera, a
+// cascata antiga ainda cobre a vizinhança da câmera (o shader usa a primeira
+// cascata que contém o fragmento, com a matriz com que ela foi desenhada).
+class ShadowCascades
+{
+public:
+    static constexpr int CASCADES = 3;     // Mesmo valor de SHADOW_CASCADES em shader.frag
+
+    // Desenha a geometria na cascata `cascade` (o shader de profundidade é
+    // escolhido pelo chamador, com a matriz lightSpace(cascade))
+    using DrawFunction = std::function<void(int cascade)>;
+
+    ShadowCascades(const glm::vec3& lightDirection, int resolution = 1024);
+    ~ShadowCascades();
+
+    ShadowCascades(const ShadowCascades&) = delete;
+    ShadowCascades& operator=(const ShadowCascades&) = delete;
+
+    // A geometria estática mudou (chunks, janela do kit de peças): as camadas
+    // são refeitas aos poucos, uma por quadro, como num recentro
+    void invalidateStatic() { staticStale = true; }
+    // `dynamicCasters` tem uma esfera (centro, raio) por objeto móvel. Deixa o
+    // framebuffer padrão e o viewport como estavam
+    void update(const glm::vec3& cameraPos, const std::vector<glm::vec4>& dynamicCasters,
+                const DrawFunction& drawStatic, const DrawFunction& drawDynamic);
+    // Matrizes, textura (na unidade `textureUnit`) e tamanho do texel de cada cascata
+    void bind(Shader& shader, int textureUnit) const;
+
+    const glm::mat4& lightSpace(int cascade) const { return cascades[cascade].lightSpace; }
+    // A caixa (lo, hi) do mundo cai no quadrado da cascata?
+    bool overlaps(int cascade, const glm::vec3& lo, const glm::vec3& hi) const;
+
+    size_t staticRedraws() const { return staticDraws; }   // Total de camadas estáticas refeitas
+    size_t gpuBytes() const;
+
+private:
+    struct Cascade {
+        glm::vec3 center = glm::vec3(0.0f);
+        glm::mat4 lightView = glm::mat4(1.0f), lightSpace = glm::mat4(1.0f);
+        float halfSize = 0.0f;
+        bool rendered = false;         // Já tem uma camada estática
+        bool stale = false;            // Camada estática de uma geometria antiga
+        bool liveStale = false;        // A textura lida ainda não tem a camada estática atual
+        bool hadDynamic = false;       // Móveis desenhados no quadro anterior
+        GLuint staticDepth = 0, staticFBO = 0, liveFBO = 0;
+    };
+
+    void recenter(Cascade& cascade, const glm::vec3& cameraPos);
+    bool touches(const Cascade& cascade, const glm::vec4& sphere) const;
+
+    Cascade cascades[CASCADES];
+    GLuint liveTexture = 0;            // Array de profundidade com comparação (sampler2DArrayShadow)
+    glm::vec3 toLight;
+    int size;
+    bool staticStale = false;
+    size_t staticDraws = 0;
+};
@@ -0,0 +1,51 @@
+#include "SpatialHash.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+void SpatialHash::build(const float* xs, const float* zs, size_t count, float cellSize, JobSystem* jobs)
+{
+    inverseCell = 1.0f / cellSize;
+    tableSize = 1;
+    while (tableSize < count * 2) tableSize <<= 1;   // Carga de no máximo 50%
+    if (counterCapacity < tableSize) {
+        counters.reset(new std::atomic<uint32_t>[tableSize]);
+        counterCapacity = tableSize;
+    }
+    cellStart.resize(static_cast<size_t>(tableSize) + 1);
+    sortedIndex.resize(count);
+    pointKey.resize(count);
+
+    auto run = [&](size_t n, size_t grain, const std::function<void(size_t, size_t)>& body) {
+        if (jobs) jobs->parallelFor(n, grain, body);
+        else body(0, n);
+    };
+
+    // 1) Zera os contadores; 2) chave de cada ponto e contagem por chave
+    run(tableSize, 16384, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) counters[k].store(0, std::memory_order_relaxed);
+    });
+    run(count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t key = keyOf(cellCoord(xs[i]), cellCoord(zs[i]));
+            pointKey[i] = key;
+            counters[key].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // 3) Soma de prefixos (serial: é só uma passada linear pela tabela);
+    //    o contador vira o cursor de escrita de cada chave
+    uint32_t total = 0;
+    for (uint32_t k = 0; k < tableSize; ++k) {
+        cellStart[k] = total;
+        total += counters[k].load(std::memory_order_relaxed);
+        counters[k].store(cellStart[k], std::memory_order_relaxed);
+    }
+    cellStart[tableSize] = total;
+
+    // 4) Distribui os índices nos seus intervalos
+    run(count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            sortedIndex[counters[pointKey[i]].fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(i);
+        }
+    });
+}
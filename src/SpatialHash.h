@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class JobSystem;
+
+// ============================================================================
+// HASH ESPACIAL DE PONTOS (PLANO XZ)
+// ============================================================================
+// Refeito do zero a cada tick: chave de célula por ponto, contagem por chave,
+// soma de prefixos e distribuição, tudo em paralelo (contadores atômicos). A
+// ordem dentro de uma célula varia entre execuções; quem precisa de
+// determinismo ordena os vizinhos encontrados. Células diferentes podem cair
+// na mesma chave, então a consulta sempre confere a distância.
+class SpatialHash
+{
+public:
+    void build(const float* xs, const float* zs, size_t count, float cellSize, JobSystem* jobs = nullptr);
+
+    // visit(index) para os pontos nas células que cobrem o círculo (superconjunto)
+    template <typename Visit>
+    void query(float x, float z, float radius, Visit&& visit) const
+    {
+        if (tableSize == 0) return;
+        const int x0 = cellCoord(x - radius), x1 = cellCoord(x + radius);
+        const int z0 = cellCoord(z - radius), z1 = cellCoord(z + radius);
+        for (int cz = z0; cz <= z1; ++cz) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                const uint32_t key = keyOf(cx, cz);
+                for (uint32_t i = cellStart[key]; i < cellStart[key + 1]; ++i) visit(sortedIndex[i]);
+            }
+        }
+    }
+
+    size_t size() const { return sortedIndex.size(); }
+
+private:
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * inverseCell)); }
+    uint32_t keyOf(int cx, int cz) const
+    {
+        return (static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cz) * 19349663u) & (tableSize - 1);
+    }
+
+    float inverseCell = 1.0f;
+    uint32_t tableSize = 0;                            // Potência de 2
+    std::vector<uint32_t> cellStart;                   // tableSize + 1 entradas
+    std::vector<int> sortedIndex;                      // Pontos agrupados por chave
+    std::vector<uint32_t> pointKey;
+    std::unique_ptr<std::atomic<uint32_t>[]> counters; // Contagem e depois cursor de cada chave
+    uint32_t counterCapacity = 0;
+};
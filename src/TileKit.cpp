@@ -0,0 +1,93 @@
+#include "TileKit.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float WALL_THICKNESS = 0.2f, WALL_HEIGHT = 3.0f;
+    const float POST_MARGIN = 0.05f, POST_HEIGHT = 3.15f;  // Um pouco mais largo e alto que a parede
+
+    void push(TileKind kind, int x, int z, int orientation, TileWindow& out)
+    {
+        TileInstance instance = {};
+        instance.x = static_cast<uint16_t>(x);
+        instance.z = static_cast<uint16_t>(z);
+        instance.orientation = static_cast<uint8_t>(orientation);
+        out.instances[static_cast<int>(kind)].push_back(instance);
+    }
+}
+
+void buildTileMesh(TileKind kind, float cellSize, std::vector<glm::vec3>& triangles)
+{
+    switch (kind) {
+    case TileKind::Floor: {
+        const glm::vec3 p0(0.0f), p1(0.0f, 0.0f, cellSize), p2(cellSize, 0.0f, cellSize), p3(cellSize, 0.0f, 0.0f);
+        triangles.insert(triangles.end(), {p0, p1, p2, p0, p2, p3});
+        break;
+    }
+    case TileKind::Wall:
+        appendBox(triangles, glm::vec3(cellSize - WALL_THICKNESS, 0.0f, 0.0f), glm::vec3(cellSize, WALL_HEIGHT, cellSize));
+        break;
+    case TileKind::Post:
+        appendBox(triangles, glm::vec3(cellSize - WALL_THICKNESS - POST_MARGIN, 0.0f, cellSize - WALL_THICKNESS - POST_MARGIN),
+                  glm::vec3(cellSize + POST_MARGIN, POST_HEIGHT, cellSize + POST_MARGIN));
+        break;
+    default:
+        break;
+    }
+}
+
+void gatherTiles(const MazeLayout& maze, const glm::ivec2& first, const glm::ivec2& last, TileWindow& out)
+{
+    out.clear();
+    const glm::ivec2 lo = glm::max(first, glm::ivec2(0));
+    const glm::ivec2 hi = glm::min(last, glm::ivec2(maze.width, maze.height));
+    for (int z = lo.y; z < hi.y; ++z) {
+        for (int x = lo.x; x < hi.x; ++x) {
+            push(TileKind::Floor, x, z, 0, out);
+            if (maze.wallEast(x, z)) push(TileKind::Wall, x, z, 0, out);
+            if (maze.wallSouth(x, z)) push(TileKind::Wall, x, z, 1, out);
+            if (x == 0) push(TileKind::Wall, x, z, 2, out);  // Bordas oeste e norte do labirinto
+            if (z == 0) push(TileKind::Wall, x, z, 3, out);
+        }
+    }
+
+    // Pilares nos vértices da grade onde a parede não segue reta: pontas,
+    // quinas, junções em T e cruzamentos
+    for (int vz = lo.y; vz <= hi.y; ++vz) {
+        for (int vx = lo.x; vx <= hi.x; ++vx) {
+            auto vertical = [&](int cz) {       // Aresta em x = vx, entre as linhas cz e cz + 1
+                if (cz < 0 || cz >= maze.height) return false;
+                return vx == 0 || vx == maze.width || maze.wallEast(vx - 1, cz);
+            };
+            auto horizontal = [&](int cx) {     // Aresta em z = vz, entre as colunas cx e cx + 1
+                if (cx < 0 || cx >= maze.width) return false;
+                return vz == 0 || vz == maze.height || maze.wallSouth(cx, vz - 1);
+            };
+            const bool north = vertical(vz - 1), south = vertical(vz);
+            const bool west = horizontal(vx - 1), east = horizontal(vx);
+            const int count = north + south + west + east;
+            if (count == 0 || (count == 2 && ((north && south) || (west && east)))) continue;
+            // Nas bordas oeste e norte as paredes ficam dentro da primeira célula
+            if (vx > 0 && vz > 0) push(TileKind::Post, vx - 1, vz - 1, 0, out);
+            else if (vx == 0 && vz > 0) push(TileKind::Post, 0, vz - 1, 1, out);
+            else if (vx == 0) push(TileKind::Post, 0, 0, 2, out);
+            else push(TileKind::Post, vx - 1, 0, 3, out);
+        }
+    }
+}
+
+size_t tileCapacity(TileKind kind, int side)
+{
+    const size_t n = static_cast<size_t>(std::max(side, 0));
+    switch (kind) {
+    case TileKind::Floor: return n * n;
+    case TileKind::Wall: return 2 * n * n + 2 * n;
+    case TileKind::Post: return (n + 1) * (n + 1);
+    default: return 0;
+    }
+}
+
+int tileWindowSide(float cellSize, float viewDistance)
+{
+    return 2 * (static_cast<int>(std::ceil(viewDistance / cellSize)) + TILE_WINDOW_SNAP);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MazeGenerator.h"
+
+// ============================================================================
+// KIT DE PEÇAS MODULARES
+// ============================================================================
+// Um labirinto em grade é feito de poucas peças repetidas: piso, trecho de
+// parede e pilar de canto. Cada peça tem uma única malha (no espaço da célula,
+// com origem no canto) e cada ocorrência vira uma instância de 8 bytes: a
+// célula e a orientação. A rotação acontece no vertex shader.
+
+enum class TileKind : uint8_t {
+    Floor,                             // Quadrado do piso da célula
+    Wall,                              // Parede leste da célula (orientação 0)
+    Post,                              // Pilar no canto sudeste, onde paredes se encontram ou terminam
+    Count
+};
+constexpr int TILE_KIND_COUNT = static_cast<int>(TileKind::Count);
+
+// Orientação em passos de 90° em torno do centro da célula:
+// 0 = leste, 1 = sul, 2 = oeste, 3 = norte (para o pilar: sudeste, sudoeste, noroeste, nordeste)
+struct TileInstance {
+    uint16_t x, z;
+    uint8_t orientation;
+    uint8_t padding[3];                // Passo de 8 bytes: atributos alinhados a 4
+};
+static_assert(sizeof(TileInstance) == 8, "TileInstance deve ter 8 bytes");
+
+// Instâncias de uma janela de células, separadas por peça (um draw por peça)
+struct TileWindow {
+    std::vector<TileInstance> instances[TILE_KIND_COUNT];
+    void clear() { for (auto& list : instances) list.clear(); }
+};
+
+// Malha da peça na orientação 0 (as mesmas medidas das paredes de buildMazeBlock)
+void buildTileMesh(TileKind kind, float cellSize, std::vector<glm::vec3>& triangles);
+
+// Instâncias das células [first, last), incluindo os cantos da borda `last`
+void gatherTiles(const MazeLayout& maze, const glm::ivec2& first, const glm::ivec2& last, TileWindow& out);
+
+// Máximo de instâncias de uma peça numa janela de `side` x `side` células
+size_t tileCapacity(TileKind kind, int side);
+
+// A janela de peças anda em blocos de TILE_WINDOW_SNAP células; o lado cobre o
+// alcance da câmera mesmo com ela na borda do bloco
+constexpr int TILE_WINDOW_SNAP = 8;
+int tileWindowSide(float cellSize, float viewDistance);
@@ -0,0 +1,93 @@
+#include "TileRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+TileRenderer::TileRenderer(float cellSize, float viewDistance) : cell(cellSize)
+{
+    windowSide = tileWindowSide(cellSize, viewDistance);
+
+    for (int kind = 0; kind < TILE_KIND_COUNT; ++kind) {
+        Part& part = parts[kind];
+        std::vector<glm::vec3> triangles;
+        buildTileMesh(static_cast<TileKind>(kind), cellSize, triangles);
+        std::vector<float> vertexData;
+        interleaveFaceNormals(triangles, vertexData);
+        part.vertexCount = static_cast<int>(triangles.size());
+        part.capacity = tileCapacity(static_cast<TileKind>(kind), windowSide);
+
+        glGenVertexArrays(1, &part.vao);
+        glGenBuffers(1, &part.meshVBO);
+        glGenBuffers(1, &part.instanceVBO);
+        glBindVertexArray(part.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, part.meshVBO);
+        glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        // Instância: célula (2 x uint16) e orientação (uint8), lidas como inteiros
+        glBindBuffer(GL_ARRAY_BUFFER, part.instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, part.capacity * sizeof(TileInstance), nullptr, GL_DYNAMIC_DRAW);
+        glVertexAttribIPointer(2, 2, GL_UNSIGNED_SHORT, sizeof(TileInstance), (void*)0);
+        glEnableVertexAttribArray(2);
+        glVertexAttribDivisor(2, 1);
+        glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, sizeof(TileInstance), (void*)offsetof(TileInstance, orientation));
+        glEnableVertexAttribArray(3);
+        glVertexAttribDivisor(3, 1);
+        glBindVertexArray(0);
+    }
+}
+
+TileRenderer::~TileRenderer()
+{
+    for (Part& part : parts) {
+        glDeleteBuffers(1, &part.meshVBO);
+        glDeleteBuffers(1, &part.instanceVBO);
+        glDeleteVertexArrays(1, &part.vao);
+    }
+}
+
+bool TileRenderer::update(const MazeLayout& maze, const glm::vec3& cameraPos)
+{
+    // Centro da janela preso a blocos de TILE_WINDOW_SNAP células
+    const glm::ivec2 cameraCell(static_cast<int>(std::floor(cameraPos.x / cell)), static_cast<int>(std::floor(cameraPos.z / cell)));
+    const glm::ivec2 block = glm::ivec2(glm::floor(glm::vec2(cameraCell) / float(TILE_WINDOW_SNAP)));
+    const glm::ivec2 first = block * TILE_WINDOW_SNAP + TILE_WINDOW_SNAP / 2 - windowSide / 2;
+    if (first == windowFirst) return false;
+    windowFirst = first;
+
+    gatherTiles(maze, first, first + windowSide, window);
+    for (int kind = 0; kind < TILE_KIND_COUNT; ++kind) {
+        Part& part = parts[kind];
+        const std::vector<TileInstance>& list = window.instances[kind];
+        part.instances = static_cast<int>(std::min(list.size(), part.capacity));
+        glBindBuffer(GL_ARRAY_BUFFER, part.instanceVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, part.instances * sizeof(TileInstance), list.data());
+    }
+    return true;
+}
+
+void TileRenderer::draw() const
+{
+    for (const Part& part : parts) {
+        if (part.instances == 0) continue;
+        glBindVertexArray(part.vao);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, part.vertexCount, part.instances);
+    }
+    glBindVertexArray(0);
+}
+
+size_t TileRenderer::gpuBytes() const
+{
+    size_t bytes = 0;
+    for (const Part& part : parts) bytes += part.vertexCount * 6 * sizeof(float) + part.capacity * sizeof(TileInstance);
+    return bytes;
+}
+
+size_t TileRenderer::instanceCount() const
+{
+    size_t count = 0;
+    for (const Part& part : parts) count += part.instances;
+    return count;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <climits>
+#include "TileKit.h"
+
+// ============================================================================
+// RENDERIZAÇÃO INSTANCIADA DO KIT DE PEÇAS
+// ============================================================================
+// Uma malha por peça e um buffer de instâncias de tamanho fixo, preenchido só
+// com a janela de células em volta da câmera (o alcance do plano distante).
+// A memória de GPU não depende do tamanho do labirinto; a janela anda em
+// blocos de células para que o reenvio não aconteça a cada passo.
+class TileRenderer
+{
+public:
+    TileRenderer(float cellSize, float viewDistance);
+    ~TileRenderer();
+
+    TileRenderer(const TileRenderer&) = delete;
+    TileRenderer& operator=(const TileRenderer&) = delete;
+
+    // Reenvia as instâncias quando a câmera muda de bloco; true se a janela mudou
+    bool update(const MazeLayout& maze, const glm::vec3& cameraPos);
+    // Um draw instanciado por peça; o shader (tile.vert) já deve estar ativo
+    void draw() const;
+
+    float cellSize() const { return cell; }
+    size_t gpuBytes() const;           // Malhas + buffers de instância
+    size_t instanceCount() const;
+
+private:
+    struct Part {
+        GLuint vao = 0, meshVBO = 0, instanceVBO = 0;
+        int vertexCount = 0;
+        size_t capacity = 0;           // Instâncias alocadas (fixo)
+        int instances = 0;             // Instâncias da janela atual
+    };
+
+    Part parts[TILE_KIND_COUNT];
+    TileWindow window;
+    float cell;
+    int windowSide;
+    glm::ivec2 windowFirst = glm::ivec2(INT_MIN); // Nenhuma janela enviada ainda
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+// ============================================================================
+// BUFFER TRIPLO SEM LOCK
+// ============================================================================
+// Um produtor escreve sempre no seu próprio slot e o publica trocando-o com o
+// slot intermediário; o consumidor pega o intermediário quando há novidade.
+// Nenhum dos dois bloqueia o outro: o produtor nunca espera o consumidor
+// terminar de ler e o consumidor sempre vê o estado completo mais recente.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Lado do produtor: slot privado onde o próximo estado é montado
+    T& writeBuffer() { return slots[writeIndex]; }
+
+    // Torna o slot de escrita visível ao consumidor
+    void publish()
+    {
+        unsigned int previous = middle.exchange(writeIndex | DIRTY_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Lado do consumidor: troca para o estado mais recente, se houver um novo
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & DIRTY_BIT) == 0) return false;
+        unsigned int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& readBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr unsigned int INDEX_MASK = 0x3;
+    static constexpr unsigned int DIRTY_BIT = 0x4;
+
+    T slots[3];
+    std::atomic<unsigned int> middle{1};
+    unsigned int writeIndex = 0;
+    unsigned int readIndex = 2;
+};
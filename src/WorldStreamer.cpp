@@ -0,0 +1,184 @@
+#include "WorldStreamer.h"
+#include <algorithm>
+#include <cmath>
+
+WorldStreamer::~WorldStreamer()
+{
+    stop();
+}
+
+void WorldStreamer::start(std::shared_ptr<const MazeLayout> layout, const Settings& settings)
+{
+    stop();
+    maze = std::move(layout);
+    config = settings;
+    config.chunkCells = std::max(1, config.chunkCells);
+    config.loadRadius = std::max(1, config.loadRadius);   // Vizinhos sempre carregados: colisão nas bordas
+    chunkCount = (glm::ivec2(maze->width, maze->height) + config.chunkCells - 1) / config.chunkCells;
+    stopping = false;
+    worker = std::thread(&WorldStreamer::workerLoop, this);
+}
+
+void WorldStreamer::stop()
+{
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+    requests.clear();
+    ready.clear();
+    residentChunks.clear();
+    lastUse.clear();
+    building = glm::ivec2(-1);
+    bytes = 0;
+    maze.reset();
+}
+
+glm::ivec2 WorldStreamer::chunkOf(const glm::vec3& p) const
+{
+    const float chunkSize = config.chunkCells * config.cellSize;
+    return glm::ivec2(static_cast<int>(std::floor(p.x / chunkSize)), static_cast<int>(std::floor(p.z / chunkSize)));
+}
+
+int WorldStreamer::findResident(const glm::ivec2& coord) const
+{
+    for (size_t i = 0; i < residentChunks.size(); ++i) {
+        if (residentChunks[i]->coord == coord) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool WorldStreamer::isResident(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const
+{
+    if (!maze) return true;
+    const glm::ivec2 lo = glm::max(chunkOf(boundsMin), glm::ivec2(0));
+    const glm::ivec2 hi = glm::min(chunkOf(boundsMax), chunkCount - 1);
+    for (int z = lo.y; z <= hi.y; ++z) {
+        for (int x = lo.x; x <= hi.x; ++x) {
+            if (findResident(glm::ivec2(x, z)) < 0) return false;
+        }
+    }
+    return true;   // Fora do labirinto não há nada para carregar
+}
+
+bool WorldStreamer::update(const glm::vec3& focus)
+{
+    if (!maze) return false;
+    bool changed = false, pending = false;
+    ++useClock;
+
+    // Raio desejado em volta do jogador; os já residentes ficam "recentes"
+    const glm::ivec2 center = chunkOf(focus);
+    wanted.clear();
+    for (int z = std::max(0, center.y - config.loadRadius); z <= std::min(chunkCount.y - 1, center.y + config.loadRadius); ++z) {
+        for (int x = std::max(0, center.x - config.loadRadius); x <= std::min(chunkCount.x - 1, center.x + config.loadRadius); ++x) {
+            wanted.push_back(glm::ivec2(x, z));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& chunk : ready) {
+            bytes += chunk->memoryBytes;
+            residentChunks.push_back(std::move(chunk));
+            lastUse.push_back(useClock);
+            ++loads;
+            changed = true;
+        }
+        ready.clear();
+
+        // A fila é refeita a cada chamada: pedidos que saíram do raio somem sozinhos
+        requests.clear();
+        for (const glm::ivec2& coord : wanted) {
+            const int index = findResident(coord);
+            if (index >= 0) lastUse[index] = useClock;
+            else if (coord != building) requests.push_back(coord);
+        }
+        std::sort(requests.begin(), requests.end(), [&](const glm::ivec2& a, const glm::ivec2& b) {
+            const glm::ivec2 da = glm::abs(a - center), db = glm::abs(b - center);
+            return da.x + da.y > db.x + db.y;
+        });
+        pending = !requests.empty();
+    }
+    if (pending) wake.notify_one();
+
+    // Orçamento: sai o menos recente entre os que não estão no raio
+    while (bytes > config.memoryBudget) {
+        size_t oldest = residentChunks.size();
+        for (size_t i = 0; i < residentChunks.size(); ++i) {
+            if (lastUse[i] != useClock && (oldest == residentChunks.size() || lastUse[i] < lastUse[oldest])) oldest = i;
+        }
+        if (oldest == residentChunks.size()) break;   // Só restou o raio: o orçamento é menor que ele
+        bytes -= residentChunks[oldest]->memoryBytes;
+        residentChunks[oldest] = std::move(residentChunks.back());
+        residentChunks.pop_back();
+        lastUse[oldest] = lastUse.back();
+        lastUse.pop_back();
+        ++evictions;
+        changed = true;
+    }
+    return changed;
+}
+
+void WorldStreamer::waitFor(const glm::vec3& focus)
+{
+    if (!maze) return;
+    update(focus);
+    for (;;) {
+        bool complete = true;
+        for (const glm::ivec2& coord : wanted) complete &= findResident(coord) >= 0;
+        if (complete) return;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            delivered.wait(lock, [&] { return !ready.empty(); });
+        }
+        update(focus);
+    }
+}
+
+void WorldStreamer::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || !requests.empty(); });
+        if (stopping) return;
+        building = requests.back();
+        requests.pop_back();
+
+        lock.unlock();
+        std::shared_ptr<const WorldChunk> chunk = buildChunk(*maze, config, building);
+        lock.lock();
+
+        ready.push_back(std::move(chunk));
+        building = glm::ivec2(-1);
+        delivered.notify_all();
+    }
+}
+
+std::shared_ptr<const WorldChunk> WorldStreamer::buildChunk(const MazeLayout& maze, const Settings& settings, const glm::ivec2& coord)
+{
+    auto chunk = std::make_shared<WorldChunk>();
+    chunk->coord = coord;
+    const glm::ivec2 first = coord * settings.chunkCells;
+    const glm::ivec2 last = glm::min(first + settings.chunkCells, glm::ivec2(maze.width, maze.height));
+
+    std::vector<glm::vec3> triangles, floor;
+    buildMazeBlock(maze, settings.cellSize, first, last, triangles, floor);
+    triangles.insert(triangles.end(), floor.begin(), floor.end());
+
+    auto collider = std::make_shared<MeshBVH>();
+    collider->build(triangles);
+    chunk->boundsMin = collider->boundsMin();
+    chunk->boundsMax = collider->boundsMax();
+    if (settings.buildMeshes) {
+        interleaveFaceNormals(triangles, chunk->vertexData);
+        chunk->vertexData.shrink_to_fit();
+    }
+    chunk->memoryBytes = sizeof(WorldChunk) + collider->memoryBytes() + chunk->vertexData.capacity() * sizeof(float);
+    chunk->collider = std::move(collider);
+    return chunk;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MazeGenerator.h"
+#include "MeshBVH.h"
+
+// ============================================================================
+// STREAMING DO MUNDO EM CHUNKS
+// ============================================================================
+// Para labirintos grandes demais para montar inteiros: só o layout (1 byte por
+// célula) fica na memória, e a geometria é dividida em chunks de N x N células
+// montados numa thread de fundo conforme a distância até o jogador. Chunks que
+// saem do raio ficam em cache até o orçamento de memória estourar; aí sai o
+// usado há mais tempo. Não depende de OpenGL: a malha vai pronta para o VBO e
+// quem a envia é a thread de renderização.
+
+// Chunk pronto: imutável, compartilhado entre a simulação (colisão) e a renderização (malha)
+struct WorldChunk {
+    glm::ivec2 coord = glm::ivec2(0);
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+    std::shared_ptr<const MeshBVH> collider;   // Paredes e piso
+    std::vector<float> vertexData;             // Posição + normal por vértice
+    size_t memoryBytes = 0;
+};
+
+class WorldStreamer
+{
+public:
+    struct Settings {
+        int chunkCells = 16;                   // Células do labirinto por lado de chunk
+        float cellSize = 2.0f;
+        int loadRadius = 2;                    // Raio carregado em volta do jogador, em chunks
+        size_t memoryBudget = 32u << 20;       // Bytes residentes; os chunks do raio nunca saem
+        bool buildMeshes = true;               // false: só colisão (a renderização usa o kit de peças)
+    };
+
+    WorldStreamer() = default;
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    void start(std::shared_ptr<const MazeLayout> maze, const Settings& settings);
+    void stop();
+    bool active() const { return maze != nullptr; }
+
+    // Thread dona (simulação): pede os chunks em volta de `focus`, recolhe os
+    // prontos e aplica o orçamento. Retorna true se o conjunto residente mudou.
+    bool update(const glm::vec3& focus);
+    // Bloqueia até o raio em volta de `focus` estar carregado (início do jogo)
+    void waitFor(const glm::vec3& focus);
+    // Todos os chunks tocados pela caixa estão residentes: a colisão ali é confiável
+    bool isResident(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+
+    const std::vector<std::shared_ptr<const WorldChunk>>& resident() const { return residentChunks; }
+    size_t residentBytes() const { return bytes; }
+    size_t chunkLoads() const { return loads; }
+    size_t chunkEvictions() const { return evictions; }
+    glm::ivec2 chunkOf(const glm::vec3& p) const;
+
+    // Monta um chunk na thread que chamar (a de fundo usa esta mesma função)
+    static std::shared_ptr<const WorldChunk> buildChunk(const MazeLayout& maze, const Settings& settings, const glm::ivec2& coord);
+
+private:
+    void workerLoop();
+    int findResident(const glm::ivec2& coord) const;
+
+    std::shared_ptr<const MazeLayout> maze;
+    Settings config;
+    glm::ivec2 chunkCount = glm::ivec2(0);
+
+    // Só a thread dona mexe aqui; `lastUse` é paralelo a `residentChunks`
+    std::vector<std::shared_ptr<const WorldChunk>> residentChunks;
+    std::vector<uint64_t> lastUse;
+    std::vector<glm::ivec2> wanted;
+    uint64_t useClock = 0;
+    size_t bytes = 0, loads = 0, evictions = 0;
+
+    // Fila com a thread de fundo (sob `mutex`)
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake, delivered;
+    std::vector<glm::ivec2> requests;          // Mais próximo do jogador no fim (pop_back)
+    std::vector<std::shared_ptr<const WorldChunk>> ready;
+    glm::ivec2 building = glm::ivec2(-1);      // Chunk em montagem agora
+    bool stopping = false;
+};
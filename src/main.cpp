@@ -1,12 +1,15 @@
 #include "Game.h"
 #include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
 
 const unsigned int SCR_WIDTH = 1280;
 const unsigned int SCR_HEIGHT = 720;
 
-int main()
+int main(int argc, char** argv)
 {
     std::cout << "Iniciando jogo..." << std::endl;
     
@@ -16,23 +19,61 @@ int main()
         return -1;
     }
     
+    // --tick-rate <hz> [--max-catch-up <passos>] ajusta o passo fixo da simulação;
+    // --npcs <n> povoa o labirinto; --maze <L>x<A> [--maze-algorithm <nome>] [--seed <n>]
+    // troca o models/lab.obj por um labirinto gerado; --stream carrega esse labirinto em chunks
+    // e --tiles o desenha com peças modulares instanciadas; --lightmap troca a oclusão
+    // ambiente assada de paredes e piso pelo lightmap completo; --ao assa a oclusão
+    // também no labirinto gerado
+    double tickRate = 60.0;
+    int maxCatchUp = 5;
+    int npcCount = 0;
+    int mazeWidth = 0, mazeHeight = 0;
+    MazeAlgorithm mazeAlgorithm = MazeAlgorithm::Backtracker;
+    unsigned long mazeSeed = 1;
+    bool streamWorld = false, useTileKit = false, lightmaps = false, occlusion = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stream") == 0) { streamWorld = true; continue; }
+        if (std::strcmp(argv[i], "--tiles") == 0) { useTileKit = true; continue; }
+        if (std::strcmp(argv[i], "--lightmap") == 0) { lightmaps = true; continue; }
+        if (std::strcmp(argv[i], "--ao") == 0) { occlusion = true; continue; }
+        if (i + 1 >= argc) break;
+        if (std::strcmp(argv[i], "--tick-rate") == 0) tickRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-catch-up") == 0) maxCatchUp = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--npcs") == 0) npcCount = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--maze") == 0) {
+            if (std::sscanf(argv[++i], "%dx%d", &mazeWidth, &mazeHeight) != 2 || mazeWidth <= 0 || mazeHeight <= 0) {
+                std::cout << "Tamanho de labirinto inválido: " << argv[i] << " (use LxA, ex.: 20x20)" << std::endl;
+                mazeWidth = mazeHeight = 0;
+            }
+        }
+        else if (std::strcmp(argv[i], "--maze-algorithm") == 0) {
+            if (!parseMazeAlgorithm(argv[++i], mazeAlgorithm))
+                std::cout << "Algoritmo desconhecido: " << argv[i] << " (backtracker, wilson ou kruskal)" << std::endl;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0) mazeSeed = std::strtoul(argv[++i], nullptr, 10);
+    }
+    if (mazeWidth > 0) Labirinto.UseGeneratedMaze(mazeWidth, mazeHeight, mazeAlgorithm, static_cast<uint32_t>(mazeSeed));
+    Labirinto.UseWorldStreaming(streamWorld);
+    Labirinto.UseTileKit(useTileKit);
+    Labirinto.UseLightmaps(lightmaps);
+    Labirinto.UseAmbientOcclusion(occlusion);
+
     std::cout << "Chamando Init()..." << std::endl;
     Labirinto.Init();
     std::cout << "Init() concluído" << std::endl;
 
-    float deltaTime = 0.0f;
-    float lastFrame = 0.0f;
+    if (tickRate > 0.0) Labirinto.SetSimulationRate(tickRate, maxCatchUp);
+    Labirinto.SpawnCrowd(npcCount);
 
+    // A simulação roda na sua própria thread; aqui fica só entrada e renderização
+    Labirinto.StartSimulation();
     while (Labirinto.IsRunning)
     {
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-
-        Labirinto.ProcessInput(deltaTime);
-        Labirinto.Update(deltaTime);
+        Labirinto.PollInput();
         Labirinto.Render();
     }
+    Labirinto.StopSimulation();
 
     return 0;
 }